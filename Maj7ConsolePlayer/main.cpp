@@ -1,5 +1,8 @@
 #include <WaveSabrePlayerLib/WavWriter.h>
 #include <WaveSabrePlayerLib/WaveOutPlayer.hpp>
+#ifndef MIN_SIZE_REL
+#include <WaveSabrePlayerLib/MemoryReport.h>
+#endif  // MIN_SIZE_REL
 
 //#include <WaveSabreCore/rendered.hpp>
 
@@ -92,6 +95,16 @@ void ProgressCallback(double progress01, void* data)
 int main(int argc, char** argv)
 {
   printf("\"Launching the rich into the sun\" by tenfour\nReleased at Revision 2026\n");
+#ifndef MIN_SIZE_REL
+  if (argc == 2 && !strcmp(argv[1], "--memory-report"))
+  {
+    // after 30 seconds most voices and oscillator cores have been created.
+    WaveSabrePlayerLib::MemoryReport report(24);
+    report.Render(30);
+    report.Write(stdout);
+    ExitProcess(0);
+  }
+#endif  // MIN_SIZE_REL
   if (argc != 2)
   {
     printf("Playing. For wav writing, add the path to the cmd line.\n");
@@ -108,19 +121,29 @@ int main(int argc, char** argv)
 
     renderer.Begin();
 
+    // start as soon as the rest of the song is predicted to render ahead of playback; the player
+    // pauses by itself if that turns out wrong.
     DWORD precalcStart = GetTickCount();
-    while (renderer.GetRenderStatus() != WSPlayerApp::Renderer::RenderStatus::Done)
+    DWORD lastPrint = precalcStart;
+    while (renderer.Schedule(false, WSPlayerApp::WSTime::FromFrames(0)) != WSPlayerApp::PlaybackScheduler::Action::Play)
     {
-      printf("precalc ... %d \n", GetTickCount() - precalcStart);
-      if (GetTickCount() - precalcStart >= WSPlayerApp::gMaxPrecalcMilliseconds)
+      if (GetTickCount() - lastPrint >= 2000)
       {
-        break;
+        lastPrint = GetTickCount();
+        printf("precalc ... %d \n", lastPrint - precalcStart);
       }
-      Sleep(2000);
+      Sleep(WSPlayerApp::gGeneralSleepPeriodMS);
     }
+    printf("precalc done after %d ms\n", GetTickCount() - precalcStart);
+#ifndef MIN_SIZE_REL
+    printf("startup: renderer ready at %.0f ms, first block at %.0f ms (LUT build %.1f ms)\n",
+           renderer.gpRenderer->mConstructedMs,
+           renderer.gpRenderer->mFirstBlockMs.load(),
+           WaveSabreCore::M7::math::GetLUTInitMilliseconds());
+#endif  // MIN_SIZE_REL
 
     player.PlayFrom(WSPlayerApp::WSTime::FromFrames(0));
-    Sleep(renderer.gSongLength.GetMilliseconds() + 1000);
+    Sleep((DWORD)renderer.gSongLength.GetMilliseconds() + 1000);
   }
   else
   {
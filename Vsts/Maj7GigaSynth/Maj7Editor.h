@@ -354,6 +354,28 @@ public:
         ImGui::EndMenu();
       }
 
+      if (ImGui::BeginMenu("Sampler interpolation"))
+      {
+        SAMPLE_INTERPOLATION_CAPTIONS(captions);
+        size_t currentSelectionID = (size_t)GetSamplerInterpolation();
+        int newSelection = -1;
+        for (size_t i = 0; i < (size_t)SampleInterpolation::Count; ++i)
+        {
+          bool selected = (currentSelectionID == i);
+          if (ImGui::MenuItem(captions[i], nullptr, &selected))
+          {
+            newSelection = (int)i;
+          }
+        }
+        if (newSelection >= 0)
+        {
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+          SetSamplerInterpolation((SampleInterpolation)newSelection);
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
+        }
+        ImGui::EndMenu();
+      }
+
       ImGui::Separator();
       if (ImGui::MenuItem("Init patch"))
       {
@@ -2578,7 +2600,7 @@ public:
     std::unique_ptr<M7::OscillatorCore> waveformCore;
     waveformCore.reset(M7::InstantiateWaveformCore(waveform, WaveSabreCore::M7::OscillatorIntention::LFO));
 
-    const float freqHz = Helpers::CurrentSampleRateF / (float)width;
+    const float freqHz = Helpers::CurrentSampleRateF() / (float)width;
     waveformCore->SetKRateParams(waveshapeA01, waveshapeB01, freqHz, false, 1);
 
     for (int sampleIndex = 0; sampleIndex < width; ++sampleIndex)
@@ -30,6 +30,61 @@ struct Maj7ModulateEditor : public VstEditor
 
 	virtual void renderImgui() override
 	{
-		ImGui::Text("coming soon... a builder to make vibrato, tremolo, auto-pan, phaser, flanger, chorus, ensemble, doubler, etc effects");
+		using ParamIndices = Maj7Modulate::ParamIndices;
+		const bool isPhaser = mpMaj7Modulate->mParams.GetEnumValue<Maj7Modulate::Mode>(ParamIndices::Mode) == Maj7Modulate::Mode::Phaser;
+
+		ImGui::BeginGroup();
+
+		Maj7ImGuiParamEnumToggleButtonArray<Maj7Modulate::Mode>(
+			ParamIndices::Mode,
+			"Mode",
+			{
+				EnumToggleButtonArrayItem{"Delay", Maj7Modulate::Mode::Delay, "4488cc"},
+				EnumToggleButtonArrayItem{"Phaser", Maj7Modulate::Mode::Phaser, "cc8844"},
+			});
+
+		// the LFO; shared by both modes.
+		M7::QuickParam fp{ M7::gLFOFreqConfig };
+		fp.SetFrequencyAssumingNoKeytracking(0.5f);
+		Maj7ImGuiParamFrequency((int)ParamIndices::Rate, -1, "Rate", M7::gLFOFreqConfig, fp.GetRawValue(), {});
+		ImGui::SameLine();
+		Maj7ImGuiParamFloat01((int)ParamIndices::Depth, "Depth", 0.3f, 0);
+		ImGui::SameLine();
+		Maj7ImGuiParamFloat01((int)ParamIndices::StereoPhase, "Stereo phase", 0.5f, 0);
+		ImGui::SameLine();
+		Maj7ImGuiParamFloatN11((int)ParamIndices::Feedback, "Feedback", 0, 0, {});
+
+		if (isPhaser)
+		{
+			Maj7ImGuiParamInt((int)ParamIndices::Stages, "Stages", Maj7Modulate::gStagesCfg, 4, 1);
+			ImGui::SameLine();
+			Maj7ImGuiParamFrequency((int)ParamIndices::CenterFreq, -1, "Center", M7::gFilterFreqConfig, 0.5f, {});
+		}
+		else
+		{
+			Maj7ImGuiParamInt((int)ParamIndices::Voices, "Voices", Maj7Modulate::gVoicesCfg, 2, 1);
+			ImGui::SameLine();
+			Maj7ImGuiPowCurvedParam((int)ParamIndices::DelayMs, "Delay (ms)", Maj7Modulate::gDelayTimeCfg, 8, {});
+			ImGui::SameLine();
+			Maj7ImGuiParamFloat01((int)ParamIndices::Spread, "Spread", 1, 0);
+		}
+
+		Maj7ImGuiParamVolume((int)ParamIndices::DryOutput, "Dry output", M7::gVolumeCfg12db, 0, {});
+		ImGui::SameLine();
+		Maj7ImGuiParamVolume((int)ParamIndices::WetOutput, "Wet output", M7::gVolumeCfg12db, M7::gMinGainDecibels, {});
+		ImGui::SameLine();
+		Maj7ImGuiParamVolume((int)ParamIndices::OutputVolume, "Output", M7::gVolumeCfg24db, -6, {});
+
+		ImGui::EndGroup();
+
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+		ImGui::SameLine();
+		{
+			VUMeterTooltipStripScope tooltipStrip{ "modulate_vu_strip" };
+			VUMeter("vu_inp", mpMaj7Modulate->mInputAnalysis[0], mpMaj7Modulate->mInputAnalysis[1], { 30, 300 }, "Input Left", "Input Right", nullptr, &tooltipStrip);
+			ImGui::SameLine();
+			VUMeter("vu_outp", mpMaj7Modulate->mOutputAnalysis[0], mpMaj7Modulate->mOutputAnalysis[1], { 30, 300 }, "Output Left", "Output Right", nullptr, &tooltipStrip);
+		}
+#endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 	}
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "AnalysisTap.hpp"
 #include "PeakDetector.hpp"
 #include "RMS.hpp"
 
@@ -15,6 +16,10 @@ struct IAnalysisStream
   double mCurrentPeak = 0;
   double mCurrentHeldPeak = 0;
   virtual void Reset() = 0;
+
+  // called by the analysis worker. the first call switches WriteSample() to just queueing raw
+  // samples; the detectors then run here, off the audio thread.
+  virtual void DrainTap() = 0;
 };
 
 // for VST-only, things like VU meters and history graphs require outputting many additional channels of audio.
@@ -32,7 +37,19 @@ struct AnalysisStream : IAnalysisStream
     mPeakHoldDetector.SetParams(1000, 1000, 600);
   }
 
+  AnalysisTap<float> mTap;
+
   void WriteSample(double s)
+  {
+    if (mTap.IsActive())
+    {
+      mTap.Push((float)s);
+      return;
+    }
+    ProcessSample(s);
+  }
+
+  void ProcessSample(double s)
   {
     mCurrentRMSValue = mRMSDetector.ProcessSample(s);
     mPeakDetector.ProcessSample(s);
@@ -42,7 +59,28 @@ struct AnalysisStream : IAnalysisStream
     mCurrentHeldPeak = mPeakHoldDetector.mCurrentPeak;
   }
 
+  virtual void DrainTap() override
+  {
+    mTap.Enable();
+    if (mTap.ConsumeResetRequest())
+    {
+      mTap.Discard();
+      ResetDetectors();
+    }
+    mTap.Drain([this](float s) { ProcessSample(s); });
+  }
+
   virtual void Reset() override
+  {
+    if (mTap.IsActive())
+    {
+      mTap.RequestReset();
+      return;
+    }
+    ResetDetectors();
+  }
+
+  void ResetDetectors()
   {
     mRMSDetector.Reset();
     mPeakHoldDetector.Reset();
@@ -69,7 +107,19 @@ struct AttenuationAnalysisStream : IAnalysisStream
     mPeakHoldDetector.SetParams(1000, 1000, peakFalloffMS);
   }
 
+  AnalysisTap<float> mTap;
+
   void WriteSample(double s)
+  {
+    if (mTap.IsActive())
+    {
+      mTap.Push((float)s);
+      return;
+    }
+    ProcessSample(s);
+  }
+
+  void ProcessSample(double s)
   {
     // Attenuation streams carry transfer-gain ratios where 1.0 means no reduction and
     // smaller values mean stronger reduction. The generic peak detector tracks maxima,
@@ -86,7 +136,28 @@ struct AttenuationAnalysisStream : IAnalysisStream
     mCurrentHeldPeak = 1.0 / std::max(1.0, mPeakHoldDetector.mCurrentPeak);
   }
 
+  virtual void DrainTap() override
+  {
+    mTap.Enable();
+    if (mTap.ConsumeResetRequest())
+    {
+      mTap.Discard();
+      ResetDetectors();
+    }
+    mTap.Drain([this](float s) { ProcessSample(s); });
+  }
+
   virtual void Reset() override
+  {
+    if (mTap.IsActive())
+    {
+      mTap.RequestReset();
+      return;
+    }
+    ResetDetectors();
+  }
+
+  void ResetDetectors()
   {
     mRMSDetector.Reset();
     mPeakHoldDetector.Reset();
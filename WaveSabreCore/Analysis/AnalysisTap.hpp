@@ -0,0 +1,132 @@
+#pragma once
+
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+
+  #include <atomic>
+  #include <cstddef>
+  #include <cstdint>
+  #include <memory>
+
+namespace WaveSabreCore
+{
+// Single-producer / single-consumer sample ring used to move analysis work off the audio thread.
+//
+// The audio thread only ever calls Push(), which is a store + index bump, and drops the sample if
+// the consumer has fallen behind; it never blocks and never allocates. The analysis worker thread
+// calls Enable() (which allocates storage) and then Drain() at display rate.
+//
+// Until Enable() is called the tap is inactive and IsActive() returns false; owners use that to
+// fall back to processing inline, so analysis objects that nobody drains (editor mocks, tests)
+// keep working exactly as before.
+template <typename T, int TCapacityLog2 = 12>
+class AnalysisTap
+{
+public:
+  static constexpr uint32_t kCapacity = 1u << TCapacityLog2;
+  static constexpr uint32_t kMask = kCapacity - 1;
+
+  AnalysisTap() = default;
+  AnalysisTap(const AnalysisTap&) = delete;
+  AnalysisTap& operator=(const AnalysisTap&) = delete;
+
+  // producer side
+  bool IsActive() const
+  {
+    return mActive.load(std::memory_order_acquire);
+  }
+
+  void Push(const T& x)
+  {
+    const uint32_t w = mWrite.load(std::memory_order_relaxed);
+    const uint32_t r = mRead.load(std::memory_order_acquire);
+    if (w - r >= kCapacity)
+    {
+      mDropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    mData[w & kMask] = x;
+    mWrite.store(w + 1, std::memory_order_release);
+  }
+
+  // producer side; asks the consumer to discard whatever is queued before processing more.
+  void RequestReset()
+  {
+    mResetRequested.store(true, std::memory_order_release);
+  }
+
+  // consumer side
+  void Enable()
+  {
+    if (!mData)
+    {
+      mData.reset(new T[kCapacity]);
+    }
+    mActive.store(true, std::memory_order_release);
+  }
+
+  bool ConsumeResetRequest()
+  {
+    return mResetRequested.exchange(false, std::memory_order_acq_rel);
+  }
+
+  // drops everything currently queued.
+  void Discard()
+  {
+    mRead.store(mWrite.load(std::memory_order_acquire), std::memory_order_release);
+  }
+
+  // invokes fn(const T&) for every queued element; returns the count.
+  template <typename Fn>
+  uint32_t Drain(Fn&& fn)
+  {
+    const uint32_t w = mWrite.load(std::memory_order_acquire);
+    uint32_t r = mRead.load(std::memory_order_relaxed);
+    const uint32_t count = w - r;
+    for (; r != w; ++r)
+    {
+      fn(mData[r & kMask]);
+    }
+    mRead.store(r, std::memory_order_release);
+    return count;
+  }
+
+  uint32_t GetDroppedCount() const
+  {
+    return mDropped.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::unique_ptr<T[]> mData;
+  std::atomic<bool> mActive{false};
+  std::atomic<bool> mResetRequested{false};
+  std::atomic<uint32_t> mWrite{0};
+  std::atomic<uint32_t> mRead{0};
+  std::atomic<uint32_t> mDropped{0};
+};
+
+// Convenience for Device::DrainAnalysis() overrides: DrainAnalysisTaps(mInputAnalysis, mOutputAnalysis, mFFT);
+// accepts anything with a DrainTap() method, or arrays of them.
+template <typename T>
+inline void DrainAnalysisTap(T& x)
+{
+  x.DrainTap();
+}
+
+template <typename T, size_t N>
+inline void DrainAnalysisTap(T (&x)[N])
+{
+  for (auto& i : x)
+  {
+    i.DrainTap();
+  }
+}
+
+template <typename... Ts>
+inline void DrainAnalysisTaps(Ts&... xs)
+{
+  (DrainAnalysisTap(xs), ...);
+}
+
+}  // namespace WaveSabreCore
+
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
@@ -18,13 +18,14 @@ MonoFFTAnalysis::MonoFFTAnalysis(FFTSize fftSize, WindowType windowType, float s
     , mSampleRate(sampleRate)
     , mOverlapFactor(4)
   , mWindowSum(1.0f)
+    , mFFT(mFFTSizeInt)
     , mInputIndex(0)
     , mSamplesUntilProcess(mFFTSizeInt / mOverlapFactor)
     , mHasNewData(false)
 {
   // Initialize buffers
-  mInputBuffer.resize(mFFTSizeInt, 0.0f);
-  mFFTBuffer.resize(mFFTSizeInt);
+  mInputBuffer.resize(mFFTSizeInt * 2, 0.0f);
+  mMagnitudes.resize(mFFT.GetBinCount());
 
   int spectrumSize = mFFTSizeInt / 2;  // Only need positive frequencies (exclude Nyquist)
   mSpectrum.resize(spectrumSize);
@@ -89,47 +90,6 @@ void MonoFFTAnalysis::GenerateWindow()
   }
 }
 
-void MonoFFTAnalysis::PerformFFT(std::vector<std::complex<float>>& buffer)
-{
-  // Simple decimation-in-time FFT implementation
-  // Bit-reverse reordering
-  int j = 0;
-  for (int i = 1; i < mFFTSizeInt; ++i)
-  {
-    int bit = mFFTSizeInt >> 1;
-    while (j & bit)
-    {
-      j ^= bit;
-      bit >>= 1;
-    }
-    j ^= bit;
-    if (i < j)
-    {
-      std::swap(buffer[i], buffer[j]);
-    }
-  }
-
-  // FFT computation
-  for (int length = 2; length <= mFFTSizeInt; length <<= 1)
-  {
-    const float angle = -2.0f * 3.14159265f / length;
-    const std::complex<float> wlen(std::cos(angle), std::sin(angle));
-
-    for (int i = 0; i < mFFTSizeInt; i += length)
-    {
-      std::complex<float> w(1.0f, 0.0f);
-      for (int j = 0; j < length / 2; ++j)
-      {
-        const std::complex<float> u = buffer[i + j];
-        const std::complex<float> v = buffer[i + j + length / 2] * w;
-        buffer[i + j] = u + v;
-        buffer[i + j + length / 2] = u - v;
-        w *= wlen;
-      }
-    }
-  }
-}
-
 void MonoFFTAnalysis::ComputeSpectrum()
 {
   const float frequencyResolution = GetFrequencyResolution();
@@ -137,12 +97,11 @@ void MonoFFTAnalysis::ComputeSpectrum()
   const float dcNormalization = std::max(mWindowSum, 1.0e-20f);
   const float oneSidedNormalization = std::max(mWindowSum * 0.5f, 1.0e-20f);
 
+  mFFT.Magnitudes(mMagnitudes.data());
+
   for (int i = 0; i < spectrumSize; ++i)
   {
-    // Calculate magnitude and convert to dB
-    const float real = mFFTBuffer[i].real();
-    const float imag = mFFTBuffer[i].imag();
-    const float magnitude = std::sqrt(real * real + imag * imag);
+    const float magnitude = mMagnitudes[i];
 
     const float normalization = (i == 0) ? dcNormalization : oneSidedNormalization;
     const float magnitudeDB = M7::math::LinearToDecibels(magnitude / normalization);
@@ -156,8 +115,9 @@ void MonoFFTAnalysis::ComputeSpectrum()
 
 void MonoFFTAnalysis::ProcessSample(float sample)
 {
-  // Add sample to circular buffer
+  // Add sample to circular buffer (mirrored so the current frame is always contiguous)
   mInputBuffer[mInputIndex] = sample;
+  mInputBuffer[mInputIndex + mFFTSizeInt] = sample;
 
   ++mInputIndex;
   if (mInputIndex >= mFFTSizeInt)
@@ -171,21 +131,8 @@ void MonoFFTAnalysis::ProcessSample(float sample)
     // Time to process FFT
     mSamplesUntilProcess = mFFTSizeInt / mOverlapFactor;
 
-    // Copy data to FFT buffer in correct order (oldest first)
-    int dstIndex = 0;
-
-    for (int srcIndex = mInputIndex; srcIndex < mFFTSizeInt; ++srcIndex, ++dstIndex)
-    {
-      mFFTBuffer[dstIndex] = std::complex<float>(mInputBuffer[srcIndex] * mWindow[dstIndex], 0.0f);
-    }
-
-    for (int srcIndex = 0; srcIndex < mInputIndex; ++srcIndex, ++dstIndex)
-    {
-      mFFTBuffer[dstIndex] = std::complex<float>(mInputBuffer[srcIndex] * mWindow[dstIndex], 0.0f);
-    }
-
-    // Perform FFT and compute spectrum
-    PerformFFT(mFFTBuffer);
+    // Oldest sample is at mInputIndex; windowing happens inside the FFT's input gather.
+    mFFT.Forward(&mInputBuffer[mInputIndex], mWindow.data());
     ComputeSpectrum();
 
     mHasNewData = true;
@@ -346,6 +293,27 @@ void SmoothedStereoFFT::ProcessSpectrumView(const std::vector<SpectrumBin>& rawS
 }
 
 void SmoothedStereoFFT::ProcessSamples(float leftSample, float rightSample)
+{
+  if (mTap.IsActive())
+  {
+    mTap.Push({leftSample, rightSample});
+    return;
+  }
+  ProcessSamplesNow(leftSample, rightSample);
+}
+
+void SmoothedStereoFFT::DrainTap()
+{
+  mTap.Enable();
+  if (mTap.ConsumeResetRequest())
+  {
+    mTap.Discard();
+    ResetNow();
+  }
+  mTap.Drain([this](const M7::FloatPair& s) { ProcessSamplesNow(s.Left(), s.Right()); });
+}
+
+void SmoothedStereoFFT::ProcessSamplesNow(float leftSample, float rightSample)
 {
   if (mInputDecimationFactor > 1)
   {
@@ -418,6 +386,16 @@ float SmoothedStereoFFT::GetChannelMagnitudeAtFrequency(int channel, float frequ
 }
 
 void SmoothedStereoFFT::Reset()
+{
+  if (mTap.IsActive())
+  {
+    mTap.RequestReset();
+    return;
+  }
+  ResetNow();
+}
+
+void SmoothedStereoFFT::ResetNow()
 {
   for (auto& detectorSet : mPeakDetectors)
   {
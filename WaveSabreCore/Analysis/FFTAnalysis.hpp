@@ -4,10 +4,11 @@
 
 #ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
 
+  #include "AnalysisTap.hpp"
   #include "PeakDetector.hpp"
   #include "RMS.hpp"  // Include for PeakDetector
+  #include "RealFFT.hpp"
   #include <cmath>
-  #include <complex>
   #include <vector>
 
 
@@ -73,15 +74,17 @@ private:
   float mSampleRate;
   int mOverlapFactor;  // 2 = 50% overlap, 4 = 75% overlap
 
-  // Input buffer (mono)
+  // Input buffer (mono). Each sample is written twice (at i and i+N) so the most recent N samples
+  // are always contiguous starting at mInputIndex, and the FFT can read the frame in place.
   std::vector<float> mInputBuffer;
 
   // Window function coefficients
   std::vector<float> mWindow;
   float mWindowSum;
 
-  // FFT working buffer
-  std::vector<std::complex<float>> mFFTBuffer;
+  // FFT engine + magnitude scratch (N/2+1 bins)
+  RealFFT mFFT;
+  std::vector<float> mMagnitudes;
 
   // Output spectrum data
   std::vector<SpectrumBin> mSpectrum;
@@ -92,13 +95,12 @@ private:
   bool mHasNewData;
 
   void GenerateWindow();
-  void PerformFFT(std::vector<std::complex<float>>& buffer);
   void ComputeSpectrum();
 
 public:
   MonoFFTAnalysis(FFTSize fftSize = FFTSize::Default,
                   WindowType windowType = WindowType::Hanning,
-                  float sampleRate = Helpers::CurrentSampleRate);
+                  float sampleRate = Helpers::CurrentSampleRate());
 
   ~MonoFFTAnalysis();
 
@@ -124,8 +126,9 @@ public:
     {
       mFFTSize = fftSize;
       mFFTSizeInt = static_cast<int>(fftSize);
-      mInputBuffer.resize(mFFTSizeInt);
-      mFFTBuffer.resize(mFFTSizeInt);
+      mInputBuffer.resize(mFFTSizeInt * 2);
+      mFFT.SetSize(mFFTSizeInt);
+      mMagnitudes.resize(mFFT.GetBinCount());
       // Keep spectrum size consistent with constructor: positive frequencies only
       mSpectrum.resize(mFFTSizeInt / 2);
       GenerateWindow();
@@ -181,7 +184,7 @@ public:
 
   FFTAnalysis(FFTSize fftSize = FFTSize::Default,
               WindowType windowType = WindowType::Hanning,
-              float sampleRate = Helpers::CurrentSampleRate);
+              float sampleRate = Helpers::CurrentSampleRate());
 
   // Configuration
   void SetSampleRate(float sampleRate);
@@ -257,6 +260,7 @@ private:
   };
 
   FFTAnalysis mFFTAnalysis;  // Underlying FFT analysis
+  AnalysisTap<M7::FloatPair> mTap;
   std::vector<PeakDetector> mPeakDetectors[3];
   std::vector<SpectrumBin> mBuffers[3][2];
   std::atomic<int> mActiveBuffer{0};
@@ -289,6 +293,8 @@ private:
                            std::vector<PeakDetector>& detectors,
                            std::vector<SpectrumBin>& out);
   float InterpolateMagnitude(const std::vector<SpectrumBin>& spectrum, float frequency) const;
+  void ProcessSamplesNow(float leftSample, float rightSample);
+  void ResetNow();
   const std::vector<SpectrumBin>& GetChannelSpectrum(int channel) const;
   float GetChannelMagnitudeAtFrequency(int channel, float frequency) const;
 
@@ -357,10 +363,14 @@ public:
     return mCurrentAveragingWindowMs;
   }
 
-  // Feed samples and update smoothing when new spectrum is available
+  // Feed samples and update smoothing when new spectrum is available.
+  // Once DrainTap() has been called, this only queues the samples.
   void ProcessSamples(float leftSample, float rightSample);
   void ProcessSamples(const M7::FloatPair& s);
 
+  // analysis worker side: runs the FFT + smoothing for everything queued since the last call.
+  void DrainTap();
+
   // Process new FFT data for display (optional external use)
   void ProcessSpectrum(const std::vector<SpectrumBin>& rawSpectrum);
 
@@ -405,6 +415,7 @@ class SmoothedMonoFFT : public IFrequencyAnalysis
 {
 private:
   MonoFFTAnalysis mFFTAnalysis;
+  AnalysisTap<float> mTap;
   std::vector<PeakDetector> mPeakDetectors;
   std::vector<SpectrumBin> mBuffers[2];
   std::atomic<int> mActiveBuffer{0};
@@ -543,8 +554,31 @@ public:
     return mCurrentAveragingWindowMs;
   }
 
-  // Feed samples and update smoothing when new spectrum is available
+  // Feed samples and update smoothing when new spectrum is available.
+  // Once DrainTap() has been called, this only queues the sample.
   void ProcessSample(float sample)
+  {
+    if (mTap.IsActive())
+    {
+      mTap.Push(sample);
+      return;
+    }
+    ProcessSampleNow(sample);
+  }
+
+  // analysis worker side
+  void DrainTap()
+  {
+    mTap.Enable();
+    if (mTap.ConsumeResetRequest())
+    {
+      mTap.Discard();
+      ResetNow();
+    }
+    mTap.Drain([this](float s) { ProcessSampleNow(s); });
+  }
+
+  void ProcessSampleNow(float sample)
   {
     if (mInputDecimationFactor > 1)
     {
@@ -621,6 +655,16 @@ public:
   }
 
   void Reset()
+  {
+    if (mTap.IsActive())
+    {
+      mTap.RequestReset();
+      return;
+    }
+    ResetNow();
+  }
+
+  void ResetNow()
   {
     for (auto& detector : mPeakDetectors)
       detector.Reset();
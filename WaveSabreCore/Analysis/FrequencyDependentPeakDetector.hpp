@@ -40,12 +40,12 @@ struct FrequencyDependentPeakDetector : IPeakDetector
     double prevCurrentPeak = mCurrentPeak;
     bool prevClipIndicator = mClipIndicator;
 
-    mClipHoldSamples = int(clipHoldMS * Helpers::CurrentSampleRateF / 1000);
-    mPeakHoldSamples = int(peakHoldMS * Helpers::CurrentSampleRateF / 1000);
+    mClipHoldSamples = int(clipHoldMS * Helpers::CurrentSampleRateF() / 1000);
+    mPeakHoldSamples = int(peakHoldMS * Helpers::CurrentSampleRateF() / 1000);
     mFrequency = frequency;
 
     // Calculate base falloff multiplier (60dB falloff)
-    double falloffSamples = peakFalloffMaxMS * Helpers::CurrentSampleRateF / 1000.0;
+    double falloffSamples = peakFalloffMaxMS * Helpers::CurrentSampleRateF() / 1000.0;
     if (falloffSamples < 1.0)
       falloffSamples = 1.0;  // guard
     const double dBFalloffRange = 60.0;
@@ -9,7 +9,7 @@ static inline float CalcFollowerCoef(float ms)
 {
   auto samples = M7::math::MillisecondsToSamples(ms);
   return M7::math::expf(-1.0f / samples);
-  //return M7::math::expf(-1.0f / (Helpers::CurrentSampleRateF * ms / 1000.0f));
+  //return M7::math::expf(-1.0f / (Helpers::CurrentSampleRateF() * ms / 1000.0f));
 }
 
 #ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
@@ -77,12 +77,12 @@ struct FrequencyDependentPeakDetector
     double prevCurrentPeak = mCurrentPeak;
     bool prevClipIndicator = mClipIndicator;
 
-    mClipHoldSamples = int(clipHoldMS * Helpers::CurrentSampleRateF / 1000);
-    mPeakHoldSamples = int(peakHoldMS * Helpers::CurrentSampleRateF / 1000);
+    mClipHoldSamples = int(clipHoldMS * Helpers::CurrentSampleRateF() / 1000);
+    mPeakHoldSamples = int(peakHoldMS * Helpers::CurrentSampleRateF() / 1000);
     mFrequency = frequency;
 
     // Calculate base falloff multiplier (60dB falloff)
-    double falloffSamples = peakFalloffMaxMS * Helpers::CurrentSampleRateF / 1000.0;
+    double falloffSamples = peakFalloffMaxMS * Helpers::CurrentSampleRateF() / 1000.0;
     if (falloffSamples < 1.0)
       falloffSamples = 1.0;  // guard
     const double dBFalloffRange = 60.0;
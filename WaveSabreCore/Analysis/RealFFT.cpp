@@ -0,0 +1,252 @@
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+
+#include "RealFFT.hpp"
+
+#include <cmath>
+#include <memory>
+#include <mutex>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE__)
+  #define WAVESABRE_REALFFT_SSE
+  #include <xmmintrin.h>
+#endif
+
+namespace WaveSabreCore
+{
+namespace
+{
+int Log2OfPow2(int n)
+{
+  int ret = 0;
+  while ((1 << ret) < n)
+    ++ret;
+  return ret;
+}
+
+std::unique_ptr<RealFFT::Tables> BuildTables(int n)
+{
+  auto t = std::make_unique<RealFFT::Tables>();
+  const int m = n / 2;
+  t->mSize = n;
+  t->mHalfSize = m;
+
+  const int bits = Log2OfPow2(m);
+  t->mBitReverse.resize(m);
+  for (int i = 0; i < m; ++i)
+  {
+    int r = 0;
+    for (int b = 0; b < bits; ++b)
+    {
+      r |= ((i >> b) & 1) << (bits - 1 - b);
+    }
+    t->mBitReverse[i] = r;
+  }
+
+  constexpr double kTwoPi = 6.283185307179586476925286766559;
+  t->mStageRe.resize(m > 1 ? m - 1 : 1);
+  t->mStageIm.resize(m > 1 ? m - 1 : 1);
+  for (int length = 2; length <= m; length <<= 1)
+  {
+    const int half = length / 2;
+    for (int j = 0; j < half; ++j)
+    {
+      const double a = -kTwoPi * j / length;
+      t->mStageRe[half - 1 + j] = (float)std::cos(a);
+      t->mStageIm[half - 1 + j] = (float)std::sin(a);
+    }
+  }
+
+  t->mSplitRe.resize(m / 2 + 1);
+  t->mSplitIm.resize(m / 2 + 1);
+  for (int k = 0; k <= m / 2; ++k)
+  {
+    const double a = -kTwoPi * k / n;
+    t->mSplitRe[k] = (float)std::cos(a);
+    t->mSplitIm[k] = (float)std::sin(a);
+  }
+  return t;
+}
+}  // namespace
+
+const RealFFT::Tables& RealFFT::GetTables(int n)
+{
+  static std::mutex sMutex;
+  static std::unique_ptr<Tables> sTables[kMaxSizeLog2 + 1];
+
+  int log2n = Log2OfPow2(n);
+  log2n = log2n < kMinSizeLog2 ? kMinSizeLog2 : (log2n > kMaxSizeLog2 ? kMaxSizeLog2 : log2n);
+
+  std::lock_guard<std::mutex> lock(sMutex);
+  auto& slot = sTables[log2n];
+  if (!slot)
+  {
+    slot = BuildTables(1 << log2n);
+  }
+  return *slot;
+}
+
+RealFFT::RealFFT(int n)
+{
+  SetSize(n);
+}
+
+void RealFFT::SetSize(int n)
+{
+  mTables = &GetTables(n);
+  mRe.assign(mTables->mHalfSize + 1, 0.0f);
+  mIm.assign(mTables->mHalfSize + 1, 0.0f);
+}
+
+void RealFFT::Forward(const float* frame, const float* window)
+{
+  const int m = mTables->mHalfSize;
+  const int* br = mTables->mBitReverse.data();
+  float* re = mRe.data();
+  float* im = mIm.data();
+
+  // gather even/odd samples into bit-reversed order, windowing on the way.
+  if (window)
+  {
+    for (int k = 0; k < m; ++k)
+    {
+      const int s = br[k] * 2;
+      re[k] = frame[s] * window[s];
+      im[k] = frame[s + 1] * window[s + 1];
+    }
+  }
+  else
+  {
+    for (int k = 0; k < m; ++k)
+    {
+      const int s = br[k] * 2;
+      re[k] = frame[s];
+      im[k] = frame[s + 1];
+    }
+  }
+
+  Butterflies();
+  Split();
+}
+
+void RealFFT::Butterflies()
+{
+  const int m = mTables->mHalfSize;
+  const float* twRe = mTables->mStageRe.data();
+  const float* twIm = mTables->mStageIm.data();
+  float* re = mRe.data();
+  float* im = mIm.data();
+
+  for (int length = 2; length <= m; length <<= 1)
+  {
+    const int half = length / 2;
+    const float* wr = twRe + half - 1;
+    const float* wi = twIm + half - 1;
+
+    for (int i = 0; i < m; i += length)
+    {
+      float* ur = re + i;
+      float* ui = im + i;
+      float* vr = ur + half;
+      float* vi = ui + half;
+      int j = 0;
+
+#ifdef WAVESABRE_REALFFT_SSE
+      for (; j + 4 <= half; j += 4)
+      {
+        const __m128 twr = _mm_loadu_ps(wr + j);
+        const __m128 twi = _mm_loadu_ps(wi + j);
+        const __m128 xr = _mm_loadu_ps(vr + j);
+        const __m128 xi = _mm_loadu_ps(vi + j);
+        const __m128 tr = _mm_sub_ps(_mm_mul_ps(xr, twr), _mm_mul_ps(xi, twi));
+        const __m128 ti = _mm_add_ps(_mm_mul_ps(xr, twi), _mm_mul_ps(xi, twr));
+        const __m128 ar = _mm_loadu_ps(ur + j);
+        const __m128 ai = _mm_loadu_ps(ui + j);
+        _mm_storeu_ps(vr + j, _mm_sub_ps(ar, tr));
+        _mm_storeu_ps(vi + j, _mm_sub_ps(ai, ti));
+        _mm_storeu_ps(ur + j, _mm_add_ps(ar, tr));
+        _mm_storeu_ps(ui + j, _mm_add_ps(ai, ti));
+      }
+#endif  // WAVESABRE_REALFFT_SSE
+
+      for (; j < half; ++j)
+      {
+        const float tr = vr[j] * wr[j] - vi[j] * wi[j];
+        const float ti = vr[j] * wi[j] + vi[j] * wr[j];
+        vr[j] = ur[j] - tr;
+        vi[j] = ui[j] - ti;
+        ur[j] += tr;
+        ui[j] += ti;
+      }
+    }
+  }
+}
+
+void RealFFT::Split()
+{
+  const int m = mTables->mHalfSize;
+  const float* sr = mTables->mSplitRe.data();
+  const float* si = mTables->mSplitIm.data();
+  float* re = mRe.data();
+  float* im = mIm.data();
+
+  // DC and Nyquist are purely real.
+  const float z0r = re[0];
+  const float z0i = im[0];
+  re[0] = z0r + z0i;
+  im[0] = 0;
+  re[m] = z0r - z0i;
+  im[m] = 0;
+
+  // bins k and M-k are produced from the same pair of inputs; do them together in place.
+  for (int k = 1; k <= m / 2; ++k)
+  {
+    const int nk = m - k;
+    const float ar = re[k];
+    const float ai = im[k];
+    const float br = re[nk];
+    const float bi = -im[nk];  // conj(Z[M-k])
+
+    // even part: (a + b) / 2
+    const float er = 0.5f * (ar + br);
+    const float ei = 0.5f * (ai + bi);
+    // odd part: -i * (a - b) / 2
+    const float or_ = 0.5f * (ai - bi);
+    const float oi = -0.5f * (ar - br);
+    // W^k * odd
+    const float tr = or_ * sr[k] - oi * si[k];
+    const float ti = or_ * si[k] + oi * sr[k];
+
+    re[k] = er + tr;
+    im[k] = ei + ti;
+    if (nk != k)
+    {
+      // X[M-k] = conj(even - W^k * odd)
+      re[nk] = er - tr;
+      im[nk] = ti - ei;
+    }
+  }
+}
+
+void RealFFT::Magnitudes(float* out) const
+{
+  const int count = GetBinCount();
+  const float* re = mRe.data();
+  const float* im = mIm.data();
+  int k = 0;
+#ifdef WAVESABRE_REALFFT_SSE
+  for (; k + 4 <= count; k += 4)
+  {
+    const __m128 r = _mm_loadu_ps(re + k);
+    const __m128 i = _mm_loadu_ps(im + k);
+    _mm_storeu_ps(out + k, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(i, i))));
+  }
+#endif  // WAVESABRE_REALFFT_SSE
+  for (; k < count; ++k)
+  {
+    out[k] = std::sqrt(re[k] * re[k] + im[k] * im[k]);
+  }
+}
+
+}  // namespace WaveSabreCore
+
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
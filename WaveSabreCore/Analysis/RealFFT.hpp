@@ -0,0 +1,84 @@
+#pragma once
+
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+
+  #include <vector>
+
+namespace WaveSabreCore
+{
+// Real-input forward FFT.
+//
+// An N-point real transform is computed as an N/2-point complex FFT over the input packed as
+// z[k] = x[2k] + i*x[2k+1], followed by a split pass which separates the even/odd spectra and
+// produces bins 0..N/2. That halves the butterfly work compared to a complex FFT with zeroed
+// imaginary parts.
+//
+// Twiddles are computed directly (in double precision) rather than by repeated complex
+// multiplication, so they don't drift. They're stored per stage contiguously, split re/im,
+// which lets the butterflies of each stage run 4-wide. Tables are built once per size and
+// shared by every RealFFT instance in the process.
+class RealFFT
+{
+public:
+  static constexpr int kMinSizeLog2 = 2;
+  static constexpr int kMaxSizeLog2 = 16;
+
+  struct Tables
+  {
+    int mSize = 0;      // N (real input length)
+    int mHalfSize = 0;  // M = N/2 (complex FFT length)
+    // bit-reverse permutation of 0..M-1
+    std::vector<int> mBitReverse;
+    // stage twiddles, concatenated. for stage length L, entries [L/2-1, L-1) hold exp(-2pi*i*j/L), j < L/2.
+    std::vector<float> mStageRe;
+    std::vector<float> mStageIm;
+    // split-pass twiddles exp(-2pi*i*k/N), k <= M/2
+    std::vector<float> mSplitRe;
+    std::vector<float> mSplitIm;
+  };
+
+  // returns the shared tables for size n (power of 2 within [2^kMinSizeLog2, 2^kMaxSizeLog2]).
+  static const Tables& GetTables(int n);
+
+  explicit RealFFT(int n = 4096);
+
+  void SetSize(int n);
+  int GetSize() const
+  {
+    return mTables->mSize;
+  }
+  // number of output bins (N/2 + 1, DC through Nyquist inclusive)
+  int GetBinCount() const
+  {
+    return mTables->mHalfSize + 1;
+  }
+
+  // Transforms frame[i] * window[i] (window may be null). The window is applied while the input
+  // is gathered into bit-reversed order, so there is no separate windowed copy of the frame.
+  // Results are readable via Real()/Imag() for bins 0..N/2.
+  void Forward(const float* frame, const float* window);
+
+  const float* Real() const
+  {
+    return mRe.data();
+  }
+  const float* Imag() const
+  {
+    return mIm.data();
+  }
+
+  // writes |X[k]| for k in 0..N/2 (GetBinCount() values)
+  void Magnitudes(float* out) const;
+
+private:
+  const Tables* mTables = nullptr;
+  std::vector<float> mRe;  // M+1 (the extra slot receives the Nyquist bin)
+  std::vector<float> mIm;
+
+  void Butterflies();
+  void Split();
+};
+
+}  // namespace WaveSabreCore
+
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
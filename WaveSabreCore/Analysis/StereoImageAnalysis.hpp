@@ -106,7 +106,7 @@ private:
   template <typename TAnalyzer>
   static void ConfigureAnalyzerDefaults(TAnalyzer& analyzer)
   {
-    analyzer.SetSampleRate(Helpers::CurrentSampleRateF);
+    analyzer.SetSampleRate(Helpers::CurrentSampleRateF());
     analyzer.SetFFTSize(MonoFFTAnalysis::FFTSize::Default);
     analyzer.SetOverlapFactor(4);
     analyzer.SetPeakHoldTime(100);
@@ -0,0 +1,313 @@
+#include "Arena.hpp"
+
+#ifndef MIN_SIZE_REL
+
+#ifdef _WIN32
+  #include <Windows.h>
+#else
+  #include <sys/mman.h>
+#endif  // _WIN32
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <new>
+
+namespace WaveSabreCore
+{
+thread_local Arena* Arena::tpCurrent = nullptr;
+thread_local int Arena::tOwner = -1;
+thread_local MemorySubsystem Arena::tSubsystem = MemorySubsystem::Other;
+
+namespace
+{
+// arenas are few (one per renderer); a fixed table keeps FindOwner() lock-free for ArenaFree().
+constexpr int kMaxArenas = 64;
+std::atomic<Arena*> gArenas[kMaxArenas];
+std::atomic<int> gArenaCount{0};
+
+constexpr size_t kCommitGranularity = size_t(1) << 20;
+}  // namespace
+
+Arena::Arena(size_t reserveBytes)
+{
+#ifdef _WIN32
+  mpBase = (uint8_t*)::VirtualAlloc(nullptr, reserveBytes, MEM_RESERVE, PAGE_NOACCESS);
+#else
+  void* p = ::mmap(nullptr, reserveBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  mpBase = (p == MAP_FAILED) ? nullptr : (uint8_t*)p;
+#endif  // _WIN32
+  if (!mpBase)
+    return;
+  mReservedBytes = reserveBytes;
+
+  for (auto& slot : gArenas)
+  {
+    Arena* expected = nullptr;
+    if (slot.compare_exchange_strong(expected, this))
+    {
+      gArenaCount++;
+      if (void* freeLists = AllocateShared(sizeof(FreeLists), 64))
+        mpFreeLists = new (freeLists) FreeLists{};
+      return;
+    }
+  }
+  // too many live arenas; ArenaFree() would hand an unregistered arena's blocks to the heap,
+  // so this one stays invalid and everything goes to the heap instead.
+#ifdef _WIN32
+  ::VirtualFree(mpBase, 0, MEM_RELEASE);
+#else
+  ::munmap(mpBase, mReservedBytes);
+#endif  // _WIN32
+  mpBase = nullptr;
+  mReservedBytes = 0;
+}
+
+Arena::~Arena()
+{
+  if (!mpBase)
+    return;
+  for (auto& slot : gArenas)
+  {
+    Arena* expected = this;
+    if (slot.compare_exchange_strong(expected, nullptr))
+    {
+      gArenaCount--;
+      break;
+    }
+  }
+#ifdef _WIN32
+  ::VirtualFree(mpBase, 0, MEM_RELEASE);
+#else
+  ::munmap(mpBase, mReservedBytes);
+#endif  // _WIN32
+}
+
+void* Arena::Allocate(size_t bytes, size_t alignment)
+{
+  if (!mpFreeLists)
+    return nullptr;
+  if (alignment < sizeof(BlockHeader))
+    alignment = sizeof(BlockHeader);
+  // blocks start 16-byte aligned; anything stricter needs room to slide the payload along.
+  const size_t needed = bytes + sizeof(BlockHeader) + (alignment - sizeof(BlockHeader));
+  if (needed < bytes)
+    return nullptr;
+  int sizeClass = kMinSizeClass;
+  while (sizeClass < kSizeClassCount - 1 && (size_t(1) << sizeClass) < needed)
+    sizeClass++;
+  if ((size_t(1) << sizeClass) < needed)
+    return nullptr;
+
+  uint8_t* block = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mFreeListMutex);
+    uint8_t*& head = mpFreeLists->mHeads[sizeClass];
+    if (head)
+    {
+      block = head;
+      head = *(uint8_t**)block;
+    }
+  }
+  if (!block)
+    block = AllocateBlock(size_t(1) << sizeClass);
+  if (!block)
+    return nullptr;
+
+  auto payload = (uint8_t*)(((uintptr_t)block + sizeof(BlockHeader) + alignment - 1) & ~(uintptr_t)(alignment - 1));
+  auto header = (BlockHeader*)payload - 1;
+  header->mSizeClass = (uint32_t)sizeClass;
+  header->mPayloadOffset = (uint32_t)(payload - block);
+  header->mReserved = 0;
+
+  if (mpAccounts)
+  {
+    // remembered in the header so Free() can take the bytes back off the same account.
+    const int owner = tOwner;
+    const int account = owner >= 0 && owner < mNumOwners ? owner : mNumOwners;
+    const size_t accounted = bytes < kAccountedBytesMask ? bytes : (size_t)kAccountedBytesMask;
+    mpAccounts[account].mBytes[(int)tSubsystem].fetch_add(accounted, std::memory_order_relaxed);
+    header->mReserved = (uint64_t(account + 1) << 48) | (uint64_t(tSubsystem) << 40) | accounted;
+  }
+  return payload;
+}
+
+void Arena::Free(void* p)
+{
+  auto header = (BlockHeader*)p - 1;
+  const int sizeClass = (int)header->mSizeClass;
+  uint8_t* block = (uint8_t*)p - header->mPayloadOffset;
+  if (header->mReserved && mpAccounts)
+  {
+    const int account = (int)(header->mReserved >> 48) - 1;
+    const int subsystem = (int)(header->mReserved >> 40) & 0xff;
+    mpAccounts[account].mBytes[subsystem].fetch_sub((size_t)(header->mReserved & kAccountedBytesMask), std::memory_order_relaxed);
+  }
+  std::lock_guard<std::mutex> lock(mFreeListMutex);
+  uint8_t*& head = mpFreeLists->mHeads[sizeClass];
+  *(uint8_t**)block = head;
+  head = block;
+}
+
+uint8_t* Arena::AllocateBlock(size_t blockBytes)
+{
+  const int owner = tOwner;
+  if (!mpAccounts || owner < 0 || owner >= mNumOwners || blockBytes > kOwnerChunkBytes / 4)
+    return (uint8_t*)AllocateShared(blockBytes, sizeof(BlockHeader));
+
+  // an owner only allocates on one thread at a time, so its chunk needs no synchronization.
+  // chunks are 64-byte aligned and blocks are powers of two from 32 bytes, so the cursor stays aligned.
+  Account& account = mpAccounts[owner];
+  if (!account.mpCursor || account.mpCursor + blockBytes > account.mpEnd)
+  {
+    auto chunk = (uint8_t*)AllocateShared(kOwnerChunkBytes, 64);
+    if (!chunk)
+      return nullptr;
+    account.mpCursor = chunk;
+    account.mpEnd = chunk + kOwnerChunkBytes;
+  }
+  uint8_t* block = account.mpCursor;
+  account.mpCursor += blockBytes;
+  return block;
+}
+
+void* Arena::AllocateShared(size_t bytes, size_t alignment)
+{
+  size_t offset = mUsedBytes.load(std::memory_order_relaxed);
+  size_t begin, end;
+  do
+  {
+    begin = (offset + alignment - 1) & ~(alignment - 1);
+    end = begin + bytes;
+    if (end > mReservedBytes || end < begin)
+      return nullptr;
+  } while (!mUsedBytes.compare_exchange_weak(offset, end, std::memory_order_relaxed));
+  Commit(end);
+  return mpBase + begin;
+}
+
+void Arena::Commit(size_t endBytes)
+{
+#ifdef _WIN32
+  if (endBytes <= mCommittedBytes.load(std::memory_order_acquire))
+    return;
+  std::lock_guard<std::mutex> lock(mCommitMutex);
+  size_t committed = mCommittedBytes.load(std::memory_order_relaxed);
+  if (endBytes <= committed)
+    return;
+  size_t newCommitted = (endBytes + kCommitGranularity - 1) & ~(kCommitGranularity - 1);
+  if (newCommitted > mReservedBytes)
+    newCommitted = mReservedBytes;
+  ::VirtualAlloc(mpBase + committed, newCommitted - committed, MEM_COMMIT, PAGE_READWRITE);
+  mCommittedBytes.store(newCommitted, std::memory_order_release);
+#else
+  // MAP_NORESERVE pages are backed on first touch.
+  (void)endBytes;
+#endif  // _WIN32
+}
+
+void Arena::EnableAccounting(int numOwners)
+{
+  if (mpAccounts || !mpBase)
+    return;
+  if (numOwners > kMaxAccountingOwners)
+    numOwners = kMaxAccountingOwners;  // the rest go unowned
+  const size_t bytes = sizeof(Account) * (numOwners + 1);
+  auto accounts = (Account*)AllocateShared(bytes, alignof(Account));
+  if (!accounts)
+    return;
+  // may be reused space after a Restore.
+  for (int i = 0; i <= numOwners; i++)
+    new (accounts + i) Account();
+  mNumOwners = numOwners;
+  mpAccounts = accounts;
+}
+
+size_t Arena::GetAccountedBytes(int owner, MemorySubsystem subsystem) const
+{
+  if (!mpAccounts)
+    return 0;
+  const bool owned = owner >= 0 && owner < mNumOwners;
+  return mpAccounts[owned ? owner : mNumOwners].mBytes[(int)subsystem].load(std::memory_order_relaxed);
+}
+
+void Arena::Save(Snapshot& snapshot) const
+{
+  snapshot.assign(mpBase, mpBase + GetUsedBytes());
+}
+
+void Arena::Restore(const Snapshot& snapshot)
+{
+  // committed pages never shrink, so everything up to the snapshot's size is still there.
+  memcpy(mpBase, snapshot.data(), snapshot.size());
+  mUsedBytes.store(snapshot.size(), std::memory_order_relaxed);
+}
+
+Arena* Arena::FindOwner(const void* p)
+{
+  if (!gArenaCount.load(std::memory_order_relaxed))
+    return nullptr;
+  for (auto& slot : gArenas)
+  {
+    Arena* arena = slot.load(std::memory_order_acquire);
+    if (arena && arena->Contains(p))
+      return arena;
+  }
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+void* HeapAllocate(size_t bytes, size_t alignment)
+{
+#ifdef _WIN32
+  return ::_aligned_malloc(bytes ? bytes : 1, alignment);
+#else
+  void* p = nullptr;
+  return ::posix_memalign(&p, alignment, bytes ? bytes : 1) ? nullptr : p;
+#endif  // _WIN32
+}
+
+void HeapFree(void* p)
+{
+#ifdef _WIN32
+  ::_aligned_free(p);
+#else
+  ::free(p);
+#endif  // _WIN32
+}
+}  // namespace
+
+void* ArenaAllocate(size_t bytes, size_t alignment)
+{
+  if (alignment < sizeof(void*))
+    alignment = sizeof(void*);
+  if (auto* arena = Arena::Current())
+  {
+    if (void* p = arena->Allocate(bytes, alignment))
+      return p;
+    arena->NoteOverflow(bytes);
+  }
+  void* p = HeapAllocate(bytes, alignment);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+void ArenaFree(void* p)
+{
+  if (!p)
+    return;
+  if (auto* arena = Arena::FindOwner(p))
+  {
+    arena->Free(p);
+    return;
+  }
+  HeapFree(p);
+}
+
+}  // namespace WaveSabreCore
+
+#endif  // MIN_SIZE_REL
@@ -0,0 +1,316 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef MIN_SIZE_REL
+  #include <atomic>
+  #include <mutex>
+  #include <new>
+  #include <type_traits>
+  #include <vector>
+#endif  // MIN_SIZE_REL
+
+namespace WaveSabreCore
+{
+// what an allocation is for, in Arena's memory accounting. innermost scope wins.
+enum class MemorySubsystem : uint8_t
+{
+  Other,        // whatever the owner allocates outside a more specific scope
+  Voices,
+  Oscillators,  // waveform cores
+  Filters,
+  Buffers,      // PodBuffer storage: delay lines, sample data, ...
+  Tracks,
+  Events,
+  Automation,
+  Count,
+};
+
+#ifndef MIN_SIZE_REL
+
+// an allocator over one reserved address range, used for everything a song renderer owns.
+// nothing goes here implicitly: the song's object graph derives from ArenaAllocated (devices, voices,
+// oscillator cores, ...) and its arrays and buffers use ArenaAllocate() / ArenaNewArray(). while an arena
+// is bound on a thread (Scope), those allocate from it; anything else, and everything when no arena is
+// bound, uses the CRT heap. if the range runs out, allocation falls back to the heap and the overflow is
+// counted.
+//
+// blocks come in power-of-two size classes; a freed block goes on its class's free list and is reused
+// by the next allocation of that class, so a device that keeps replacing state (waveform cores on
+// automation, regrown buffers) doesn't grow the arena beyond its peak.
+//
+// because the whole object graph lives in one range at fixed addresses, its complete state can be
+// copied out (Save) and back (Restore) with memcpy: internal pointers stay valid, and anything allocated
+// after the snapshot is dropped along with the pointers to it. the free lists live inside the range, so
+// they're rolled back too. state outside the range (the CRT's rand() seed, OS handles, process-wide
+// tables, heap data the graph points at) isn't part of a snapshot; heap data must not be freed while a
+// snapshot may still refer to it.
+//
+// with accounting enabled, allocations are attributed to the owner (OwnerScope) and subsystem
+// (ArenaSubsystemScope) bound on the allocating thread until they're freed, so the figures are live
+// bytes rather than everything ever allocated. each owner's small allocations are packed
+// into its own chunks instead of interleaving with whatever other threads allocate at the same time.
+// the bookkeeping lives inside the arena, so snapshots carry it too.
+class Arena
+{
+public:
+  // reserves address space only; pages are committed as allocation reaches them.
+  explicit Arena(size_t reserveBytes = kDefaultReserveBytes);
+  ~Arena();
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  // 32-bit processes share 2GB of address space with everything else, and BatchRenderer keeps a renderer
+  // (and so an arena) per running job.
+  static constexpr size_t kDefaultReserveBytes = sizeof(void*) == 8 ? (size_t(8) << 30) : (size_t(128) << 20);
+  static constexpr size_t kOwnerChunkBytes = 64 << 10;
+
+  // false if the range couldn't be reserved; everything then goes to the heap.
+  bool IsValid() const
+  {
+    return !!mpBase;
+  }
+
+  // thread-safe, except that one owner must not allocate on two threads at once.
+  // returns nullptr when the reservation is exhausted.
+  void* Allocate(size_t bytes, size_t alignment);
+  // p must have come from Allocate() on this arena.
+  void Free(void* p);
+
+  bool Contains(const void* p) const
+  {
+    return (const uint8_t*)p >= mpBase && (const uint8_t*)p < mpBase + mReservedBytes;
+  }
+
+  size_t GetUsedBytes() const
+  {
+    return mUsedBytes.load(std::memory_order_relaxed);
+  }
+  size_t GetReservedBytes() const
+  {
+    return mReservedBytes;
+  }
+
+  // owners are 0..numOwners-1; allocations with no owner bound are accounted separately (owner -1).
+  // does nothing if already enabled. blocks allocated before this aren't accounted, not even when freed.
+  void EnableAccounting(int numOwners);
+  bool IsAccounting() const
+  {
+    return !!mpAccounts;
+  }
+  size_t GetAccountedBytes(int owner, MemorySubsystem subsystem) const;
+
+  // bytes that went to the heap because the range was full.
+  size_t GetOverflowBytes() const
+  {
+    return mOverflowBytes.load(std::memory_order_relaxed);
+  }
+  void NoteOverflow(size_t bytes)
+  {
+    mOverflowBytes += bytes;
+  }
+
+  // nothing may be allocating from or running on the arena's objects during these.
+  using Snapshot = std::vector<uint8_t>;
+  void Save(Snapshot& snapshot) const;
+  void Restore(const Snapshot& snapshot);
+
+  static Arena* Current()
+  {
+    return tpCurrent;
+  }
+
+  // the arena that owns p, if any. cheap when no arenas exist.
+  static Arena* FindOwner(const void* p);
+
+  // binds an arena on this thread; nullptr binds none (back to the heap).
+  class Scope
+  {
+  public:
+    explicit Scope(Arena* arena) : mpPrevious(tpCurrent)
+    {
+      tpCurrent = arena;
+    }
+    ~Scope()
+    {
+      tpCurrent = mpPrevious;
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    Arena* mpPrevious;
+  };
+
+  // attributes this thread's allocations to an owner of whichever arena is bound.
+  class OwnerScope
+  {
+  public:
+    explicit OwnerScope(int owner) : mPrevious(tOwner)
+    {
+      tOwner = owner;
+    }
+    ~OwnerScope()
+    {
+      tOwner = mPrevious;
+    }
+    OwnerScope(const OwnerScope&) = delete;
+    OwnerScope& operator=(const OwnerScope&) = delete;
+
+  private:
+    int mPrevious;
+  };
+
+private:
+  friend class ArenaSubsystemScope;
+
+  // in front of every block's payload.
+  struct BlockHeader
+  {
+    uint32_t mSizeClass;
+    uint32_t mPayloadOffset;  // from the start of the block
+    // accounting: account index + 1 (0 if unaccounted) << 48 | subsystem << 40 | requested bytes.
+    uint64_t mReserved;
+  };
+  static_assert(sizeof(BlockHeader) == 16, "keeps payloads 16-byte aligned");
+
+  static constexpr uint64_t kAccountedBytesMask = (uint64_t(1) << 40) - 1;
+  static constexpr int kMaxAccountingOwners = 0xfffe;
+  static constexpr int kMinSizeClass = 5;  // 32 bytes: a header and a bit.
+  static constexpr int kSizeClassCount = sizeof(void*) * 8;
+
+  // heads of each size class's free list; the next pointer is stored in the freed block itself.
+  struct FreeLists
+  {
+    uint8_t* mHeads[kSizeClassCount];
+  };
+
+  struct Account
+  {
+    uint8_t* mpCursor;
+    uint8_t* mpEnd;
+    std::atomic<size_t> mBytes[(int)MemorySubsystem::Count];
+  };
+
+  uint8_t* AllocateBlock(size_t blockBytes);
+  void* AllocateShared(size_t bytes, size_t alignment);
+  void Commit(size_t endBytes);
+
+  uint8_t* mpBase = nullptr;
+  size_t mReservedBytes = 0;
+  std::atomic<size_t> mUsedBytes{0};
+  std::atomic<size_t> mCommittedBytes{0};
+  std::atomic<size_t> mOverflowBytes{0};
+  std::mutex mCommitMutex;
+  std::mutex mFreeListMutex;
+
+  // allocated inside the arena.
+  FreeLists* mpFreeLists = nullptr;
+
+  // [numOwners] is the unowned account. allocated inside the arena.
+  Account* mpAccounts = nullptr;
+  int mNumOwners = 0;
+
+  static thread_local Arena* tpCurrent;
+  static thread_local int tOwner;
+  static thread_local MemorySubsystem tSubsystem;
+};
+
+// allocation from the bound arena, else the heap; p may come from either. throws std::bad_alloc like
+// operator new.
+void* ArenaAllocate(size_t bytes, size_t alignment);
+void ArenaFree(void* p);
+
+#endif  // MIN_SIZE_REL
+
+// base for the types a song renderer's object graph is made of, so they land in the renderer's arena.
+// empty, and without effect, in size builds.
+struct ArenaAllocated
+{
+#ifndef MIN_SIZE_REL
+  static void* operator new(size_t bytes)
+  {
+    return ArenaAllocate(bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+  }
+  static void* operator new[](size_t bytes)
+  {
+    return ArenaAllocate(bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+  }
+  static void* operator new(size_t bytes, std::align_val_t alignment)
+  {
+    return ArenaAllocate(bytes, (size_t)alignment);
+  }
+  static void* operator new[](size_t bytes, std::align_val_t alignment)
+  {
+    return ArenaAllocate(bytes, (size_t)alignment);
+  }
+  static void* operator new(size_t, void* where) noexcept
+  {
+    return where;
+  }
+  static void operator delete(void* p) noexcept
+  {
+    ArenaFree(p);
+  }
+  static void operator delete[](void* p) noexcept
+  {
+    ArenaFree(p);
+  }
+  static void operator delete(void* p, std::align_val_t) noexcept
+  {
+    ArenaFree(p);
+  }
+  static void operator delete[](void* p, std::align_val_t) noexcept
+  {
+    ArenaFree(p);
+  }
+  static void operator delete(void*, void*) noexcept {}
+#endif  // MIN_SIZE_REL
+};
+
+// arrays of trivial types (events, buffers, tables of pointers) in the bound arena. left uninitialized,
+// like new T[count]. in size builds they're exactly that.
+template <typename T>
+T* ArenaNewArray(size_t count)
+{
+#ifdef MIN_SIZE_REL
+  return new T[count];
+#else
+  static_assert(std::is_trivial_v<T>, "ArenaNewArray doesn't construct or destroy elements");
+  return (T*)ArenaAllocate(sizeof(T) * count, alignof(T) < 16 ? 16 : alignof(T));
+#endif  // MIN_SIZE_REL
+}
+
+template <typename T>
+void ArenaDeleteArray(T* p)
+{
+#ifdef MIN_SIZE_REL
+  delete[] p;
+#else
+  ArenaFree(p);
+#endif  // MIN_SIZE_REL
+}
+
+// tags allocations made in this scope for the memory report. compiles away in size builds.
+class ArenaSubsystemScope
+{
+public:
+#ifdef MIN_SIZE_REL
+  explicit ArenaSubsystemScope(MemorySubsystem) {}
+#else
+  explicit ArenaSubsystemScope(MemorySubsystem subsystem) : mPrevious(Arena::tSubsystem)
+  {
+    Arena::tSubsystem = subsystem;
+  }
+  ~ArenaSubsystemScope()
+  {
+    Arena::tSubsystem = mPrevious;
+  }
+
+private:
+  MemorySubsystem mPrevious;
+#endif  // MIN_SIZE_REL
+};
+
+}  // namespace WaveSabreCore
@@ -1,10 +1,15 @@
 #pragma  once
 
+#ifdef _WIN32
 #include <Windows.h>
+#else
+#include <pthread.h>
+#endif // _WIN32
 
 namespace WaveSabreCore
 {
 
+// recursive, like a Win32 critical section; on POSIX it's a recursive pthread mutex.
 class CriticalSection
 {
 public:
@@ -14,11 +19,11 @@ public:
     CriticalSectionGuard(CriticalSection* criticalSection)
         : criticalSection(criticalSection)
     {
-      EnterCriticalSection(&criticalSection->criticalSection);
+      criticalSection->ManualEnter();
     }
     ~CriticalSectionGuard()
     {
-      LeaveCriticalSection(&criticalSection->criticalSection);
+      criticalSection->ManualLeave();
     }
 
   private:
@@ -27,11 +32,23 @@ public:
 
   CriticalSection()
   {
+#ifdef _WIN32
     InitializeCriticalSection(&criticalSection);
+#else
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&criticalSection, &attr);
+    pthread_mutexattr_destroy(&attr);
+#endif // _WIN32
   }
   ~CriticalSection()
   {
+#ifdef _WIN32
     DeleteCriticalSection(&criticalSection);
+#else
+    pthread_mutex_destroy(&criticalSection);
+#endif // _WIN32
   }
 
   CriticalSectionGuard Enter()
@@ -41,15 +58,27 @@ public:
 
   void ManualEnter()
   {
+#ifdef _WIN32
     EnterCriticalSection(&criticalSection);
+#else
+    pthread_mutex_lock(&criticalSection);
+#endif // _WIN32
   }
   void ManualLeave()
   {
+#ifdef _WIN32
     LeaveCriticalSection(&criticalSection);
+#else
+    pthread_mutex_unlock(&criticalSection);
+#endif // _WIN32
   }
 
 private:
+#ifdef _WIN32
   CRITICAL_SECTION criticalSection;
+#else
+  pthread_mutex_t criticalSection;
+#endif // _WIN32
 };
 
-} // namespace WaveSabreCore
\ No newline at end of file
+} // namespace WaveSabreCore
@@ -86,13 +86,13 @@ namespace math
 
 real_t CalculateInc01PerSampleForMS(real_t ms)
 {
-  return clamp01(1000.0f / (std::max(0.01f, ms) * (real_t)Helpers::CurrentSampleRate));
+  return clamp01(1000.0f / (std::max(0.01f, ms) * (real_t)Helpers::CurrentSampleRate()));
 }
 
 float MillisecondsToSamples(float ms)
 {
   static constexpr float oneOver1000 = 1.0f / 1000.0f;  // obsessive optimization?
-  return (ms * ::WaveSabreCore::Helpers::CurrentSampleRateF) * oneOver1000;
+  return (ms * ::WaveSabreCore::Helpers::CurrentSampleRateF()) * oneOver1000;
 }
 
 bool DoesEncounter(double t1, double t2, float x)
@@ -232,7 +232,7 @@ float CalcDelayMS(float eighths, float msOffset, float frequencyHz)
 {
   // 60000/bpm = milliseconds per beat. but we are going to be in 8 divisions per beat.
   // 60000/8 = 7500
-  const float tempo = float(Helpers::CurrentTempo);
+  const float tempo = float(Helpers::CurrentTempo());
   const float tempoMs = (tempo > 0.0f) ? (7500.0f / tempo) * eighths : 0.0f;
 
   const float freqMs = (frequencyHz > 0) ? 1000.0f / frequencyHz : 0;
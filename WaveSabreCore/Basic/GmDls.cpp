@@ -1,144 +1,273 @@
 #include "GmDls.h"
 
-#include <Windows.h>
+#ifdef _WIN32
+  #include <Windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif  // _WIN32
+
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+  #include <cstdlib>
+  #include <cstring>
+  #include <mutex>
+  #include <string>
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
 namespace WaveSabreCore
 {
 
 uint8_t* GmDls::gpData = nullptr;
 
-void GmDls::EnsureInitialized()
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+namespace
 {
-  if (gpData)
-    return;
-  static const char* gmDlsPaths[2] = {
-      "drivers/gm.dls",      //
-      "drivers/etc/gm.dls",  //
-  };
-  gpData = new uint8_t[kGmDlsFileSize];
-#pragma message("GmDls Leaking memory to save bits.")
+std::string gBankPath;
+bool gBankLoaded = false;
+GmDls::SampleInfo gSampleIndex[GmDls::kGmDlsSampleCount];
 
-  // NB: can't use fopen or CreateFile, because they don't resolve the relative paths above.
+uint32_t ReadU32(const uint8_t* p)
+{
+  uint32_t ret;
+  memcpy(&ret, p, sizeof(ret));
+  return ret;
+}
+
+uint16_t ReadU16(const uint8_t* p)
+{
+  uint16_t ret;
+  memcpy(&ret, p, sizeof(ret));
+  return ret;
+}
+
+  #ifdef _WIN32
+// maps the bank read-only so it's shared with every other process that has it open, and pages in lazily.
+uint8_t* MapBank()
+{
   HANDLE file = INVALID_HANDLE_VALUE;
-  for (int i = 0; file == INVALID_HANDLE_VALUE; i++)
+  if (!gBankPath.empty())
   {
-    OFSTRUCT reOpenBuff;
-    file = (HANDLE)(UINT_PTR)OpenFile(gmDlsPaths[i], &reOpenBuff, OF_READ);
+    file = ::CreateFileA(
+        gBankPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  }
+  else
+  {
+    // NB: OpenFile resolves these relative to the system dirs; CreateFile doesn't.
+    static const char* gmDlsPaths[2] = {
+        "drivers/gm.dls",      //
+        "drivers/etc/gm.dls",  //
+    };
+    for (int i = 0; i < 2 && file == INVALID_HANDLE_VALUE; i++)
+    {
+      OFSTRUCT reOpenBuff;
+      file = (HANDLE)(UINT_PTR)OpenFile(gmDlsPaths[i], &reOpenBuff, OF_READ | OF_SHARE_DENY_WRITE);
+      if (file == (HANDLE)(UINT_PTR)HFILE_ERROR)
+        file = INVALID_HANDLE_VALUE;
+    }
+  }
+  if (file == INVALID_HANDLE_VALUE)
+    return nullptr;
+
+  uint8_t* ret = nullptr;
+  LARGE_INTEGER size;
+  if (::GetFileSizeEx(file, &size) && size.QuadPart >= GmDls::kGmDlsFileSize)
+  {
+    HANDLE mapping = ::CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping)
+    {
+      ret = (uint8_t*)::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      // the view keeps the mapping alive.
+      ::CloseHandle(mapping);
+    }
   }
-  DWORD bytesRead;
-  (void)ReadFile(file, gpData, kGmDlsFileSize, &bytesRead, NULL);
   ::CloseHandle(file);
+  return ret;
 }
-
-#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
-bool GmDls::TryGetLoopConfig(int sampleIndex, int& sampleLength, int& loopStart, int& loopLength)
+  #else
+uint8_t* MapBank()
 {
-  if (sampleIndex < 0 || sampleIndex >= kGmDlsSampleCount)
+  std::string path = gBankPath;
+  if (path.empty())
   {
-    sampleLength = 0;
-    loopStart = 0;
-    loopLength = 0;
-    return false;
+    const char* env = std::getenv("WAVESABRE_GMDLS_PATH");
+    if (!env)
+      return nullptr;
+    path = env;
+  }
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return nullptr;
+  uint8_t* ret = nullptr;
+  struct stat st;
+  if (::fstat(fd, &st) == 0 && st.st_size >= GmDls::kGmDlsFileSize)
+  {
+    void* p = ::mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (p != MAP_FAILED)
+      ret = (uint8_t*)p;
   }
+  ::close(fd);
+  return ret;
+}
+  #endif  // _WIN32
 
-  auto ptr = gpData + kWaveListOffset;
-  for (int i = 0; i <= sampleIndex; i++)
+// walks the wave pool once. each entry is LIST 'wave' { fmt, wsmp, data, LIST INFO { ICOP, INAM } }.
+void BuildIndex(const uint8_t* data)
+{
+  auto ptr = data + GmDls::kWaveListOffset;
+  for (int i = 0; i < GmDls::kGmDlsSampleCount; i++)
   {
+    auto& info = gSampleIndex[i];
+    ptr += 4;  // 'LIST'
+    const auto waveListSize = ReadU32(ptr);
     ptr += 4;
-    auto waveListSize = *((unsigned int*)ptr);
-    ptr += 4;
+    const auto waveListEnd = ptr + waveListSize;
 
-    if (i != sampleIndex)
-    {
-      ptr += waveListSize;
-      continue;
-    }
-
-    auto wave = ptr + 4;
-    auto fmtSize = *((unsigned int*)(wave + 4));
-    wave += fmtSize + 8;
+    auto wave = ptr + 4;  // 'wave'
+    // fmt : wFormatTag, nChannels, nSamplesPerSec, ...
+    info.mSampleRate = (int)ReadU32(wave + 8 + 4);
+    wave += ReadU32(wave + 4) + 8;
 
-    WaveSabreCore::Wsmp wsmp;
+    // wsmp : cbSize, usUnityNote, sFineTune, lAttenuation, fulOptions, cSampleLoops, loops...
+    info.mUnityNote = ReadU16(wave + 8 + 4);
+    Wsmp wsmp;
     memcpy(&wsmp, wave, sizeof(wsmp));
-    auto wsmpSize = *((unsigned int*)(wave + 4));
-    wave += wsmpSize + 8;
+    wave += ReadU32(wave + 4) + 8;
 
-    wave += 4;
-    auto dataChunkSize = *((unsigned int*)wave);
-    sampleLength = int(dataChunkSize / 2);
+    // data
+    const auto dataChunkSize = ReadU32(wave + 4);
+    wave += 8;
+    info.mDataOffset = (uint32_t)(wave - data);
+    info.mSampleLength = int(dataChunkSize / 2);
+    wave += dataChunkSize;
 
     if (wsmp.loopCount)
     {
-      loopStart = wsmp.loopStart;
-      loopLength = wsmp.loopLength;
+      info.mLoopStart = wsmp.loopStart;
+      info.mLoopLength = wsmp.loopLength;
     }
     else
     {
-      loopStart = 0;
-      loopLength = sampleLength;
+      info.mLoopStart = 0;
+      info.mLoopLength = info.mSampleLength;
+    }
+
+    // LIST 'INFO' sub-chunks are word-aligned.
+    if (wave + 12 <= waveListEnd)
+    {
+      auto sub = wave + 12;
+      const auto infoEnd = sub - 4 + ReadU32(wave + 4);
+      while (sub + 8 <= infoEnd)
+      {
+        const auto size = ReadU32(sub + 4);
+        if (memcmp(sub, "INAM", 4) == 0)
+        {
+          info.mpName = (const char*)(sub + 8);
+          break;
+        }
+        sub += 8 + size + (size & 1);
+      }
     }
-    return true;
-  }
 
-  sampleLength = 0;
-  loopStart = 0;
-  loopLength = 0;
-  return false;
+    ptr = waveListEnd;
+  }
 }
-#endif
 
-void GmDlsSample::LoadGmDlsIndex(int sampleIndex)
+void LoadBank()
 {
-  mpSampleData = nullptr;
-  mSampleLength = 0;
-
-  if (sampleIndex < 0 || sampleIndex >= GmDls::kGmDlsSampleCount)
+  GmDls::gpData = MapBank();
+  gBankLoaded = !!GmDls::gpData;
+  if (!gBankLoaded)
+  {
+    // keep serialized offsets in range; missing bank plays silence.
+    GmDls::gpData = new uint8_t[GmDls::kGmDlsFileSize]();
     return;
+  }
+  BuildIndex(GmDls::gpData);
+}
+}  // namespace
 
-  mSampleIndex = sampleIndex;
+void GmDls::SetBankPath(const char* path)
+{
+  gBankPath = path ? path : "";
+}
 
-  // Seek to wave pool chunk's data
-  auto ptr = GmDls::gpData + GmDls::kWaveListOffset;
+bool GmDls::IsLoaded()
+{
+  EnsureInitialized();
+  return gBankLoaded;
+}
 
-  // Walk wave pool entries
-  for (int i = 0; i <= sampleIndex; i++)
-  {
-    // Walk wave list
-    //auto waveListTag = *((unsigned int*)ptr);  // Should be 'LIST'
-    ptr += 4;
-    auto waveListSize = *((unsigned int*)ptr);
-    ptr += 4;
+void GmDls::EnsureInitialized()
+{
+  static std::once_flag sOnce;
+  std::call_once(sOnce, LoadBank);
+}
 
-    // Skip entries until we've reached the index we're looking for
-    if (i != sampleIndex)
-    {
-      ptr += waveListSize;
-      continue;
-    }
+const GmDls::SampleInfo* GmDls::GetSampleInfo(int sampleIndex)
+{
+  EnsureInitialized();
+  if (sampleIndex < 0 || sampleIndex >= kGmDlsSampleCount || !gBankLoaded)
+    return nullptr;
+  return &gSampleIndex[sampleIndex];
+}
 
-    // Walk wave entry
-    auto wave = ptr;
-    //auto waveTag = *((unsigned int*)wave);  // Should be 'wave'
-    wave += 4;
+bool GmDls::TryGetLoopConfig(int sampleIndex, int& sampleLength, int& loopStart, int& loopLength)
+{
+  auto* info = GetSampleInfo(sampleIndex);
+  if (!info)
+  {
+    sampleLength = 0;
+    loopStart = 0;
+    loopLength = 0;
+    return false;
+  }
+  sampleLength = info->mSampleLength;
+  loopStart = info->mLoopStart;
+  loopLength = info->mLoopLength;
+  return true;
+}
 
-    auto fmtSize = *((unsigned int*)(wave + 4));
-    wave += fmtSize + 8;
+bool GmDlsSample::LoadGmDlsIndex(int sampleIndex)
+{
+  auto* info = GmDls::GetSampleInfo(sampleIndex);
+  if (!info)
+    return false;
 
-    auto wsmpSize = *((unsigned int*)(wave + 4));
-    wave += wsmpSize + 8;
+  mSampleIndex = sampleIndex;
+  mpSampleData = (const int16_t*)(GmDls::gpData + info->mDataOffset);
+  mSampleLength = info->mSampleLength;
+  return true;
+}
 
-    // Read data chunk
-    //auto dataChunkTag = *((unsigned int*)wave);  // Should be 'data'
-    wave += 4;
-    auto dataChunkSize = *((unsigned int*)wave);
-    wave += 4;
+#else  // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
-    mpSampleData = (const int16_t*)wave;
-    mSampleLength = int(dataChunkSize / 2);
+void GmDls::EnsureInitialized()
+{
+  if (gpData)
     return;
+  static const char* gmDlsPaths[2] = {
+      "drivers/gm.dls",      //
+      "drivers/etc/gm.dls",  //
+  };
+  gpData = new uint8_t[kGmDlsFileSize];
+#pragma message("GmDls Leaking memory to save bits.")
+
+  // NB: can't use fopen or CreateFile, because they don't resolve the relative paths above.
+  HANDLE file = INVALID_HANDLE_VALUE;
+  for (int i = 0; file == INVALID_HANDLE_VALUE; i++)
+  {
+    OFSTRUCT reOpenBuff;
+    file = (HANDLE)(UINT_PTR)OpenFile(gmDlsPaths[i], &reOpenBuff, OF_READ);
   }
+  DWORD bytesRead;
+  (void)ReadFile(file, gpData, kGmDlsFileSize, &bytesRead, NULL);
+  ::CloseHandle(file);
 }
 
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
+
 float GmDlsSample::GetSampleAt(int sampleOffset) const
 {
   if (sampleOffset < 0 || sampleOffset >= mSampleLength)
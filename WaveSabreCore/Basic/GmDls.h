@@ -14,6 +14,25 @@ struct GmDls
   static uint8_t *gpData;
   static void EnsureInitialized();
 #ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+  // one entry per wave pool sample, built once when the bank is loaded.
+  struct SampleInfo
+  {
+    uint32_t mDataOffset = 0;  // byte offset of the 16-bit sample data from gpData
+    int mSampleLength = 0;
+    int mLoopStart = 0;
+    int mLoopLength = 0;
+    int mSampleRate = 0;
+    int mUnityNote = 60;
+    const char* mpName = "";  // points into the bank
+  };
+
+  // overrides where the bank is loaded from; call before the first device is created.
+  // on windows the default is the system gm.dls; elsewhere there is no default and this
+  // (or the WAVESABRE_GMDLS_PATH environment variable) is required.
+  static void SetBankPath(const char* path);
+  // false if the bank couldn't be loaded; gpData then points to silence so offsets stay valid.
+  static bool IsLoaded();
+  static const SampleInfo* GetSampleInfo(int sampleIndex);
   static bool TryGetLoopConfig(int sampleIndex, int& sampleLength, int& loopStart, int& loopLength);
 #endif
 
@@ -26,7 +45,10 @@ struct GmDlsSample
   const int16_t*mpSampleData = nullptr;
   int mSampleLength = 0;
 
-  void LoadGmDlsIndex(int index);
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+  // false (and nothing changed) if there's no such sample, or no bank loaded.
+  bool LoadGmDlsIndex(int index);
+#endif
   float GetSampleAt(int sampleOffset) const;
 };
 
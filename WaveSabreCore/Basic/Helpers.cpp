@@ -17,22 +17,10 @@ namespace cc
 namespace WaveSabreCore
 {
 #ifndef MIN_SIZE_REL
-	int Helpers::CurrentSampleRateI = 44100;
-	double Helpers::CurrentSampleRate = 44100.0;
-	float Helpers::CurrentSampleRateF = 44100.0f;
-	float Helpers::CurrentSampleRateRecipF = 1.0f/44100.0f;
-	float Helpers::NyquistHz = 22050.0f;
-
 	void Helpers::SetSampleRate(int sampleRate)
 	{
-		CurrentSampleRateI = sampleRate;
-		CurrentSampleRate = static_cast<double>(sampleRate);
-		CurrentSampleRateF = static_cast<float>(sampleRate);
-		CurrentSampleRateRecipF = 1.0f / static_cast<float>(sampleRate);
-		NyquistHz = CurrentSampleRateF * 0.5f;
+		RenderContext::SetDefault(sampleRate, RenderContext::GetDefault().mTempo);
 	}
-
-	int Helpers::CurrentTempo = 120;
 #endif  // MIN_SIZE_REL
 }
 
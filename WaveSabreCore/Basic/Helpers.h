@@ -4,6 +4,8 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 
+#include "RenderContext.hpp"
+
 #ifdef _DEBUG
 #include <Windows.h>
 #include <string>
@@ -49,24 +51,26 @@ namespace cc
 
 namespace WaveSabreCore
 {
+	// shorthand for the bound RenderContext. in size builds these are constants.
 	class Helpers
 	{
 	public:
 #ifdef MIN_SIZE_REL
-    static constexpr int CurrentSampleRateI = 44100;
-    static constexpr float CurrentSampleRateF = CurrentSampleRateI;
-    static constexpr double CurrentSampleRate = CurrentSampleRateI;
-    static constexpr float CurrentSampleRateRecipF = 1.0f / CurrentSampleRateF;
-	static constexpr float NyquistHz = CurrentSampleRateF * 0.5f;
-	static constexpr int CurrentTempo = 120;
+	static constexpr int CurrentSampleRateI() { return RenderContext::mSampleRateI; }
+	static constexpr float CurrentSampleRateF() { return RenderContext::mSampleRateF; }
+	static constexpr double CurrentSampleRate() { return RenderContext::mSampleRate; }
+	static constexpr float CurrentSampleRateRecipF() { return RenderContext::mSampleRateRecipF; }
+	static constexpr float NyquistHz() { return RenderContext::mNyquistHz; }
+	static constexpr int CurrentTempo() { return RenderContext::mTempo; }
 #else
-    static int CurrentSampleRateI;
-    static double CurrentSampleRate;
-    static float CurrentSampleRateF;
-    static float CurrentSampleRateRecipF;
-	static float NyquistHz;
+	static int CurrentSampleRateI() { return RenderContext::Current().mSampleRateI; }
+	static float CurrentSampleRateF() { return RenderContext::Current().mSampleRateF; }
+	static double CurrentSampleRate() { return RenderContext::Current().mSampleRate; }
+	static float CurrentSampleRateRecipF() { return RenderContext::Current().mSampleRateRecipF; }
+	static float NyquistHz() { return RenderContext::Current().mNyquistHz; }
+	static int CurrentTempo() { return RenderContext::Current().mTempo; }
+	// sets the default context's rate; renderers with their own context aren't affected.
 	static void SetSampleRate(int sampleRate);
-	static int CurrentTempo;
 #endif  // MIN_SIZE_REL
 
 
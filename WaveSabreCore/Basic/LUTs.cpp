@@ -1,6 +1,13 @@
 
 #include "LUTs.hpp"
 
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+  #include <atomic>
+  #include <chrono>
+  #include <mutex>
+  #include <thread>
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
+
 namespace WaveSabreCore
 {
 namespace M7
@@ -225,6 +232,74 @@ float bilerp(float f00, float f10, float f01, float f11, float tx, float ty)
 // everything must use gigasynth so we init from there.
 LUTs* gLuts = nullptr;
 
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+namespace
+{
+double gLUTInitMilliseconds = 0;
+
+  #ifdef USE_INLINE_LUTS
+// rows are handed out one at a time; the curve cost varies a lot with k so static partitioning balances poorly.
+void FillCurveLUTParallel(CurveLUT& lut)
+{
+  std::atomic<size_t> nextRow{0};
+  auto worker = [&]()
+  {
+    for (size_t y = nextRow++; y < gLutSize2D; y = nextRow++)
+    {
+      lut.FillRows(y, y + 1);
+    }
+  };
+
+  unsigned threadCount = std::thread::hardware_concurrency();
+  threadCount = (threadCount < 1) ? 1 : ((threadCount > 16) ? 16 : threadCount);
+  std::thread threads[16];
+  for (unsigned i = 1; i < threadCount; ++i)
+  {
+    threads[i] = std::thread(worker);
+  }
+  worker();
+  for (unsigned i = 1; i < threadCount; ++i)
+  {
+    threads[i].join();
+  }
+}
+  #endif  // USE_INLINE_LUTS
+}  // namespace
+
+void EnsureLUTsInitialized()
+{
+  static std::once_flag sOnce;
+  std::call_once(sOnce,
+                 []()
+                 {
+                   const auto start = std::chrono::steady_clock::now();
+                   auto* luts = new LUTs();
+  #ifdef USE_INLINE_LUTS
+                   FillCurveLUTParallel(luts->gCurveLUT);
+  #endif  // USE_INLINE_LUTS
+                   gLuts = luts;
+                   gLUTInitMilliseconds =
+                       std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                 });
+}
+
+double GetLUTInitMilliseconds()
+{
+  return gLUTInitMilliseconds;
+}
+
+#else
+
+void EnsureLUTsInitialized()
+{
+  if (!gLuts)
+  {
+    gLuts = new LUTs();
+  }
+}
+
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
+
 
 }  // namespace math
 
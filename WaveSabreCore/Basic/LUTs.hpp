@@ -40,7 +40,8 @@ struct LUT01
   virtual float Invoke(float x) const;
 };
 
-struct SinCosLUT : public LUT01
+// final so calls through gLuts bind directly instead of through the vtable.
+struct SinCosLUT final : public LUT01
 {
   SinCosLUT(/*size_t nSamples,*/ float (*fn)(float));
 
@@ -48,7 +49,7 @@ struct SinCosLUT : public LUT01
 };
 
 // tanh approaches -1 before -PI, and +1 after +PI. so squish the range and do a 0,1 LUT mapping from -PI,PI
-struct TanHLUT : public LUT01
+struct TanHLUT final : public LUT01
 {
   TanHLUT(/*size_t nSamples*/);
   virtual float Invoke(float x) const override;
@@ -70,7 +71,7 @@ struct LUT2D
   virtual float Invoke(float x, float y) const;
 };
 
-struct CurveLUT : public LUT2D
+struct CurveLUT final : public LUT2D
 {
   // valid for 0<k<1 and 0<x<1
   static real_t modCurve_x01_k01_RT(real_t x, real_t k);
@@ -88,7 +89,7 @@ struct CurveLUT : public LUT2D
 
 // pow(2,n) is a quite hot path, used by MidiNoteToFrequency(), as well as all other frequency calculations.
 // the range of `n` is [-15,+15] but depends on frequency param scale. so let's extend a bit and make a huge lut.
-struct Pow2_N16_16_LUT : public LUT01
+struct Pow2_N16_16_LUT final : public LUT01
 {
   Pow2_N16_16_LUT(/*size_t nSamples*/);
   virtual float Invoke(float x) const override;
@@ -269,10 +270,18 @@ struct CurveLUT  // : public LUT2D
   float mpTable[gLutSize2D * gLutSize2D];
 
   // incoming values should support -1,1 and output -1,1
+  // 262k evaluations is the bulk of LUT startup time, so in non-size-optimized builds the table is
+  // left for EnsureLUTsInitialized() to fill across threads.
   INLINE CurveLUT()
   {
-    // Populate table.
-    for (size_t y = 0; y < gLutSize2D; ++y)
+#ifndef SELECTABLE_OUTPUT_STREAM_SUPPORT
+    FillRows(0, gLutSize2D);
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
+  }
+
+  INLINE void FillRows(size_t yBegin, size_t yEnd)
+  {
+    for (size_t y = yBegin; y < yEnd; ++y)
     {
       for (size_t x = 0; x < gLutSize2D; ++x)
       {
@@ -337,6 +346,15 @@ struct LUTs
 
 extern LUTs* gLuts;
 
+// creates gLuts on first call. thread-safe in non-size-optimized builds, where the 2D table is
+// also filled in parallel.
+void EnsureLUTsInitialized();
+
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+// wall time of the LUT build, for startup profiling. 0 until built.
+double GetLUTInitMilliseconds();
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
+
 }  // namespace math
 
 
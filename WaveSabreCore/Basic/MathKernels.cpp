@@ -0,0 +1,208 @@
+#include "MathKernels.hpp"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+  #define WAVESABRE_MATHKERNELS_SSE
+  #include <emmintrin.h>
+#endif
+
+namespace WaveSabreCore
+{
+namespace M7
+{
+namespace math
+{
+namespace
+{
+// same constants the scalar Invoke()s use, so the index math rounds identically.
+constexpr float kSinPeriodCorrection = 1 / gPITimes2;
+constexpr float kTanhScale = 1.0f / gPITimes2;
+constexpr float kPow2Scale = 1.0f / 32;
+
+#ifdef WAVESABRE_MATHKERNELS_SSE
+
+// truncation-based floor (like the custom CRT's); values past 2^23 are already integral.
+inline __m128 Floor4(__m128 x)
+{
+  const __m128 one = _mm_set1_ps(1.0f);
+  __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+  t = _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, x), one));
+  const __m128 absX = _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+  const __m128 big = _mm_cmpge_ps(absX, _mm_set1_ps(8388608.0f));
+  return _mm_or_ps(_mm_and_ps(big, x), _mm_andnot_ps(big, t));
+}
+
+// LookupLUT1D() for 4 values. clamping x to [0,1] and the lower index to N-2 reproduces the
+// scalar edge cases exactly (t becomes 0 or 1).
+inline __m128 Lookup1D4(const float* table, __m128 x)
+{
+  const __m128 one = _mm_set1_ps(1.0f);
+  x = _mm_max_ps(_mm_min_ps(x, one), _mm_setzero_ps());
+  const __m128 index = _mm_mul_ps(x, _mm_set1_ps(float(gLutSize1D - 1)));
+  const __m128 lower = _mm_min_ps(_mm_cvtepi32_ps(_mm_cvttps_epi32(index)), _mm_set1_ps(float(gLutSize1D - 2)));
+  const __m128 t = _mm_sub_ps(index, lower);
+
+  alignas(16) int i[4];
+  _mm_store_si128((__m128i*)i, _mm_cvttps_epi32(lower));
+  const __m128 a = _mm_setr_ps(table[i[0]], table[i[1]], table[i[2]], table[i[3]]);
+  const __m128 b = _mm_setr_ps(table[i[0] + 1], table[i[1] + 1], table[i[2] + 1], table[i[3] + 1]);
+  return _mm_add_ps(_mm_mul_ps(_mm_sub_ps(one, t), a), _mm_mul_ps(t, b));
+}
+
+inline __m128 Lerp4(__m128 a, __m128 b, __m128 t)
+{
+  return _mm_add_ps(_mm_mul_ps(a, _mm_sub_ps(_mm_set1_ps(1.0f), t)), _mm_mul_ps(b, t));
+}
+
+// LookupLUT2D() for 4 values, inputs already mapped to 0-1.
+inline __m128 Lookup2D4(const float* table, __m128 x, __m128 y)
+{
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 almostOne = _mm_set1_ps(0.9999f);
+  x = _mm_max_ps(x, _mm_setzero_ps());
+  y = _mm_max_ps(y, _mm_setzero_ps());
+  __m128 m = _mm_cmpge_ps(x, one);
+  x = _mm_or_ps(_mm_and_ps(m, almostOne), _mm_andnot_ps(m, x));
+  m = _mm_cmpge_ps(y, one);
+  y = _mm_or_ps(_mm_and_ps(m, almostOne), _mm_andnot_ps(m, y));
+
+  const __m128 scale = _mm_set1_ps(float(gLutSize2D - 1));
+  const __m128 indexX = _mm_mul_ps(x, scale);
+  const __m128 indexY = _mm_mul_ps(y, scale);
+  const __m128i lowerX = _mm_cvttps_epi32(indexX);
+  const __m128i lowerY = _mm_cvttps_epi32(indexY);
+  const __m128 tx = _mm_sub_ps(indexX, _mm_cvtepi32_ps(lowerX));
+  const __m128 ty = _mm_sub_ps(indexY, _mm_cvtepi32_ps(lowerY));
+
+  // row * 512 + col
+  static_assert(gLutSize2D == 512, "");
+  alignas(16) int i[4];
+  _mm_store_si128((__m128i*)i, _mm_add_epi32(_mm_slli_epi32(lowerY, 9), lowerX));
+  const __m128 f00 = _mm_setr_ps(table[i[0]], table[i[1]], table[i[2]], table[i[3]]);
+  const __m128 f10 = _mm_setr_ps(table[i[0] + 1], table[i[1] + 1], table[i[2] + 1], table[i[3] + 1]);
+  const __m128 f01 = _mm_setr_ps(
+      table[i[0] + gLutSize2D], table[i[1] + gLutSize2D], table[i[2] + gLutSize2D], table[i[3] + gLutSize2D]);
+  const __m128 f11 = _mm_setr_ps(table[i[0] + gLutSize2D + 1],
+                                 table[i[1] + gLutSize2D + 1],
+                                 table[i[2] + gLutSize2D + 1],
+                                 table[i[3] + gLutSize2D + 1]);
+  return Lerp4(Lerp4(f00, f10, tx), Lerp4(f01, f11, tx), ty);
+}
+
+inline __m128 MapN11To01(__m128 x)
+{
+  const __m128 half = _mm_set1_ps(0.5f);
+  return _mm_add_ps(_mm_mul_ps(x, half), half);
+}
+
+inline void Periodic_n(const float* table, const float* in, float* out, int n)
+{
+  const __m128 correction = _mm_set1_ps(kSinPeriodCorrection);
+  for (int i = 0; i + 4 <= n; i += 4)
+  {
+    const __m128 s = _mm_mul_ps(_mm_loadu_ps(in + i), correction);
+    _mm_storeu_ps(out + i, Lookup1D4(table, _mm_sub_ps(s, Floor4(s))));
+  }
+}
+
+inline void Scaled_n(const float* table, float scale, const float* in, float* out, int n)
+{
+  const __m128 s = _mm_set1_ps(scale);
+  const __m128 half = _mm_set1_ps(0.5f);
+  for (int i = 0; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_ps(out + i, Lookup1D4(table, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(in + i), s), half)));
+  }
+}
+
+#endif  // WAVESABRE_MATHKERNELS_SSE
+
+// number of elements the vector loop covered; the rest go through the scalar functions.
+inline int VectorCount(int n)
+{
+#ifdef WAVESABRE_MATHKERNELS_SSE
+  return n & ~3;
+#else
+  return 0;
+#endif  // WAVESABRE_MATHKERNELS_SSE
+}
+}  // namespace
+
+void sin_n(const float* in, float* out, int n)
+{
+#ifdef WAVESABRE_MATHKERNELS_SSE
+  Periodic_n(gLuts->gSinLUT.mpTable, in, out, n);
+#endif  // WAVESABRE_MATHKERNELS_SSE
+  for (int i = VectorCount(n); i < n; ++i)
+  {
+    out[i] = math::sin(in[i]);
+  }
+}
+
+void cos_n(const float* in, float* out, int n)
+{
+#ifdef WAVESABRE_MATHKERNELS_SSE
+  Periodic_n(gLuts->gCosLUT.mpTable, in, out, n);
+#endif  // WAVESABRE_MATHKERNELS_SSE
+  for (int i = VectorCount(n); i < n; ++i)
+  {
+    out[i] = math::cos(in[i]);
+  }
+}
+
+void tanh_n(const float* in, float* out, int n)
+{
+#ifdef WAVESABRE_MATHKERNELS_SSE
+  Scaled_n(gLuts->gTanhLUT.mpTable, kTanhScale, in, out, n);
+#endif  // WAVESABRE_MATHKERNELS_SSE
+  for (int i = VectorCount(n); i < n; ++i)
+  {
+    out[i] = math::tanh(in[i]);
+  }
+}
+
+void pow2_n(const float* in, float* out, int n)
+{
+#ifdef WAVESABRE_MATHKERNELS_SSE
+  Scaled_n(gLuts->gPow2_N16_16_LUT.mpTable, kPow2Scale, in, out, n);
+#endif  // WAVESABRE_MATHKERNELS_SSE
+  for (int i = VectorCount(n); i < n; ++i)
+  {
+    out[i] = math::pow2_N16_16(in[i]);
+  }
+}
+
+void curve_n(const float* xN11, const float* kN11, float* out, int n)
+{
+#ifdef WAVESABRE_MATHKERNELS_SSE
+  const float* table = gLuts->gCurveLUT.mpTable;
+  for (int i = 0; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_ps(out + i,
+                  Lookup2D4(table, MapN11To01(_mm_loadu_ps(xN11 + i)), MapN11To01(_mm_loadu_ps(kN11 + i))));
+  }
+#endif  // WAVESABRE_MATHKERNELS_SSE
+  for (int i = VectorCount(n); i < n; ++i)
+  {
+    out[i] = math::modCurve_xN11_kN11(xN11[i], kN11[i]);
+  }
+}
+
+void curve_n(const float* xN11, float kN11, float* out, int n)
+{
+#ifdef WAVESABRE_MATHKERNELS_SSE
+  const float* table = gLuts->gCurveLUT.mpTable;
+  const __m128 k01 = MapN11To01(_mm_set1_ps(kN11));
+  for (int i = 0; i + 4 <= n; i += 4)
+  {
+    _mm_storeu_ps(out + i, Lookup2D4(table, MapN11To01(_mm_loadu_ps(xN11 + i)), k01));
+  }
+#endif  // WAVESABRE_MATHKERNELS_SSE
+  for (int i = VectorCount(n); i < n; ++i)
+  {
+    out[i] = math::modCurve_xN11_kN11(xN11[i], kN11);
+  }
+}
+
+}  // namespace math
+}  // namespace M7
+}  // namespace WaveSabreCore
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Math.hpp"
+
+namespace WaveSabreCore
+{
+namespace M7
+{
+namespace math
+{
+// array versions of the LUT functions in Math.hpp. they read the same tables with the same
+// interpolation, so results match the scalar calls (math::sin, math::tanh, ...) sample for sample;
+// index math runs 4-wide and the table reads are plain loads, so there's no per-call dispatch or
+// branch for callers that have a whole buffer to convert.
+//
+// in and out may alias.
+void sin_n(const float* in, float* out, int n);
+void cos_n(const float* in, float* out, int n);
+void tanh_n(const float* in, float* out, int n);
+// pow(2, x) for x in [-16, 16]; same as pow2_N16_16().
+void pow2_n(const float* in, float* out, int n);
+// modCurve_xN11_kN11() per element.
+void curve_n(const float* xN11, const float* kN11, float* out, int n);
+// modCurve_xN11_kN11() with a fixed curve; the common case of one param curving a buffer.
+void curve_n(const float* xN11, float kN11, float* out, int n);
+
+}  // namespace math
+}  // namespace M7
+}  // namespace WaveSabreCore
@@ -1,5 +1,6 @@
 
 #include "PodVector.hpp"
+#include "Arena.hpp"
 
 #include <cstring>
 #include <stdlib.h>
@@ -14,7 +15,11 @@ PodBuffer::PodBuffer(size_t elementSize)
 
 PodBuffer::~PodBuffer()
 {
+#ifdef MIN_SIZE_REL
   ::free(mData);
+#else
+  ArenaFree(mData);
+#endif  // MIN_SIZE_REL
 }
 
 PodBuffer& PodBuffer::operator=(const PodBuffer& other) noexcept
@@ -26,11 +31,20 @@ PodBuffer& PodBuffer::operator=(const PodBuffer& other) noexcept
 
 void PodBuffer::allocate(size_t newCapacityElements)
 {
+#ifdef MIN_SIZE_REL
   //auto newData = (uint8_t*)::malloc(newCapacityElements * mElementSize);
   auto newData = (uint8_t*)::calloc(newCapacityElements, mElementSize);  // zero-initialize, unconditionally. byte savings.
   //::memset(newData, 0, newCapacityElements * mElementSize);  // zero-initialize, unconditionally. byte savings.
   ::memcpy(newData, mData, mSizeElements * mElementSize);
   ::free(mData);
+#else
+  // buffers land in a bound Arena with the rest of their device.
+  ArenaSubsystemScope subsystemScope{MemorySubsystem::Buffers};
+  auto newData = (uint8_t*)ArenaAllocate(newCapacityElements * mElementSize, 16);
+  ::memset(newData, 0, newCapacityElements * mElementSize);
+  ::memcpy(newData, mData, mSizeElements * mElementSize);
+  ArenaFree(mData);
+#endif  // MIN_SIZE_REL
   mData = newData;
   mCapacityElements = newCapacityElements;
 }
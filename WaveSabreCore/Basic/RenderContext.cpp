@@ -0,0 +1,48 @@
+#include "RenderContext.hpp"
+#include "LUTs.hpp"
+#include "GmDls.h"
+
+namespace WaveSabreCore
+{
+#ifndef MIN_SIZE_REL
+
+thread_local const RenderContext* RenderContext::tpCurrent = nullptr;
+
+RenderContext::RenderContext(int sampleRate, int tempo)
+{
+  GmDls::EnsureInitialized();
+  M7::math::EnsureLUTsInitialized();
+  SetRates(sampleRate, tempo);
+}
+
+void RenderContext::SetRates(int sampleRate, int tempo)
+{
+  mSampleRateI = sampleRate;
+  mSampleRate = static_cast<double>(sampleRate);
+  mSampleRateF = static_cast<float>(sampleRate);
+  mSampleRateRecipF = 1.0f / static_cast<float>(sampleRate);
+  mNyquistHz = mSampleRateF * 0.5f;
+  mTempo = tempo;
+}
+
+namespace
+{
+RenderContext& DefaultContext()
+{
+  static RenderContext sDefault{44100, 120};
+  return sDefault;
+}
+}  // namespace
+
+const RenderContext& RenderContext::GetDefault()
+{
+  return DefaultContext();
+}
+
+void RenderContext::SetDefault(int sampleRate, int tempo)
+{
+  DefaultContext().SetRates(sampleRate, tempo);
+}
+
+#endif  // MIN_SIZE_REL
+}  // namespace WaveSabreCore
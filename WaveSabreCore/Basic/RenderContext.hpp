@@ -0,0 +1,82 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace WaveSabreCore
+{
+#ifdef MIN_SIZE_REL
+
+// size builds render one song at one fixed rate; everything folds to constants and there is nothing
+// to bind. same member names as the full version so code can read RenderContext::Current() either way.
+struct RenderContext
+{
+  static constexpr int mSampleRateI = 44100;
+  static constexpr double mSampleRate = mSampleRateI;
+  static constexpr float mSampleRateF = (float)mSampleRateI;
+  static constexpr float mSampleRateRecipF = 1.0f / mSampleRateF;
+  static constexpr float mNyquistHz = mSampleRateF * 0.5f;
+  static constexpr int mTempo = 120;
+
+  static constexpr RenderContext Current()
+  {
+    return {};
+  }
+};
+
+#else
+
+// everything rate- and tempo-dependent that rendering reads.
+// a renderer owns one and binds it (Scope) on every thread it constructs or renders devices on, so
+// renderers in the same process can run at different rates / tempos concurrently. devices read
+// Current() whenever they need a rate, so whatever is bound at the time is what they get.
+// the tables (LUTs, gm.dls) are built once per process and shared; they're read-only after that.
+struct RenderContext
+{
+  // builds the shared tables if they don't exist yet.
+  RenderContext(int sampleRate, int tempo);
+
+  int mSampleRateI;
+  double mSampleRate;
+  float mSampleRateF;
+  float mSampleRateRecipF;
+  float mNyquistHz;
+  int mTempo;
+
+  // the context bound on this thread, otherwise the process default.
+  static const RenderContext& Current()
+  {
+    return tpCurrent ? *tpCurrent : GetDefault();
+  }
+
+  // used where nothing is bound (plugins, editors, tests). it's the only mutable context;
+  // SetDefault() is what the old process-wide SetSampleRate / SetTempo did.
+  static const RenderContext& GetDefault();
+  static void SetDefault(int sampleRate, int tempo);
+
+  class Scope
+  {
+  public:
+    explicit Scope(const RenderContext& context) : mpPrevious(tpCurrent)
+    {
+      tpCurrent = &context;
+    }
+    ~Scope()
+    {
+      tpCurrent = mpPrevious;
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    const RenderContext* mpPrevious;
+  };
+
+private:
+  void SetRates(int sampleRate, int tempo);
+
+  static thread_local const RenderContext* tpCurrent;
+};
+
+#endif  // MIN_SIZE_REL
+
+}  // namespace WaveSabreCore
@@ -35,7 +35,8 @@ struct Deserializer
 {
   const uint8_t* mpData;
   const uint8_t* mpCursor;
-  //const uint8_t* mpEnd;
+  // optional; where the data ends, for readers that accept data from older layouts (device chunks).
+  const uint8_t* mpEnd = nullptr;
   //size_t mSize;
   explicit Deserializer(const uint8_t* p);
   //int8_t ReadSByte() {
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+#ifdef _WIN32
+  #include <Windows.h>
+  #pragma comment(lib, "Synchronization.lib")  // WaitOnAddress; only imported if used
+#else
+  #include <errno.h>
+  #include <pthread.h>
+  #include <sched.h>
+  #include <time.h>
+  #ifdef __linux__
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+  #endif  // __linux__
+#endif    // _WIN32
+
+// threads, events, futex-style waits and sleeping, with Win32 and POSIX backends.
+// the Win32 backend is each wrapper inlined to the one API call it stands for, so code that used the
+// API directly compiles to the same thing (MinSizeRel doesn't grow). the POSIX backend exists so the
+// renderer can run under Linux tooling (perf, TSan); its events are a mutex + condition variable.
+namespace WaveSabreCore
+{
+// thread procs are declared as `static ThreadResult WS_THREADAPI Proc(void* param)` and return 0.
+#ifdef _WIN32
+using ThreadResult = DWORD;
+  #define WS_THREADAPI WINAPI
+#else
+using ThreadResult = void*;
+  #define WS_THREADAPI
+#endif  // _WIN32
+using ThreadProc = ThreadResult(WS_THREADAPI*)(void*);
+
+// hints only; values are the Win32 ones. ignored on POSIX: raising a thread there means realtime
+// scheduling or a negative nice, both privileged, and a realtime worker spinning on a graph can starve
+// the rest of the machine. tooling runs want default scheduling anyway.
+enum class ThreadPriority : int
+{
+  Normal = 0,
+  AboveNormal = 1,
+  Highest = 2,
+  TimeCritical = 15,
+};
+
+class Thread
+{
+public:
+  // false if the thread couldn't be created.
+  bool Start(ThreadProc proc, void* param)
+  {
+#ifdef _WIN32
+    mHandle = ::CreateThread(0, 0, proc, param, 0, 0);
+    return !!mHandle;
+#else
+    mStarted = !::pthread_create(&mHandle, nullptr, proc, param);
+    return mStarted;
+#endif  // _WIN32
+  }
+
+  void SetPriority(ThreadPriority priority)
+  {
+#ifdef _WIN32
+    ::SetThreadPriority(mHandle, (int)priority);
+#else
+    (void)priority;
+#endif  // _WIN32
+  }
+
+  // waits for the thread to exit and releases it.
+  void Join()
+  {
+#ifdef _WIN32
+    ::WaitForSingleObject(mHandle, INFINITE);
+    ::CloseHandle(mHandle);
+    mHandle = 0;
+#else
+    if (mStarted)
+      ::pthread_join(mHandle, nullptr);
+    mStarted = false;
+#endif  // _WIN32
+  }
+
+  bool IsStarted() const
+  {
+#ifdef _WIN32
+    return !!mHandle;
+#else
+    return mStarted;
+#endif  // _WIN32
+  }
+
+private:
+#ifdef _WIN32
+  HANDLE mHandle = 0;
+#else
+  pthread_t mHandle{};
+  bool mStarted = false;
+#endif  // _WIN32
+};
+
+// auto-reset: a Wait() consumes the signal and releases one waiter. manual-reset: stays signalled
+// (releasing every waiter) until Reset().
+class Event
+{
+public:
+  explicit Event(bool manualReset = false)
+  {
+#ifdef _WIN32
+    mHandle = ::CreateEvent(0, manualReset, FALSE, 0);
+#else
+    ::pthread_mutex_init(&mMutex, nullptr);
+    ::pthread_cond_init(&mCond, nullptr);
+    mManualReset = manualReset;
+#endif  // _WIN32
+  }
+  ~Event()
+  {
+#ifdef _WIN32
+    ::CloseHandle(mHandle);
+#else
+    ::pthread_cond_destroy(&mCond);
+    ::pthread_mutex_destroy(&mMutex);
+#endif  // _WIN32
+  }
+  Event(const Event&) = delete;
+  Event& operator=(const Event&) = delete;
+
+  void Set()
+  {
+#ifdef _WIN32
+    ::SetEvent(mHandle);
+#else
+    ::pthread_mutex_lock(&mMutex);
+    mSignalled = true;
+    if (mManualReset)
+      ::pthread_cond_broadcast(&mCond);
+    else
+      ::pthread_cond_signal(&mCond);
+    ::pthread_mutex_unlock(&mMutex);
+#endif  // _WIN32
+  }
+
+  void Reset()
+  {
+#ifdef _WIN32
+    ::ResetEvent(mHandle);
+#else
+    ::pthread_mutex_lock(&mMutex);
+    mSignalled = false;
+    ::pthread_mutex_unlock(&mMutex);
+#endif  // _WIN32
+  }
+
+  void Wait()
+  {
+#ifdef _WIN32
+    ::WaitForSingleObject(mHandle, INFINITE);
+#else
+    ::pthread_mutex_lock(&mMutex);
+    while (!mSignalled)
+      ::pthread_cond_wait(&mCond, &mMutex);
+    if (!mManualReset)
+      mSignalled = false;
+    ::pthread_mutex_unlock(&mMutex);
+#endif  // _WIN32
+  }
+
+  // false on timeout.
+  bool Wait(uint32_t timeoutMs)
+  {
+#ifdef _WIN32
+    return ::WaitForSingleObject(mHandle, timeoutMs) == WAIT_OBJECT_0;
+#else
+    timespec deadline;
+    ::clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeoutMs / 1000;
+    deadline.tv_nsec += (long)(timeoutMs % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000)
+    {
+      deadline.tv_sec++;
+      deadline.tv_nsec -= 1000000000;
+    }
+    ::pthread_mutex_lock(&mMutex);
+    int err = 0;
+    while (!mSignalled && err != ETIMEDOUT)
+      err = ::pthread_cond_timedwait(&mCond, &mMutex, &deadline);
+    bool signalled = mSignalled;
+    if (signalled && !mManualReset)
+      mSignalled = false;
+    ::pthread_mutex_unlock(&mMutex);
+    return signalled;
+#endif  // _WIN32
+  }
+
+private:
+#ifdef _WIN32
+  HANDLE mHandle;
+#else
+  pthread_mutex_t mMutex;
+  pthread_cond_t mCond;
+  bool mSignalled = false;
+  bool mManualReset;
+#endif  // _WIN32
+};
+
+// non-recursive, for short critical sections; unlike CriticalSection it needs no init or teardown call on
+// Win32 (a slim reader/writer lock used exclusively).
+class Mutex
+{
+public:
+  class Guard
+  {
+  public:
+    explicit Guard(Mutex& mutex)
+        : mMutex(mutex)
+    {
+      mMutex.Lock();
+    }
+    ~Guard()
+    {
+      mMutex.Unlock();
+    }
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+  private:
+    Mutex& mMutex;
+  };
+
+  Mutex() = default;
+#ifndef _WIN32
+  ~Mutex()
+  {
+    ::pthread_mutex_destroy(&mMutex);
+  }
+#endif  // _WIN32
+  Mutex(const Mutex&) = delete;
+  Mutex& operator=(const Mutex&) = delete;
+
+  void Lock()
+  {
+#ifdef _WIN32
+    ::AcquireSRWLockExclusive(&mLock);
+#else
+    ::pthread_mutex_lock(&mMutex);
+#endif  // _WIN32
+  }
+
+  void Unlock()
+  {
+#ifdef _WIN32
+    ::ReleaseSRWLockExclusive(&mLock);
+#else
+    ::pthread_mutex_unlock(&mMutex);
+#endif  // _WIN32
+  }
+
+private:
+#ifdef _WIN32
+  SRWLOCK mLock = SRWLOCK_INIT;
+#else
+  pthread_mutex_t mMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif  // _WIN32
+};
+
+// futex-style: blocks while value == expected, until woken. can return spuriously, so callers re-check
+// their condition in a loop. WaitOnAddress needs Windows 8.
+inline void WaitOnValue(std::atomic<int32_t>& value, int32_t expected)
+{
+#ifdef _WIN32
+  ::WaitOnAddress(&value, &expected, sizeof(expected), INFINITE);
+#elif defined(__linux__)
+  ::syscall(SYS_futex, (int32_t*)&value, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+  if (value.load(std::memory_order_relaxed) == expected)
+    ::sched_yield();
+#endif  // _WIN32
+}
+
+inline void WakeOne(std::atomic<int32_t>& value)
+{
+#ifdef _WIN32
+  ::WakeByAddressSingle(&value);
+#elif defined(__linux__)
+  ::syscall(SYS_futex, (int32_t*)&value, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+  (void)value;
+#endif  // _WIN32
+}
+
+inline void WakeAll(std::atomic<int32_t>& value)
+{
+#ifdef _WIN32
+  ::WakeByAddressAll(&value);
+#elif defined(__linux__)
+  ::syscall(SYS_futex, (int32_t*)&value, FUTEX_WAKE_PRIVATE, 0x7fffffff, nullptr, nullptr, 0);
+#else
+  (void)value;
+#endif  // _WIN32
+}
+
+inline void SleepMilliseconds(uint32_t ms)
+{
+#ifdef _WIN32
+  ::Sleep(ms);
+#else
+  timespec t{(time_t)(ms / 1000), (long)(ms % 1000) * 1000000};
+  while (::nanosleep(&t, &t) && errno == EINTR)
+  {
+  }
+#endif  // _WIN32
+}
+
+}  // namespace WaveSabreCore
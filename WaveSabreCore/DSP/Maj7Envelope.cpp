@@ -272,6 +272,56 @@ float EnvelopeNode::ProcessSample()
   return mLastOutputLevel;
 }
 
+#ifndef MIN_SIZE_REL
+static_assert(EnvelopeNode::gMaxSegmentSamples == gModulationRecalcSampleMaskValues[0] + 1,
+              "a segment must be able to hold a whole recalc period");
+
+int EnvelopeNode::ProcessSegment(float* out, int maxSamples)
+{
+  int n = 0;
+  if (mStage != EnvelopeStage::Idle)
+  {
+    out[n++] = ProcessSample();
+  }
+  if (mStage == EnvelopeStage::Idle)
+  {
+    for (; n < maxSamples; ++n)
+    {
+      out[n] = 0;
+    }
+    return n;
+  }
+
+  // ProcessSample() runs the stage machine again when the recalc counter wraps to 0, and when the fixed delay's
+  // last sample advances to the next stage. everything before that just adds the delta.
+  int run = mnSampleCount == 0 ? 0 : (GetModulationRecalcSampleMask() + 1) - (int)mnSampleCount;
+  if (mStage == EnvelopeStage::FixedDelay && run > mFixedDelaySamplesRemaining - 1)
+  {
+    run = mFixedDelaySamplesRemaining - 1;
+  }
+  if (run > maxSamples - n)
+  {
+    run = maxSamples - n;
+  }
+
+  // accumulated rather than start + delta * i, so it's bit-identical to stepping with ProcessSample().
+  float level = mLastOutputLevel;
+  const float delta = mOutputDeltaPerSample;
+  for (int i = 0; i < run; ++i)
+  {
+    level += delta;
+    out[n + i] = level;
+  }
+  mLastOutputLevel = level;
+  mnSampleCount = (mnSampleCount + run) & GetModulationRecalcSampleMask();
+  if (mStage == EnvelopeStage::FixedDelay)
+  {
+    mFixedDelaySamplesRemaining -= run;
+  }
+  return n + run;
+}
+#endif  // !MIN_SIZE_REL
+
 // calculates stage increments per sample for times + modulations.
 void EnvelopeNode::RecalcState()
 {
@@ -9,7 +9,7 @@ namespace WaveSabreCore
 {
 namespace M7
 {
-struct EnvelopeNode
+struct EnvelopeNode : ArenaAllocated
 {
   ModMatrixNode& mModMatrix;
   ParamAccessor mParams;
@@ -63,6 +63,18 @@ struct EnvelopeNode
   void ProcessSampleFull();
   float ProcessSample();
 
+#ifndef MIN_SIZE_REL
+  // the longest run ProcessSegment() returns: one modulation recalc period at the lowest quality.
+  static constexpr int gMaxSegmentSamples = 128;
+
+  // the same output as calling ProcessSample() out.length times, but the stage machine only runs for the first
+  // sample. the run stops before the next sample that would need it (the next recalc point, or the end of the
+  // fixed delay), so stage transitions only ever land on the first sample of a segment, and the rest is the
+  // straight line ProcessSample() would have stepped along. returns the number of samples written, 1..maxSamples;
+  // an idle envelope fills all of them with 0.
+  int ProcessSegment(float* out, int maxSamples);
+#endif  // !MIN_SIZE_REL
+
 private:
   void RecalcState();
 
@@ -0,0 +1,268 @@
+#include "ModDelayCore.hpp"
+
+#include <string.h>
+
+#include "../Basic/Helpers.h"
+#include "../Basic/MathKernels.hpp"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+  #define WAVESABRE_MODDELAY_SSE
+  #include <emmintrin.h>
+#endif
+
+namespace WaveSabreCore::M7
+{
+namespace
+{
+// catmull-rom through x0 (t = 0) and x1 (t = 1).
+inline float Cubic(float xm1, float x0, float x1, float x2, float t)
+{
+  const float c1 = 0.5f * (x1 - xm1);
+  const float c2 = xm1 - 2.5f * x0 + 2 * x1 - 0.5f * x2;
+  const float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+  return ((c3 * t + c2) * t + c1) * t + x0;
+}
+
+#ifdef WAVESABRE_MODDELAY_SSE
+inline __m128 Cubic4(__m128 xm1, __m128 x0, __m128 x1, __m128 x2, __m128 t)
+{
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 c1 = _mm_mul_ps(half, _mm_sub_ps(x1, xm1));
+  const __m128 c2 = _mm_sub_ps(_mm_add_ps(xm1, _mm_add_ps(x1, x1)),
+                               _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.5f), x0), _mm_mul_ps(half, x2)));
+  const __m128 c3 = _mm_add_ps(_mm_mul_ps(half, _mm_sub_ps(x2, xm1)), _mm_mul_ps(_mm_set1_ps(1.5f), _mm_sub_ps(x0, x1)));
+  return _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(c3, t), c2), t), c1), t), x0);
+}
+
+inline float Sum4(__m128 x)
+{
+  const __m128 s = _mm_add_ps(x, _mm_movehl_ps(x, x));
+  return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+}
+#endif  // WAVESABRE_MODDELAY_SSE
+}  // namespace
+
+ModDelayCore::ModDelayCore()
+{
+  UpdateLineLength();
+}
+
+// sized for the current sample rate, and again whenever it changes (the host can switch rates after
+// construction). a resize clears the lines, like AudioBuffer::SetLengthSamples.
+void ModDelayCore::UpdateLineLength()
+{
+  const float sampleRate = Helpers::CurrentSampleRateF();
+  if (sampleRate == mLineSampleRate)
+    return;
+  mLineSampleRate = sampleRate;
+
+  // enough for the longest base delay at full depth, plus the interpolator's reach; a power of 2 so
+  // indices wrap with a mask.
+  const int needed = (int)math::MillisecondsToSamples(gMaxDelayMs * 2) + 4;
+  int size = 1;
+  while (size < needed)
+  {
+    size <<= 1;
+  }
+  for (auto& line : mLines)
+  {
+    line.resize(size);
+    memset(line.data(), 0, sizeof(float) * size);
+  }
+  mLineMask = size - 1;
+  mWriteIndex = 0;
+  mHasTargets = false;
+}
+
+void ModDelayCore::Run(const float* const* in, float* const* out, int numSamples, float dryGain, float wetGain)
+{
+  UpdateLineLength();
+  for (int offset = 0; offset < numSamples; offset += gBlockSize)
+  {
+    const int blockSize = numSamples - offset < gBlockSize ? numSamples - offset : gBlockSize;
+    BeginBlock(blockSize);
+    if (mMode == Mode::Phaser)
+    {
+      RunPhaserBlock(in, out, offset, blockSize, dryGain, wetGain);
+    }
+    else
+    {
+      RunDelayBlock(in, out, offset, blockSize, dryGain, wetGain);
+    }
+  }
+}
+
+// evaluates the LFOs at the end of the block and sets up the ramps towards them.
+void ModDelayCore::BeginBlock(int blockSize)
+{
+  const float sampleRate = Helpers::CurrentSampleRateF();
+  mPhase = math::fract(mPhase + (double)mRateHz * blockSize / sampleRate);
+
+  alignas(16) float lfo[2 * gVoiceCount];
+  for (int ch = 0; ch < 2; ++ch)
+  {
+    for (int v = 0; v < gVoiceCount; ++v)
+    {
+      const float phase = (float)mPhase + mVoiceSpread * v / mVoices + mStereoPhase * 0.5f * ch;
+      lfo[ch * gVoiceCount + v] = math::fract(phase) * math::gPITimes2;
+    }
+  }
+  math::sin_n(lfo, lfo, 2 * gVoiceCount);
+
+  alignas(16) float target[2][gVoiceCount];
+  if (mMode == Mode::Phaser)
+  {
+    for (int ch = 0; ch < 2; ++ch)
+    {
+      float hz = mCenterHz * math::pow2_N16_16(mDepth * gPhaserSweepOctaves * lfo[ch * gVoiceCount]);
+      hz = math::clamp(hz, 10.0f, sampleRate * 0.45f);
+      const float t = math::tan(math::gPI * hz / sampleRate);
+      target[ch][0] = (t - 1) / (t + 1);
+      target[ch][1] = target[ch][2] = target[ch][3] = 0;
+    }
+  }
+  else
+  {
+    const float baseDelay = mDelayMs * sampleRate / 1000;
+    const float maxDelay = float(mLineMask - 4);
+    for (int ch = 0; ch < 2; ++ch)
+    {
+      for (int v = 0; v < gVoiceCount; ++v)
+      {
+        target[ch][v] = math::clamp(baseDelay * (1 + mDepth * lfo[ch * gVoiceCount + v]), gMinDelaySamples, maxDelay);
+      }
+    }
+  }
+
+  for (int v = 0; v < gVoiceCount; ++v)
+  {
+    mVoiceGain[v] = v < mVoices ? 1.0f / mVoices : 0;
+  }
+
+  // jump straight there on the first block and when the ramps change meaning.
+  const bool snap = !mHasTargets || mRampMode != mMode;
+  mHasTargets = true;
+  mRampMode = mMode;
+  const float rampScale = 1.0f / blockSize;
+  for (int ch = 0; ch < 2; ++ch)
+  {
+    for (int v = 0; v < gVoiceCount; ++v)
+    {
+      if (snap)
+      {
+        mCurrent[ch][v] = target[ch][v];
+      }
+      mIncrement[ch][v] = (target[ch][v] - mCurrent[ch][v]) * rampScale;
+    }
+  }
+}
+
+void ModDelayCore::RunDelayBlock(const float* const* in,
+                                 float* const* out,
+                                 int offset,
+                                 int blockSize,
+                                 float dryGain,
+                                 float wetGain)
+{
+  float* lines[2] = {mLines[0].data(), mLines[1].data()};
+  const int mask = mLineMask;
+
+#ifdef WAVESABRE_MODDELAY_SSE
+  const __m128 voiceGain = _mm_load_ps(mVoiceGain);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128i maskI = _mm_set1_epi32(mask);
+#endif  // WAVESABRE_MODDELAY_SSE
+
+  for (int i = offset; i < offset + blockSize; ++i)
+  {
+    const int w = mWriteIndex;
+    for (int ch = 0; ch < 2; ++ch)
+    {
+      const float dry = in[ch][i];
+      float* line = lines[ch];
+
+      // a tap d samples back sits between x0 = line[w - floor(d) - 1] and x1 = line[w - floor(d)], at
+      // t = 1 - fract(d). splitting d keeps the fraction at full precision however long the line is.
+#ifdef WAVESABRE_MODDELAY_SSE
+      const __m128 d = _mm_load_ps(mCurrent[ch]);
+      const __m128i dInt = _mm_cvttps_epi32(d);
+      const __m128 t = _mm_sub_ps(one, _mm_sub_ps(d, _mm_cvtepi32_ps(dInt)));
+      alignas(16) int x0Index[4];
+      _mm_store_si128((__m128i*)x0Index, _mm_and_si128(_mm_sub_epi32(_mm_set1_epi32(w - 1), dInt), maskI));
+
+      const __m128 xm1 = _mm_setr_ps(line[(x0Index[0] - 1) & mask],
+                                     line[(x0Index[1] - 1) & mask],
+                                     line[(x0Index[2] - 1) & mask],
+                                     line[(x0Index[3] - 1) & mask]);
+      const __m128 x0 = _mm_setr_ps(line[x0Index[0]], line[x0Index[1]], line[x0Index[2]], line[x0Index[3]]);
+      const __m128 x1 = _mm_setr_ps(line[(x0Index[0] + 1) & mask],
+                                    line[(x0Index[1] + 1) & mask],
+                                    line[(x0Index[2] + 1) & mask],
+                                    line[(x0Index[3] + 1) & mask]);
+      const __m128 x2 = _mm_setr_ps(line[(x0Index[0] + 2) & mask],
+                                    line[(x0Index[1] + 2) & mask],
+                                    line[(x0Index[2] + 2) & mask],
+                                    line[(x0Index[3] + 2) & mask]);
+      const float wet = Sum4(_mm_mul_ps(Cubic4(xm1, x0, x1, x2, t), voiceGain));
+      _mm_store_ps(mCurrent[ch], _mm_add_ps(d, _mm_load_ps(mIncrement[ch])));
+#else
+      float wet = 0;
+      for (int v = 0; v < mVoices; ++v)
+      {
+        const float d = mCurrent[ch][v];
+        const int dInt = (int)d;
+        const int x0Index = (w - 1 - dInt) & mask;
+        wet += mVoiceGain[v] * Cubic(line[(x0Index - 1) & mask],
+                                     line[x0Index],
+                                     line[(x0Index + 1) & mask],
+                                     line[(x0Index + 2) & mask],
+                                     1 - (d - dInt));
+      }
+      for (int v = 0; v < gVoiceCount; ++v)
+      {
+        mCurrent[ch][v] += mIncrement[ch][v];
+      }
+#endif  // WAVESABRE_MODDELAY_SSE
+
+      // written after the read so the feedback loop is exactly the tap's delay.
+      line[w] = dry + mFeedback * wet;
+      out[ch][i] = dry * dryGain + wet * wetGain;
+    }
+    mWriteIndex = (w + 1) & mask;
+  }
+}
+
+void ModDelayCore::RunPhaserBlock(const float* const* in,
+                                  float* const* out,
+                                  int offset,
+                                  int blockSize,
+                                  float dryGain,
+                                  float wetGain)
+{
+  for (int ch = 0; ch < 2; ++ch)
+  {
+    float a = mCurrent[ch][0];
+    const float aInc = mIncrement[ch][0];
+    float* state = mAllpassState[ch];
+    float fb = mPhaserOutput[ch];
+    for (int i = offset; i < offset + blockSize; ++i)
+    {
+      const float dry = in[ch][i];
+      float s = dry + mFeedback * fb;
+      // first-order allpasses, (a + z^-1) / (1 + a z^-1), transposed direct form.
+      for (int k = 0; k < mStages; ++k)
+      {
+        const float y = a * s + state[k];
+        state[k] = s - a * y;
+        s = y;
+      }
+      fb = s;
+      out[ch][i] = dry * dryGain + s * wetGain;
+      a += aInc;
+    }
+    mCurrent[ch][0] = a;
+    mPhaserOutput[ch] = fb;
+  }
+}
+
+}  // namespace WaveSabreCore::M7
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../Basic/DSPMath.hpp"
+#include "../Basic/PodVector.hpp"
+
+namespace WaveSabreCore::M7
+{
+// the engine behind Maj7Modulate: a stereo modulated delay line (chorus, flanger, vibrato), or a chain
+// of first-order allpasses (phaser), with feedback in both cases.
+//
+// the delay runs up to gVoiceCount taps per channel, one per SIMD lane; every sample reads all of a
+// channel's taps together with 4-point cubic interpolation. the LFOs are evaluated once per
+// gBlockSize samples (all voices and both channels in one sin_n call) and each tap's delay / each
+// allpass coefficient ramps linearly in between, which is smooth enough at LFO rates.
+struct ModDelayCore
+{
+  enum class Mode
+  {
+    Delay,
+    Phaser,
+    Count__,
+  };
+
+  static constexpr int gVoiceCount = 4;
+  static constexpr int gBlockSize = 16;
+  static constexpr int gMaxStages = 8;
+  // the base delay's range; modulation can swing a tap up to twice the base.
+  static constexpr float gMaxDelayMs = 50;
+  // the cubic reads up to 2 samples newer than the tap, and the newest sample in the line is the previous one.
+  static constexpr float gMinDelaySamples = 2;
+  // phaser sweep at full depth, in octaves either side of the center frequency.
+  static constexpr float gPhaserSweepOctaves = 2;
+
+  Mode mMode = Mode::Delay;
+  int mVoices = 1;
+  float mDelayMs = 5;
+  float mDepth = 0;        // 0-1; a tap's delay swings by this fraction of the base delay.
+  float mRateHz = 0.5f;
+  float mVoiceSpread = 0;  // 0-1; voices' LFO phases fan out over this much of a cycle.
+  float mStereoPhase = 0;  // 0-1; the right channel's LFO lags by this much of half a cycle.
+  float mFeedback = 0;     // -1..1, applied as is; keep it inside (-1, 1).
+  int mStages = 4;
+  float mCenterHz = 1000;
+
+  ModDelayCore();
+
+  // stereo; out may alias in. wet and dry are mixed into out.
+  void Run(const float* const* in, float* const* out, int numSamples, float dryGain, float wetGain);
+
+private:
+  void UpdateLineLength();
+  void BeginBlock(int blockSize);
+  void RunDelayBlock(const float* const* in, float* const* out, int offset, int blockSize, float dryGain, float wetGain);
+  void RunPhaserBlock(const float* const* in, float* const* out, int offset, int blockSize, float dryGain, float wetGain);
+
+  PodVector<float> mLines[2];
+  int mLineMask = 0;
+  int mWriteIndex = 0;
+  float mLineSampleRate = 0;  // the rate the lines were sized for
+
+  double mPhase = 0;  // LFO phase, in cycles
+  bool mHasTargets = false;
+  Mode mRampMode = Mode::Delay;
+
+  // per channel, per lane: the value at the current sample and its per-sample increment for this block.
+  // in delay mode lanes are voices (delay in samples); in phaser mode only lane 0 is used (allpass coefficient).
+  alignas(16) float mCurrent[2][gVoiceCount] = {};
+  alignas(16) float mIncrement[2][gVoiceCount] = {};
+  alignas(16) float mVoiceGain[gVoiceCount] = {};
+
+  float mPhaserOutput[2] = {};
+  float mAllpassState[2][gMaxStages] = {};
+};
+}  // namespace WaveSabreCore::M7
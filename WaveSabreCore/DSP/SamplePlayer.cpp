@@ -1,8 +1,151 @@
 #include "SamplePlayer.h"
 #include "../Basic/DSPMath.hpp"
 
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+  #include <cmath>
+  #if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+    #define WAVESABRE_SAMPLEPLAYER_SSE
+    #include <emmintrin.h>
+  #endif
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
+
 namespace WaveSabreCore
 {
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+namespace
+{
+constexpr float kSample16Scale = 1.0f / 32768;
+constexpr int kMaxSpan = 1 << 30;
+
+// kernels read taps p[-Before] .. p[After] around the integer position.
+struct LinearKernel
+{
+  static constexpr int Before = 0;
+  static constexpr int After = 1;
+  static float Eval(const int16_t* p, float frac)
+  {
+    // GmDlsSample::GetSampleAt() and math::lerp() written out, so this is exactly what Next() returns.
+    const float a = p[0] * kSample16Scale;
+    const float b = p[1] * kSample16Scale;
+    return a * (1.0f - frac) + b * frac;
+  }
+};
+
+  #ifdef WAVESABRE_SAMPLEPLAYER_SSE
+inline __m128 Load4(const int16_t* p)
+{
+  __m128i v = _mm_loadl_epi64((const __m128i*)p);
+  v = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+  return _mm_cvtepi32_ps(v);
+}
+
+inline float HorizontalSum(__m128 v)
+{
+  v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+  v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+  return _mm_cvtss_f32(v);
+}
+  #endif  // WAVESABRE_SAMPLEPLAYER_SSE
+
+struct CubicHermiteKernel
+{
+  static constexpr int Before = 1;
+  static constexpr int After = 2;
+  static float Eval(const int16_t* p, float f)
+  {
+    // catmull-rom weights for taps -1, 0, 1, 2
+    const float f2 = f * f;
+    const float f3 = f2 * f;
+    const float w0 = -0.5f * f3 + f2 - 0.5f * f;
+    const float w1 = 1.5f * f3 - 2.5f * f2 + 1;
+    const float w2 = -1.5f * f3 + 2 * f2 + 0.5f * f;
+    const float w3 = 0.5f * f3 - 0.5f * f2;
+  #ifdef WAVESABRE_SAMPLEPLAYER_SSE
+    return HorizontalSum(_mm_mul_ps(Load4(p - 1), _mm_setr_ps(w0, w1, w2, w3))) * kSample16Scale;
+  #else
+    return (p[-1] * w0 + p[0] * w1 + p[1] * w2 + p[2] * w3) * kSample16Scale;
+  #endif  // WAVESABRE_SAMPLEPLAYER_SSE
+  }
+};
+
+struct WindowedSincKernel
+{
+  static constexpr int Before = 7;
+  static constexpr int After = 8;
+  static constexpr int Taps = Before + After + 1;
+  static constexpr int Phases = 64;
+
+  // one row of Taps weights per fractional phase (Phases + 1 rows so frac == 1 needs no wrap),
+  // each normalized to unity DC gain. built once, shared by all players.
+  struct Table
+  {
+    float mWeights[Phases + 1][Taps];
+    Table()
+    {
+      constexpr double kPi = 3.14159265358979323846;
+      constexpr double kHalfWidth = After;
+      for (int r = 0; r <= Phases; ++r)
+      {
+        const double frac = (double)r / Phases;
+        double sum = 0;
+        double w[Taps];
+        for (int t = 0; t < Taps; ++t)
+        {
+          const double x = (t - Before) - frac;
+          const double sinc = (x == 0) ? 1 : std::sin(kPi * x) / (kPi * x);
+          const double a = kPi * x / kHalfWidth;
+          const double win = (std::abs(x) >= kHalfWidth) ? 0 : 0.42 + 0.5 * std::cos(a) + 0.08 * std::cos(2 * a);
+          w[t] = sinc * win;
+          sum += w[t];
+        }
+        for (int t = 0; t < Taps; ++t)
+        {
+          mWeights[r][t] = (float)(w[t] / sum);
+        }
+      }
+    }
+  };
+
+  static const float* GetRow(float frac)
+  {
+    static const Table sTable;
+    return sTable.mWeights[(int)(frac * Phases + 0.5f)];
+  }
+
+  static float Eval(const int16_t* p, float frac)
+  {
+    const float* w = GetRow(frac);
+    const int16_t* s = p - Before;
+  #ifdef WAVESABRE_SAMPLEPLAYER_SSE
+    __m128 acc = _mm_mul_ps(Load4(s), _mm_loadu_ps(w));
+    acc = _mm_add_ps(acc, _mm_mul_ps(Load4(s + 4), _mm_loadu_ps(w + 4)));
+    acc = _mm_add_ps(acc, _mm_mul_ps(Load4(s + 8), _mm_loadu_ps(w + 8)));
+    acc = _mm_add_ps(acc, _mm_mul_ps(Load4(s + 12), _mm_loadu_ps(w + 12)));
+    return HorizontalSum(acc) * kSample16Scale;
+  #else
+    float acc = 0;
+    for (int t = 0; t < Taps; ++t)
+    {
+      acc += s[t] * w[t];
+    }
+    return acc * kSample16Scale;
+  #endif  // WAVESABRE_SAMPLEPLAYER_SSE
+  }
+};
+
+SampleInterpolation gSamplerInterpolation = SampleInterpolation::Linear;
+}  // namespace
+
+SampleInterpolation GetSamplerInterpolation()
+{
+  return gSamplerInterpolation;
+}
+void SetSamplerInterpolation(SampleInterpolation n)
+{
+  gSamplerInterpolation = n;
+}
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
+
 SamplePlayer::SamplePlayer()
 {
   SampleStart = 0.0f;
@@ -82,7 +225,112 @@ float SamplePlayer::Next()
   float sample = M7::math::lerp(leftSample, rightSample, (float)samplePosFract);
 
   samplePos += sampleDelta;
+  ApplyLoop();
+
+  return sample;
+}
+
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+void SamplePlayer::Render(float* out, int n)
+{
+  switch (Interpolation)
+  {
+    case SampleInterpolation::CubicHermite:
+      RenderWith<CubicHermiteKernel>(out, n);
+      return;
+    case SampleInterpolation::WindowedSinc:
+      RenderWith<WindowedSincKernel>(out, n);
+      return;
+  }
+  RenderWith<LinearKernel>(out, n);
+}
+
+template <typename TKernel>
+void SamplePlayer::RenderWith(float* out, int n)
+{
+  const int lengthSamplesI = SampleLength();
+  while (n > 0)
+  {
+    const int roundedSamplePos = (int)M7::math::floord(samplePos);
+    if (!mpSample || roundedSamplePos < 0 || roundedSamplePos >= lengthSamplesI)
+    {
+      IsActive = false;
+      for (int i = 0; i < n; ++i)
+        out[i] = 0;
+      return;
+    }
+
+    // fast span: position is known to stay >= 0 and away from every boundary.
+    int fast = CalcFastSpan(TKernel::Before, TKernel::After);
+    if (fast > n)
+      fast = n;
+    const int16_t* data = mpSample->mpSampleData;
+    double pos = samplePos;
+    for (int i = 0; i < fast; ++i)
+    {
+      const int ipos = (int)pos;
+      out[i] = TKernel::Eval(data + ipos, (float)(pos - ipos));
+      pos += sampleDelta;
+    }
+    samplePos = pos;
+    out += fast;
+    n -= fast;
+    if (fast || !n)
+      continue;
+
+    // one fully-checked sample; this is where loop wraps and ping-pong turnarounds happen.
+    int16_t taps[TKernel::Before + TKernel::After + 1];
+    for (int t = 0; t < TKernel::Before + TKernel::After + 1; ++t)
+    {
+      taps[t] = FetchTap(roundedSamplePos - TKernel::Before + t, roundedSamplePos);
+    }
+    *out++ = TKernel::Eval(taps + TKernel::Before, (float)(samplePos - roundedSamplePos));
+    --n;
+    samplePos += sampleDelta;
+    ApplyLoop();
+  }
+}
 
+int SamplePlayer::CalcFastSpan(int tapsBefore, int tapsAfter) const
+{
+  // taps past the loop end wrap in repeat mode, so the kernel can't read straight through there.
+  const int tapLimit = (LoopMode == LoopMode::Repeat) ? roundedLoopEnd : SampleLength();
+  const double pos = samplePos;
+  const int ipos = (int)pos;
+  if (ipos - tapsBefore < 0 || ipos + tapsAfter >= tapLimit)
+    return 0;
+
+  // one sample of margin on top of the estimate so accumulated rounding in samplePos can never
+  // carry a fast sample across an edge.
+  double count = kMaxSpan;
+  if (sampleDelta > 0)
+  {
+    const int edge = (LoopMode == LoopMode::Disabled) ? SampleLength() : roundedLoopEnd;
+    const int limit = (edge < tapLimit - tapsAfter) ? edge : (tapLimit - tapsAfter);
+    count = (limit - pos) / sampleDelta - 2;
+  }
+  else if (sampleDelta < 0)
+  {
+    const int edge = (LoopMode == LoopMode::Disabled) ? 0 : roundedLoopStart;
+    const int limit = (edge > tapsBefore) ? edge : tapsBefore;
+    count = (pos - limit) / -sampleDelta - 1;
+  }
+  return (int)M7::math::ClampI(count, 0.0, (double)kMaxSpan);
+}
+
+int16_t SamplePlayer::FetchTap(int index, int centerIndex) const
+{
+  // when playing inside the loop, taps past the loop end continue from the loop start.
+  if (LoopMode == LoopMode::Repeat && index >= roundedLoopEnd && centerIndex < roundedLoopEnd)
+    index -= roundedLoopLength;
+  if (index < 0 || index >= SampleLength())
+    return 0;
+  return mpSample->mpSampleData[index];
+}
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
+
+void SamplePlayer::ApplyLoop()
+{
   switch (LoopMode)
   {
     case LoopMode::Repeat:
@@ -113,7 +361,5 @@ float SamplePlayer::Next()
       }
       break;
   }
-
-  return sample;
 }
 }  // namespace WaveSabreCore
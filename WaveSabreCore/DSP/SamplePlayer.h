@@ -1,4 +1,3 @@
-
 #pragma once
 
 #include <cstdint>
@@ -16,6 +15,34 @@ enum class LoopMode  // : uint8_t
   NumLoopModes,
 };
 
+enum class SampleInterpolation  // : uint8_t
+{
+  Linear,
+  CubicHermite,  // 4-point catmull-rom
+  WindowedSinc,  // 16-point blackman-windowed sinc
+  Count,
+};
+
+#define SAMPLE_INTERPOLATION_CAPTIONS(symbolName)                                                                    \
+  static constexpr char const* const symbolName[(int)::WaveSabreCore::SampleInterpolation::Count]{                  \
+      "Linear",                                                                                                      \
+      "Cubic Hermite",                                                                                               \
+      "Windowed sinc",                                                                                               \
+  };
+
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+// not a patch param, so songs always render linear; a global listening choice for the plugin, like
+// M7::QualitySetting. the players never set it.
+extern SampleInterpolation GetSamplerInterpolation();
+extern void SetSamplerInterpolation(SampleInterpolation);
+#else
+// size-optimized builds only carry Next()'s linear interpolation.
+inline constexpr SampleInterpolation GetSamplerInterpolation()
+{
+  return SampleInterpolation::Linear;
+}
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
+
 class SamplePlayer
 {
 public:
@@ -24,10 +51,20 @@ public:
   void SetPlayRate(double ratio);
   void InitPos();
   void RunPrep();
+  // one linearly interpolated sample.
   float Next();
 
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+  // Renders n samples at the current play rate with the selected interpolation; linear gives exactly
+  // what Next() would. Work is split into spans that can't hit a loop or end boundary (and whose
+  // interpolation taps stay inside the sample); those run a tight kernel directly on the 16-bit data.
+  // Samples near a boundary take the fully-checked path.
+  void Render(float* out, int n);
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
+
   bool Reverse;
   WaveSabreCore::LoopMode LoopMode;
+  SampleInterpolation Interpolation = SampleInterpolation::Linear;
 
   float SampleStart;
   float LoopStart;
@@ -45,6 +82,17 @@ private:
     return mpSample->mSampleLength;
   }
 
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+  template <typename TKernel>
+  void RenderWith(float* out, int n);
+  // how many samples can be rendered without boundary / tap checks, from the current position.
+  int CalcFastSpan(int tapsBefore, int tapsAfter) const;
+  // raw sample with loop wrap for taps past the loop end, and 0 outside the sample.
+  int16_t FetchTap(int index, int centerIndex) const;
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
+  // after advancing, applies loop wrap / ping-pong turnaround.
+  void ApplyLoop();
+
   bool IsActive;
 
   double sampleDelta;
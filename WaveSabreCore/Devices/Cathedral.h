@@ -54,6 +54,11 @@ static constexpr int16_t gParamDefaults[(int)Cathedral::ParamIndices::NumParams]
 #ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
   AnalysisStream mInputAnalysis[2];
   AnalysisStream mOutputAnalysis[2];
+
+  virtual void DrainAnalysis() override
+  {
+    DrainAnalysisTaps(mInputAnalysis, mOutputAnalysis);
+  }
 #endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
   virtual void OnParamsChanged() override;
@@ -9,6 +9,7 @@
 #include "../Filters/DCFilter.hpp"
 #include "../Filters/Maj7Filter.hpp"
 #include "../Params/Maj7ParamAccessor.hpp"
+#include "../Params/SmoothedParam.hpp"
 #include "../WSCore/Device.h"
 
 
@@ -17,6 +18,12 @@ namespace WaveSabreCore::M7
 struct Leveller : public Device
 {
   static constexpr size_t gBandCount = 5;
+  // smoothed params move, and band coefficients follow them, this many samples at a time.
+  static constexpr int gSmoothingBlockSize = 32;
+  // glide length: one automation step (SongRenderer::AutomationStepFrames). automation sets a new target
+  // every step, so a glide of exactly that long follows the lane a step behind, where a longer one would
+  // restart every step and lag.
+  static constexpr float gGlideSamples = 100;
 
   enum class ParamIndices  // : uint8_t
   {
@@ -167,23 +174,66 @@ static constexpr int16_t gLevellerDefaults16[(int)ParamIndices::NumParams] = {
     {
     }
 
+    // filter type changes apply immediately; frequency, gain and Q glide over glideMS, unless jump is set.
+    void SetTargets(bool jump, float glideMS)
+    {
+      mCircuit = mParams.GetEnumValue<FilterCircuit>(BandParamOffsets::Circuit);
+      mSlope = mParams.GetEnumValue<FilterSlope>(BandParamOffsets::Slope);
+      mResponse = mParams.GetEnumValue<FilterResponse>(BandParamOffsets::Response);
+      const float freq01 = mParams.Get01Value(BandParamOffsets::Freq);
+      const float gain = mParams.GetScaledRealValue(BandParamOffsets::Gain, gEqBandGainMin, gEqBandGainMax, 0);
+      const float q01 = mParams.Get01Value(BandParamOffsets::Q);
+      if (jump)
+      {
+        mFreq01.Reset(freq01);
+        mGain.Reset(gain);
+        mQ01.Reset(q01);
+      }
+      else
+      {
+        mFreq01.SetRampTime(glideMS);
+        mGain.SetRampTime(glideMS);
+        mQ01.SetRampTime(glideMS);
+        mFreq01.SetTarget(freq01);
+        mGain.SetTarget(gain);
+        mQ01.SetTarget(q01);
+      }
+      RecalcFilters();
+    }
+
+    // coefficients (tan() and friends) are only recomputed while something is moving.
+    void AdvanceSmoothing(int numSamples)
+    {
+      if (mFreq01.IsSettled() && mGain.IsSettled() && mQ01.IsSettled())
+      {
+        return;
+      }
+      mFreq01.Advance(numSamples);
+      mGain.Advance(numSamples);
+      mQ01.Advance(numSamples);
+      RecalcFilters();
+    }
+
     void RecalcFilters()
     {
-      const auto circuit = mParams.GetEnumValue<FilterCircuit>(BandParamOffsets::Circuit);
-      const auto slope = mParams.GetEnumValue<FilterSlope>(BandParamOffsets::Slope);
-      const auto response = mParams.GetEnumValue<FilterResponse>(BandParamOffsets::Response);
-      const auto cutoffHz = mParams.GetFrequency(BandParamOffsets::Freq, gFilterFreqConfig);
-      const auto reso01 = Param01{mParams.Get01Value(BandParamOffsets::Q)};
-      const auto gain = mParams.GetScaledRealValue(BandParamOffsets::Gain, gEqBandGainMin, gEqBandGainMax, 0);
+      const auto cutoffHz = gFilterFreqConfig.GetFrequency(mFreq01.GetCurrent(), 0, 0);
+      const auto reso01 = Param01{mQ01.GetCurrent()};
 
       for (size_t i = 0; i < 2; ++i)
       {
-        mFilters[i].SetParams(circuit, slope, response, cutoffHz, reso01, gain);
+        mFilters[i].SetParams(mCircuit, mSlope, mResponse, cutoffHz, reso01, mGain.GetCurrent());
       }
     }
 
     ParamAccessor mParams;
 
+    FilterCircuit mCircuit = FilterCircuit::Disabled;
+    FilterSlope mSlope = FilterSlope::Flat;
+    FilterResponse mResponse = FilterResponse::Lowpass;
+    SmoothedParam mFreq01;
+    SmoothedParam mGain;  // dB
+    SmoothedParam mQ01;
+
     //BiquadFilter mFilters[2];
     FilterNode mFilters[2];
   };
@@ -193,6 +243,11 @@ static constexpr int16_t gLevellerDefaults16[(int)ParamIndices::NumParams] = {
   AnalysisStream mOutputAnalysis[2];
   SmoothedStereoFFT mInputSpectrumSmoother;   // Input display smoother + analyzer
   SmoothedStereoFFT mOutputSpectrumSmoother;  // Output display smoother + analyzer
+
+  virtual void DrainAnalysis() override
+  {
+    DrainAnalysisTaps(mInputAnalysis, mOutputAnalysis, mInputSpectrumSmoother, mOutputSpectrumSmoother);
+  }
 #endif                                        // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
 
@@ -204,11 +259,27 @@ static constexpr int16_t gLevellerDefaults16[(int)ParamIndices::NumParams] = {
 
   virtual void Run(float** inputs, float** outputs, int numSamples) override
   {
-    float masterGain = mParams.GetLinearVolume(ParamIndices::OutputVolume, gVolumeCfg12db);
     bool enableDC = mParams.GetBoolValue(ParamIndices::EnableDCFilter);
 
-    for (int iSample = 0; iSample < numSamples; iSample++)
+    for (int offset = 0; offset < numSamples; offset += gSmoothingBlockSize)
     {
+      const int n = std::min(gSmoothingBlockSize, numSamples - offset);
+      for (auto& b : mBands)
+      {
+        b.AdvanceSmoothing(n);
+      }
+      float gains[gSmoothingBlockSize];
+      const bool gainMoving = mOutputGain.Process(gains, n);
+      RunBlock(inputs, outputs, offset, n, enableDC, gainMoving ? gains : nullptr);
+    }
+  }
+
+  // masterGains has one gain per sample, or is null when the output gain is settled.
+  void RunBlock(float** inputs, float** outputs, int offset, int n, bool enableDC, const float* masterGains)
+  {
+    for (int iSample = offset; iSample < offset + n; iSample++)
+    {
+      const float masterGain = masterGains ? masterGains[iSample - offset] : mOutputGain.GetCurrent();
       float s1 = inputs[0][iSample];
       float s2 = inputs[1][iSample];
       
@@ -254,10 +325,33 @@ static constexpr int16_t gLevellerDefaults16[(int)ParamIndices::NumParams] = {
 
   virtual void OnParamsChanged() override
   {
+    ApplyParams(false);
+  }
+
+  // the defaults or a whole chunk (song load, host state): that's where the song starts, so there's
+  // nothing to glide from.
+  virtual void OnBulkParamsChanged() override
+  {
+    ApplyParams(true);
+  }
+
+  void ApplyParams(bool jump)
+  {
+    const float outputGain = mParams.GetLinearVolume(ParamIndices::OutputVolume, gVolumeCfg12db);
+    const float glideMS = gGlideSamples * 1000 * Helpers::CurrentSampleRateRecipF();
+    if (jump)
+    {
+      mOutputGain.Reset(outputGain);
+    }
+    else
+    {
+      mOutputGain.SetRampTime(glideMS);
+      mOutputGain.SetTarget(outputGain);
+    }
     for (int iBand = 0; iBand < gBandCount; ++iBand)
     {
       auto& b = mBands[iBand];
-      b.RecalcFilters();
+      b.SetTargets(jump, glideMS);
     }
   }
 
@@ -273,6 +367,7 @@ static constexpr int16_t gLevellerDefaults16[(int)ParamIndices::NumParams] = {
   };
 
   DCFilter mDCFilters[2];
+  SmoothedParam mOutputGain;
 };
 }  // namespace WaveSabreCore::M7
 
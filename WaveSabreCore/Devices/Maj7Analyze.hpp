@@ -38,6 +38,11 @@ struct Maj7Analyze : public Device
   AnalysisStream mLoudnessAnalysis[2] = {AnalysisStream{kPeakFalloffMS}, AnalysisStream{kPeakFalloffMS}};
   StereoImagingAnalysisStream mInputImagingAnalysis;
   SmoothedStereoFFT mFFT;  // Input display smoother + analyzer
+
+  virtual void DrainAnalysis() override
+  {
+    DrainAnalysisTaps(mLoudnessAnalysis, mFFT);
+  }
 #endif                     // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
   Maj7Analyze()
@@ -254,6 +254,11 @@ static constexpr int16_t gParamDefaults[(int)ParamIndices::NumParams] = {
 
 		static constexpr float gFastAnalysisPeakFalloffMS = 50;
 		static constexpr float gSlowAnalysisPeakFalloffMS = 1000;
+
+		virtual void DrainAnalysis() override
+		{
+			DrainAnalysisTaps(mInputAnalysis, mOutputAnalysis, mDetectorAnalysis, mAttenuationAnalysis, mInputAnalysisSlow, mOutputAnalysisSlow);
+		}
 #endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
 		Maj7Comp() :
@@ -50,6 +50,11 @@ namespace WaveSabreCore
 #ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
 		AnalysisStream mInputAnalysis[2];
 		AnalysisStream mOutputAnalysis[2];
+
+		virtual void DrainAnalysis() override
+		{
+			DrainAnalysisTaps(mInputAnalysis, mOutputAnalysis);
+		}
 #endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
 		Maj7Crush()
@@ -353,6 +353,11 @@ struct Maj7MBC : public Device
 
     BandConfig mVSTConfig;
     bool mMuteSoloEnable;
+
+    void DrainTap()
+    {
+      DrainAnalysisTaps(mInputAnalysis, mOutputAnalysis, mDetectorAnalysis, mAttenuationAnalysis);
+    }
 #endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
     void Slider()
@@ -526,6 +531,20 @@ struct Maj7MBC : public Device
   SmoothedMonoFFT mInputSideSpectrum;
   SmoothedMonoFFT mOutputMidSpectrum;
   SmoothedMonoFFT mOutputSideSpectrum;
+
+  virtual void DrainAnalysis() override
+  {
+    DrainAnalysisTaps(mBands,
+                      mInputAnalysis,
+                      mOutputAnalysis,
+                      mClippingAnalysis,
+                      mInputSpectrum,
+                      mOutputSpectrum,
+                      mInputMidSpectrum,
+                      mInputSideSpectrum,
+                      mOutputMidSpectrum,
+                      mOutputSideSpectrum);
+  }
 #endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
   Maj7MBC()
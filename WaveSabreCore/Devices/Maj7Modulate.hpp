@@ -1,66 +1,25 @@
 #pragma once
 #include "../WSCore/Device.h"
+#include "../DSP/ModDelayCore.hpp"
 
 /*
 
-underlying we should make an audio buffer that can also replace our existing
-- comb
-- allpass
-- delay line
-and aim to support...
+chorus / flanger / vibrato / phaser, on M7::ModDelayCore.
 
-------------
-scenarios to support:
-- tremolo (lfo modulating gain)
-- vibrato (lfo modulating delay time)
-- chorus (multiple delay mods with feedback)
-- flanger (delay mod with feedback)
-- phaser (lfo modulating all-pass frequencies) -- this may not be necessary for v1 because it's a lot of infra for a rare effect.
+- Delay mode: 1-4 voices per channel reading a shared delay line, each with its own LFO phase.
+	- chorus: a few voices, ~8-30ms, low feedback
+	- flanger: 1 voice, ~1-5ms, lots of feedback (negative for the hollow sound)
+	- vibrato: 1 voice, wet only
+- Phaser mode: 1-8 first-order allpasses swept around a center frequency, with feedback.
+  mixed with the dry signal, each pair of stages makes a notch.
 
-------------
-design:
-
-- N voices (8) which supports
-	- gain
-	- delay
-	- feedback
-	- allpass
-	- each of which supports LFO modulation
-- probably some amount of macro control like
-	- per-voice param, a variation amt.
-- x[n] -> voice -> v[n] -> mixed -> y[n]
-   - feedback (-1,+1) mixes y[n] into x[n+1]
+the LFO is a sine; Rate / Depth / Spread / StereoPhase shape it for both modes (Phaser uses one voice).
 
 ------------
-params:
-- pre gain / hpf/dc blocker
-- dry mix
-- wet mix
-- interpolation mode (nearest, linear, cubic)
-
-- each of N voices:
-   - enabled
-   - polarity
-   - base gain / pan
-   - base delay
-   - feedback
-      - gain
-	  - flip polarity
-	  - ping-pong
-   - lfo:
-      - waveform
-	  - shapeA
-	  - shapeB
-      - rate hz
-	  - -> delay time
-	  - -> gain
-	- phase warp
-		- stages 0-8 ap filters in series.
-		- slope
-		- response could be experimental
-		- cutoff center hz
-		- cutoff spread hz
-		- jitter - lerping each tap frequency towards something off-grid
+not yet:
+- tremolo / auto-pan (lfo modulating gain)
+- lfo waveforms, tempo sync
+- per-voice gain / pan / delay variation
 
 */
 
@@ -68,27 +27,83 @@ namespace WaveSabreCore
 {
 	struct Maj7Modulate : public Device
 	{
+		using Mode = M7::ModDelayCore::Mode;
+
+		static constexpr M7::IntParamConfig gVoicesCfg{ 1, M7::ModDelayCore::gVoiceCount };
+		static constexpr M7::IntParamConfig gStagesCfg{ 1, M7::ModDelayCore::gMaxStages };
+		// value of K chosen so the middle of the knob (~8ms) is chorus territory, with flanger times below.
+		static constexpr M7::PowCurvedParamCfg gDelayTimeCfg{ 0.1f, M7::ModDelayCore::gMaxDelayMs, 2.0f };
+		// full feedback never quite reaches unity.
+		static constexpr float gMaxFeedback = 0.95f;
+
 		enum class ParamIndices
 		{
-            OutputVolume,
+			OutputVolume,
+			Mode,
+			Voices,
+			DelayMs,
+			Depth,
+			Rate,
+			Spread,
+			StereoPhase,
+			Feedback,
+			Stages,
+			CenterFreq,
+			DryOutput,
+			WetOutput,
 			NumParams,
 		};
 
 #define MAJ7MODULATE_PARAM_VST_NAMES(symbolName) static constexpr char const* const symbolName[(int)::WaveSabreCore::Maj7Modulate::ParamIndices::NumParams]{ \
 	{"OutputVolume"},\
+	{"Mode"},\
+	{"Voices"},\
+	{"DelayMS"},\
+	{"Depth"},\
+	{"Rate"},\
+	{"Spread"},\
+	{"StPhase"},\
+	{"Feedback"},\
+	{"Stages"},\
+	{"APFreq"},\
+	{"DryOut"},\
+	{"WetOut"},\
 }
 
-		static_assert((int)Maj7Modulate::ParamIndices::NumParams == 1, "param count probably changed and this needs to be regenerated.");
+		static_assert((int)Maj7Modulate::ParamIndices::NumParams == 13, "param count probably changed and this needs to be regenerated.");
+		// wet defaults to off: chunks from when this was a plain output volume load with only that param, and
+		// must still pass through.
 		static constexpr int16_t gDefaults16[(int)Maj7Modulate::ParamIndices::NumParams] = {
 		  5684, // OutputVolume = 0.17346939444541931152
+		  0, // Mode = 0
+		  7, // Voices = 0.000244140625
+		  15934, // DelayMS = 0.48628818988800048828
+		  9830, // Depth = 0.30000001192092895508
+		  9891, // Rate = 0.30187967419624328613
+		  32767, // Spread = 1
+		  16383, // StPhase = 0.5
+		  0, // Feedback = 0
+		  15, // Stages = 0.00048828125
+		  16383, // APFreq = 0.5
+		  16422, // DryOut = 0.50118720531463623047
+		  0, // WetOut = 0
 		};
 
 		float mParamCache[(int)ParamIndices::NumParams];
 		M7::ParamAccessor mParams { mParamCache, 0 };
 
+		M7::ModDelayCore mCore;
+		float mDryGain = 1;
+		float mWetGain = 1;
+
 #ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
 		AnalysisStream mInputAnalysis[2];
 		AnalysisStream mOutputAnalysis[2];
+
+		virtual void DrainAnalysis() override
+		{
+			DrainAnalysisTaps(mInputAnalysis, mOutputAnalysis);
+		}
 #endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
 		Maj7Modulate()
@@ -99,32 +114,47 @@ namespace WaveSabreCore
 
 		virtual void Run(float** inputs, float** outputs, int numSamples) override
 		{
-			for (int i = 0; i < numSamples; i++)
-			{
 #ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
-				if (IsGuiVisible())
+			if (IsGuiVisible())
+			{
+				for (int i = 0; i < numSamples; i++)
 				{
 					mInputAnalysis[0].WriteSample(inputs[0][i]);
 					mInputAnalysis[1].WriteSample(inputs[1][i]);
 				}
+			}
 #endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
-                float outputVolume = mParams.GetLinearVolume((int)ParamIndices::OutputVolume, M7::gVolumeCfg24db, 0);
-                outputs[0][i] = inputs[0][i] * outputVolume;
-                outputs[1][i] = inputs[1][i] * outputVolume;
+			mCore.Run(inputs, outputs, numSamples, mDryGain, mWetGain);
 
 #ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
-				if (IsGuiVisible())
+			if (IsGuiVisible())
+			{
+				for (int i = 0; i < numSamples; i++)
 				{
 					mOutputAnalysis[0].WriteSample(outputs[0][i]);
 					mOutputAnalysis[1].WriteSample(outputs[1][i]);
 				}
-#endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 			}
+#endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 		}
 
 		virtual void OnParamsChanged() override
 		{
+			mCore.mMode = mParams.GetEnumValue<Mode>(ParamIndices::Mode);
+			mCore.mVoices = M7::math::ClampI(mParams.GetIntValue(ParamIndices::Voices), gVoicesCfg.mMinValInclusive, gVoicesCfg.mMaxValInclusive);
+			mCore.mDelayMs = mParams.GetPowCurvedValue(ParamIndices::DelayMs, gDelayTimeCfg, 0);
+			mCore.mDepth = mParams.Get01Value(ParamIndices::Depth, 0);
+			mCore.mRateHz = mParams.GetFrequency(ParamIndices::Rate, M7::gLFOFreqConfig);
+			mCore.mVoiceSpread = mParams.Get01Value(ParamIndices::Spread, 0);
+			mCore.mStereoPhase = mParams.Get01Value(ParamIndices::StereoPhase, 0);
+			mCore.mFeedback = mParams.GetN11Value(ParamIndices::Feedback, 0) * gMaxFeedback;
+			mCore.mStages = M7::math::ClampI(mParams.GetIntValue(ParamIndices::Stages), gStagesCfg.mMinValInclusive, gStagesCfg.mMaxValInclusive);
+			mCore.mCenterHz = mParams.GetFrequency(ParamIndices::CenterFreq, M7::gFilterFreqConfig);
+
+			float outputVolume = mParams.GetLinearVolume(ParamIndices::OutputVolume, M7::gVolumeCfg24db, 0);
+			mDryGain = mParams.GetLinearVolume(ParamIndices::DryOutput, M7::gVolumeCfg12db, 0) * outputVolume;
+			mWetGain = mParams.GetLinearVolume(ParamIndices::WetOutput, M7::gVolumeCfg12db, 0) * outputVolume;
 		}
 
 	};
@@ -202,6 +202,11 @@ static constexpr int16_t gParamDefaults[(int)ParamIndices::NumParams] = {
 
 			bool mMuteSoloEnabled;
 			BandConfig mVSTConfig;
+
+			void DrainTap()
+			{
+				DrainAnalysisTaps(mInputAnalysis0, mInputAnalysis1, mOutputAnalysis0, mOutputAnalysis1);
+			}
 #endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
 			FreqBand(float* paramCache, ParamIndices baseParamID) : //
@@ -449,6 +454,11 @@ static constexpr int16_t gParamDefaults[(int)ParamIndices::NumParams] = {
 		AnalysisStream mInputAnalysis1;
 		AnalysisStream mOutputAnalysis0;
 		AnalysisStream mOutputAnalysis1;
+
+		virtual void DrainAnalysis() override
+		{
+			DrainAnalysisTaps(mBands, mInputAnalysis0, mInputAnalysis1, mOutputAnalysis0, mOutputAnalysis1);
+		}
 #endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
 		virtual void Run(float** inputs, float** outputs, int numSamples) override
@@ -125,6 +125,11 @@ static constexpr int16_t gParamDefaults[(int)ParamIndices::NumParams] = {
   AnalysisStream mDelayAnalysis[2];
   AnalysisStream mReverbAnalysis[2];
   AnalysisStream mOutputAnalysis[2];
+
+  virtual void DrainAnalysis() override
+  {
+    DrainAnalysisTaps(mInputAnalysis, mDelayAnalysis, mReverbAnalysis, mOutputAnalysis);
+  }
 #endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
   Maj7Space()
@@ -336,7 +336,7 @@ void Maj7SynthDevice::Run(float** inputs, float** __outputs, int numSamples)
     {
       mEvents[i].DeltaSamples -= samplesToNextEvent;
     }
-    //songPosition += (double)samplesToNextEvent / Helpers::CurrentSampleRate;
+    //songPosition += (double)samplesToNextEvent / Helpers::CurrentSampleRate();
     runningOutputs[0] += samplesToNextEvent;
     runningOutputs[1] += samplesToNextEvent;
     numSamples -= samplesToNextEvent;
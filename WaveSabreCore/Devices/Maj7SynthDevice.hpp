@@ -74,7 +74,12 @@ public:
   {
     Voice* oldestReleasedVoice = nullptr;
     Voice* oldestHeldVoice = nullptr;
-    for (size_t iv = 0; iv < (size_t)mMaxVoices; ++iv)
+    size_t maxVoices = (size_t)mMaxVoices;
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+    if (maxVoices > (size_t)M7::GetVoiceLimit())
+      maxVoices = (size_t)M7::GetVoiceLimit();
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
+    for (size_t iv = 0; iv < maxVoices; ++iv)
     {
       auto* v = mVoices[iv];
       if (!v->IsPlaying())
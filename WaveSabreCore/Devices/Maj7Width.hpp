@@ -252,6 +252,11 @@ struct Maj7Width : public Device
   AnalysisStream mOutputAnalysis[2];
   StereoImagingAnalysisStream mInputImagingAnalysis;
   StereoImagingAnalysisStream mOutputImagingAnalysis;
+
+  virtual void DrainAnalysis() override
+  {
+    DrainAnalysisTaps(mInputAnalysis, mOutputAnalysis);
+  }
 #endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
   Maj7Width()
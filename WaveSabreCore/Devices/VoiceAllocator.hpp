@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include "../Basic/Arena.hpp"
 #include "../Basic/Array.hpp"
 #include "../Basic/DSPMath.hpp"
 
@@ -25,7 +26,7 @@ enum class VoiceNoteOnFlags
   Panic = 1 << 2,
 };
 
-struct Voice
+struct Voice : ArenaAllocated
 {
   // child classes must implement
   //virtual void ProcessAndMix(double songPosition, float* const* const outputs, int numSamples, const float* oscDetuneSemis, const float* unisonoDetuneSemis) = 0;
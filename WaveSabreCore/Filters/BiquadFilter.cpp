@@ -30,7 +30,7 @@ void BiquadConfig::SetBiquadParams(FilterResponse response, float freq, Decibels
       response == FilterResponse::Peak || response == FilterResponse::LowShelf || response == FilterResponse::HighShelf;
   const float A = responseUsesGain ? M7::math::sqrt(linearGain) : linearGain;
 
-  mW0 = M7::math::gPITimes2 * freq * Helpers::CurrentSampleRateRecipF;
+  mW0 = M7::math::gPITimes2 * freq * Helpers::CurrentSampleRateRecipF();
   const float alpha = M7::math::sin(mW0) / (q.value * 2);
   float cosw0 = M7::math::cos(mW0);
 
@@ -153,8 +153,8 @@ float BiquadFilter::GetMagnitudeAtFrequency(float freqHz) const
   const double b1 = mConfig.normB1();
   const double b2 = mConfig.normB2();
 
-  const double clampedFreqHz = M7::math::clamp(double(freqHz), 0.0, 0.5 * Helpers::CurrentSampleRate);
-  const double w = M7::math::gPITimes2d * clampedFreqHz * Helpers::CurrentSampleRateRecipF;
+  const double clampedFreqHz = M7::math::clamp(double(freqHz), 0.0, 0.5 * Helpers::CurrentSampleRate());
+  const double w = M7::math::gPITimes2d * clampedFreqHz * Helpers::CurrentSampleRateRecipF();
 
   const double cw = M7::math::CrtCos(w);
   const double c2w = M7::math::CrtCos(2 * w);
@@ -22,7 +22,7 @@ namespace WaveSabreCore
             //    // (e.g. 0.99) if you don't know the sample rate. Instead set R to:
             //    // (-3dB @ 40Hz): R = 1-(250/samplerate)
             //    // (-3dB @ 20Hz): R = 1-(126/samplerate)
-            //    R = Real1 - (PITimes2 * hz / Helpers::CurrentSampleRateF);
+            //    R = Real1 - (PITimes2 * hz / Helpers::CurrentSampleRateF());
             //}
 
             real ProcessSample(real xn)
@@ -28,7 +28,7 @@ struct DiodeFilter : IFilter
 
   inline void Recalc()
   {
-    const real2 g = CalculateFilterG(cutoff);  // math::tan(cutoff * math::gPI * Helpers::CurrentSampleRateRecipF);
+    const real2 g = CalculateFilterG(cutoff);  // math::tan(cutoff * math::gPI * Helpers::CurrentSampleRateRecipF());
     const real2 halfG = real2(0.5f) * g;
     const real2 gPlus1 = real2(1) + g;
 
@@ -164,8 +164,8 @@ struct DiodeFilter : IFilter
 
   virtual real GetMagnitudeAtFrequency(real freqHz) const override
   {
-    const double clampedFreq = math::clamp(double(freqHz), 0.0, 0.5 * Helpers::CurrentSampleRate);
-    const double w = math::gPITimes2d * clampedFreq * Helpers::CurrentSampleRateRecipF;
+    const double clampedFreq = math::clamp(double(freqHz), 0.0, 0.5 * Helpers::CurrentSampleRate());
+    const double w = math::gPITimes2d * clampedFreq * Helpers::CurrentSampleRateRecipF();
 
     DiodeFilter copy = *this;
     copy.Reset();
@@ -51,7 +51,7 @@ struct K35Filter : IFilter
   inline void Recalc()
   {
     //const real2 cutoff = math::clamp(mCutoffHz, 20.0f, 20000.0f);
-    const real2 g = CalculateFilterG(cutoff);  // math::tan(cutoff * math::gPI * Helpers::CurrentSampleRateRecipF);
+    const real2 g = CalculateFilterG(cutoff);  // math::tan(cutoff * math::gPI * Helpers::CurrentSampleRateRecipF());
     const real2 G = g / (real2(1) + g);
 
     ConfigureOnePolesForCurrentResponse(cutoff);
@@ -162,8 +162,8 @@ struct K35Filter : IFilter
 
   virtual real GetMagnitudeAtFrequency(real freqHz) const override
   {
-    const double clampedFreq = math::clamp(double(freqHz), 0.0, 0.5 * Helpers::CurrentSampleRate);
-    const double w = math::gPITimes2d * clampedFreq * Helpers::CurrentSampleRateRecipF;
+    const double clampedFreq = math::clamp(double(freqHz), 0.0, 0.5 * Helpers::CurrentSampleRate());
+    const double w = math::gPITimes2d * clampedFreq * Helpers::CurrentSampleRateRecipF();
 
     K35Filter copy = *this;
     copy.Reset();
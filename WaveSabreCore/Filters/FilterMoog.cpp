@@ -76,12 +76,12 @@ void MoogLadderFilter::Recalc()
 
   // note: measured input to tan function, it seemed limited to (0.005699, 1.282283).
   // input for fasttan shall be limited to (-pi/2, pi/2) according to documentation
-  //real wa = (2 * Helpers::CurrentSampleRateF) * math::tan(wd * Helpers::CurrentSampleRateRecipF * Real(0.5));
-  //real g = wa * Helpers::CurrentSampleRateRecipF * Real(0.5);
+  //real wa = (2 * Helpers::CurrentSampleRateF()) * math::tan(wd * Helpers::CurrentSampleRateRecipF() * Real(0.5));
+  //real g = wa * Helpers::CurrentSampleRateRecipF() * Real(0.5);
 
   //real2 cutoff = math::clamp(m_cutoffHz, 30, 20000);
 
-  real2 g = CalculateFilterG(m_cutoffHz);  // math::tan(real2(cutoff) * math::gPI * Helpers::CurrentSampleRateRecipF);
+  real2 g = CalculateFilterG(m_cutoffHz);  // math::tan(real2(cutoff) * math::gPI * Helpers::CurrentSampleRateRecipF());
 
   // G - the feedforward coeff in the VA One Pole
   //     same for LPF, HPF
@@ -47,8 +47,8 @@ struct MoogLadderFilter : IFilter
 
   virtual real GetMagnitudeAtFrequency(real freqHz) const override
   {
-    const double clampedFreq = math::clamp(double(freqHz), 0.0, 0.5 * Helpers::CurrentSampleRate);
-    const double w = math::gPITimes2d * clampedFreq * Helpers::CurrentSampleRateRecipF;
+    const double clampedFreq = math::clamp(double(freqHz), 0.0, 0.5 * Helpers::CurrentSampleRate());
+    const double w = math::gPITimes2d * clampedFreq * Helpers::CurrentSampleRateRecipF();
 
     MoogLadderFilter copy = *this;
     copy.Reset();
@@ -65,10 +65,10 @@ void MoogOnePoleFilter::Recalc()
   // TPT (topology-preserving transform) 1-pole integrator formula
   // real2 cutoff = math::clamp(m_cutoffHz, 20, 20000);
   // real2 wd = math::gPI * cutoff;
-  // real2 T = Helpers::CurrentSampleRateRecipF;
+  // real2 T = Helpers::CurrentSampleRateRecipF();
   // real2 g = real2(math::tan(float(wd * T)));
 
-  real2 g = CalculateFilterG(m_cutoffHz);  // math::tan(cutoff * math::gPI * Helpers::CurrentSampleRateRecipF);
+  real2 g = CalculateFilterG(m_cutoffHz);  // math::tan(cutoff * math::gPI * Helpers::CurrentSampleRateRecipF());
 
   m_alpha = g / (g + 1);
 }
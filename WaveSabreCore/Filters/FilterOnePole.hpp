@@ -64,8 +64,8 @@ struct MoogOnePoleFilter : public IFilter
       return 1.0f;
     }
 
-    const double clampedFreq = math::clamp(double(freqHz), 0.0, 0.5 * Helpers::CurrentSampleRate);
-    const double w = math::gPITimes2d * clampedFreq * Helpers::CurrentSampleRateRecipF;
+    const double clampedFreq = math::clamp(double(freqHz), 0.0, 0.5 * Helpers::CurrentSampleRate());
+    const double w = math::gPITimes2d * clampedFreq * Helpers::CurrentSampleRateRecipF();
     const double cw = math::cos(w);
     const double sw = math::sin(w);
 
@@ -41,7 +41,7 @@ struct FilterNode
 };  // FilterNode
 
 
-struct FilterAuxNode  // : IAuxEffect
+struct FilterAuxNode : ArenaAllocated  // : IAuxEffect
 {
   FilterNode
       mFilter;  // stereo. cpu optimization: combine into a stereo filter to eliminate double recalc. but it's more code size.
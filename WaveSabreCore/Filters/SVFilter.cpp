@@ -17,7 +17,7 @@ void SVFilter::SetParams(float cutoff, float Q, FilterResponse response)
   mQ = Q;
   mResponse = response;
 
-  //g = M7::math::tan(M7::math::gPI * cutoff * Helpers::CurrentSampleRateRecipF);
+  //g = M7::math::tan(M7::math::gPI * cutoff * Helpers::CurrentSampleRateRecipF());
   g = CalculateFilterG(cutoff);
   k = 1.0f / Q;  // do NOT try to normalize this; caller is responsible for usable values. (size-optimization)
   a1 = 1.0f / (1.0f + g * (g + k));
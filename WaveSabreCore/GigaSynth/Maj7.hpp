@@ -1,4 +1,4 @@
-// Time sync for LFOs? use Helpers::CurrentTempo; but do i always know the song position?
+// Time sync for LFOs? use Helpers::CurrentTempo(); but do i always know the song position?
 
 // size-optimizations:
 // (profile w sizebench!)
@@ -22,6 +22,7 @@
 
 #include "../Analysis/AnalysisStream.hpp"
 #include "../Analysis/RMS.hpp"
+#include "../Basic/Arena.hpp"
 #include "../Basic/DSPMath.hpp"
 #include "../Basic/Helpers.h"
 #include "../Devices/Maj7SynthDevice.hpp"
@@ -203,6 +204,10 @@ struct Maj7 : public Maj7SynthDevice
 
   AnalysisStream mOutputAnalysis[2]{AnalysisStream{1000}, AnalysisStream { 1000 }};
 
+  virtual void DrainAnalysis() override
+  {
+    DrainAnalysisTaps(mOutputAnalysis);
+  }
 #endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
   // BASE PARAMS & state
@@ -226,7 +231,7 @@ struct Maj7 : public Maj7SynthDevice
   // 1. the LFO is not triggered by notes.
   // 2. the LFO has no modulations on its phase or frequency
 
-  struct LFODevice
+  struct LFODevice : ArenaAllocated
   {
     explicit LFODevice(float* paramCache, size_t ilfo);
     const LFOInfo& mInfo;
@@ -260,9 +265,12 @@ struct Maj7 : public Maj7SynthDevice
                                                                                gSourceInfo[i + gOscillatorCount]);
     }
 
-    for (size_t i = 0; i < mVoices.Size(); ++i)
     {
-      mVoices[i] = mMaj7Voice[i] = new Maj7Voice(this);
+      ArenaSubsystemScope subsystemScope{MemorySubsystem::Voices};
+      for (size_t i = 0; i < mVoices.Size(); ++i)
+      {
+        mVoices[i] = mMaj7Voice[i] = new Maj7Voice(this);
+      }
     }
 
     LoadDefaults();
@@ -292,7 +300,7 @@ struct Maj7 : public Maj7SynthDevice
 #endif  // MIN_SIZE_REL
   }
 
-  virtual void LoadDefaults() override
+  virtual void ImportDefaults() override
   {
     // samplers reset
     //for (auto& s : mpSamplerDevices)
@@ -341,11 +349,15 @@ struct Maj7 : public Maj7SynthDevice
     }
 
     mParamCache[(int)GigaSynthParamIndices::Osc1Enabled] = 1.0f;
+  }
 
+  virtual void OnBulkParamsChanged() override
+  {
     // Apply dynamic state
     this->SetVoiceMode(
         mParams.GetEnumValue<VoiceMode>(GigaSynthParamIndices::VoicingMode));     // mVoicingModeParam.GetEnumValue());
     this->SetUnisonoVoices(mParams.GetIntValue(GigaSynthParamIndices::Unisono));  // mUnisonoVoicesParam.GetIntValue());
+    this->SetMaxVoices(mParams.GetIntValue(GigaSynthParamIndices::MaxVoices));
 
 #ifdef _DEBUG
     // validate values.
@@ -357,8 +369,6 @@ struct Maj7 : public Maj7SynthDevice
     }
 #endif
 
-    // NOTE: samplers will always be empty here
-
     SetVoiceInitialStates();
   }
 
@@ -383,13 +393,13 @@ struct Maj7 : public Maj7SynthDevice
   //virtual void SetBinary16DiffChunk(void* data, int size) override
   {
     //Deserializer ds{ (const uint8_t*)data };
-    Device::SetBinary16DiffChunk(ds);
+    ReadBinary16DiffChunk(ds);
     //SetMaj7StyleChunk(ds);
     for (auto& s : mpSamplerDevices)
     {
       s->Deserialize(ds);
     }
-    SetVoiceInitialStates();
+    OnBulkParamsChanged();
   }
 
   void SetParam(int index, float value)
@@ -470,7 +480,7 @@ struct Maj7 : public Maj7SynthDevice
 
     for (size_t iv = 0; iv < (size_t)mMaxVoices; ++iv)
     {
-      mMaj7Voice[iv]->BeginBlock(forceAllVoicesToProcess);
+      mMaj7Voice[iv]->BeginBlock(forceAllVoicesToProcess, numSamples);
     }
 
     const float masterGain = mParams.GetLinearVolume(GigaSynthParamIndices::MasterVolume, gMasterVolumeCfg, 0);
@@ -502,12 +512,19 @@ struct Maj7 : public Maj7SynthDevice
         outputs[ioutput][iSample] = o;
 #endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
       }
+    }
 
-      // advance phase of master LFOs
-      for (size_t i = 0; i < gModLFOCount; ++i)
+    // advance phase of master LFOs, a recalc period at a time. the recalc counter carries over from the last
+    // block, so the first chunk only runs up to its next recalc point.
+    for (size_t i = 0; i < gModLFOCount; ++i)
+    {
+      auto& lfo = *mpLFOs[i];
+      for (int offset = 0; offset < numSamples;)
       {
-        auto& lfo = *mpLFOs[i];
-        lfo.mPhase.RenderSampleForLFOAndAdvancePhase(true);
+        const int recalcSpan = GetModulationRecalcSampleMask() + 1 - (int)lfo.mPhase.GetSamplesSinceRecalc();
+        const int nSamples = std::min(recalcSpan, numSamples - offset);
+        lfo.mPhase.RenderLFOBlockAndAdvancePhase(nSamples, true);
+        offset += nSamples;
       }
     }
 
@@ -616,6 +633,7 @@ struct Maj7 : public Maj7SynthDevice
       {
         for (int ifilt = 0; ifilt < 2; ++ifilt)
         {
+          ArenaSubsystemScope subsystemScope{MemorySubsystem::Filters};
           mpFilters[ifilt][ich] = new FilterAuxNode(
               owner->mParamCache,
               (GigaSynthParamIndices)((int)GigaSynthParamIndices::Filter1Enabled +
@@ -678,7 +696,7 @@ struct Maj7 : public Maj7SynthDevice
 
     PortamentoCalc mPortamento;
 
-    struct LFOVoice
+    struct LFOVoice : ArenaAllocated
     {
       explicit LFOVoice(LFODevice& device, ModMatrixNode& modMatrix);
       LFODevice& mDevice;
@@ -707,6 +725,19 @@ struct Maj7 : public Maj7SynthDevice
     bool mSourceEnabledCache[gSourceCount]{};  // mirrors device enabled state
     bool mLFOUsedCache[gModLFOCount]{};        // true if any enabled modulation references this LFO
 
+#ifndef MIN_SIZE_REL
+    // each envelope's current EnvelopeNode::ProcessSegment() run, handed to the mod matrix a sample at a time.
+    struct EnvelopeSegment
+    {
+      float mSamples[EnvelopeNode::gMaxSegmentSamples];
+      int mLength = 0;
+      int mPos = 0;
+    };
+    EnvelopeSegment mEnvelopeSegments[gSourceCount + gModEnvCount];
+#endif  // !MIN_SIZE_REL
+    // mod sources render up to here, so nothing runs ahead of the voice across a block boundary.
+    int mSamplesLeftInBlock = 0;
+
 
     virtual void Kill(VoiceNoteOnFlags flags) override
     {
@@ -751,7 +782,7 @@ struct Maj7 : public Maj7SynthDevice
       mLFOInitialized = false;
     }
 
-    void BeginBlock(bool forceProcessing)
+    void BeginBlock(bool forceProcessing, int numSamples)
     {
       for (size_t i = 0; i < gSourceCount; ++i)
       {
@@ -769,6 +800,14 @@ struct Maj7 : public Maj7SynthDevice
       {
         p->BeginBlock();
       }
+#ifndef MIN_SIZE_REL
+      // BeginBlock() restarts the envelopes' recalc periods, so start new segments too.
+      for (auto& seg : mEnvelopeSegments)
+      {
+        seg.mLength = seg.mPos = 0;
+      }
+#endif  // !MIN_SIZE_REL
+      mSamplesLeftInBlock = numSamples;
 
       if (!forceProcessing && !this->IsPlaying())
       {
@@ -922,61 +961,74 @@ struct Maj7 : public Maj7SynthDevice
       }
     }
 
-    // K-rate LFO update: compute on boundary, otherwise advance phase cheaply and reuse cached value
-    inline void UpdateLFOsIfNeeded()
+    // K-rate LFO update. the mod matrix only reads sources on its recalc samples, so on a boundary each used
+    // LFO renders a block up to the next one (or the end of the block) in one go; in between there's nothing to do.
+    inline void UpdateLFOsIfNeeded(int samplesLeftInBlock)
     {
-      if (!mLFOInitialized || IsKRateBoundary())
+      if (mLFOInitialized && !IsKRateBoundary())
       {
-        for (size_t i = 0; i < gModLFOCount; ++i)
+        return;
+      }
+      const int recalcSpan = GetModulationRecalcSampleMask() + 1 - mModMatrix.mnSampleCount;
+      const int nSamples = std::min(recalcSpan, samplesLeftInBlock);
+      for (size_t i = 0; i < gModLFOCount; ++i)
+      {
+        if (!mLFOUsedCache[i])
+        {
+          // If not used, ensure published value is zero.
+          mLFOSampleCached[i] = 0.0f;
+        }
+        else
         {
-          if (!mLFOUsedCache[i])
-          {
-            // If not used, ensure published value is zero.
-            mLFOSampleCached[i] = 0.0f;
-            continue;
-          }
           auto& lfo = *mpLFOs[i];
-          float lfoSample = lfo.mNode.RenderSampleForLFOAndAdvancePhase(false);
+          float lfoSample = lfo.mNode.RenderLFOBlockAndAdvancePhase(nSamples, false);
           // filter at K-rate; acceptable for modulation smoothing
           lfoSample = lfo.mFilter.ProcessSample(lfoSample);
           mLFOSampleCached[i] = lfoSample;
         }
-        mLFOInitialized = true;
-      }
-      else
-      {
-        // advance phase without producing a new sample value for used LFOs only
-        for (size_t i = 0; i < gModLFOCount; ++i)
-        {
-          if (!mLFOUsedCache[i])
-            continue;
-          auto& lfo = *mpLFOs[i];
-          lfo.mNode.RenderSampleForLFOAndAdvancePhase(true);
-        }
-      }
-
-      // publish cached samples into mod matrix (0 for unused LFOs)
-      for (size_t i = 0; i < gModLFOCount; ++i)
-      {
-        auto& lfo = *mpLFOs[i];
-        mModMatrix.SetSourceValue(lfo.mDevice.mInfo.mModSource, mLFOSampleCached[i]);
+        mModMatrix.SetSourceValue(mpLFOs[i]->mDevice.mInfo.mModSource, mLFOSampleCached[i]);
       }
+      mLFOInitialized = true;
     }
 
     void ProcessAndMix(float* s, bool forceProcessing)
     {
+      // including this one.
+      const int samplesLeftInBlock = mSamplesLeftInBlock--;
+
       // NB: process envelopes before short-circuiting due to being not playing.
       // this is for issue#31; mod envelopes need to be able to release down to 0 even when the source envs are not playing.
       // if mod envs get suspended rudely, then they'll "wake up" at the wrong value.
-      for (auto& env : mpEnvelopes)
-      {
 #ifndef MIN_SIZE_REL  // optimization
+      // the mod matrix reads its sources only on recalc samples, so that's when they're published; plus an
+      // envelope's last sample, which it holds while idle.
+      const bool publishSources = IsKRateBoundary();
+      for (size_t i = 0; i < std::size(mpEnvelopes); ++i)
+      {
+        auto* env = mpEnvelopes[i];
         if (!env->IsPlaying())
           continue;
-#endif
+        // the stage machine runs once per segment instead of every sample.
+        auto& seg = mEnvelopeSegments[i];
+        if (seg.mPos == seg.mLength)
+        {
+          seg.mLength = env->ProcessSegment(seg.mSamples,
+                                            std::min(samplesLeftInBlock, EnvelopeNode::gMaxSegmentSamples));
+          seg.mPos = 0;
+        }
+        const float l = seg.mSamples[seg.mPos++];
+        if (publishSources || !env->IsPlaying())
+        {
+          mModMatrix.SetSourceValue(env->mMyModSource, l);
+        }
+      }
+#else
+      for (auto& env : mpEnvelopes)
+      {
         float l = env->ProcessSample();
         mModMatrix.SetSourceValue(env->mMyModSource, l);
       }
+#endif  // !MIN_SIZE_REL
 
       if (!forceProcessing && !this->IsPlaying())
       {
@@ -984,7 +1036,7 @@ struct Maj7 : public Maj7SynthDevice
       }
 
       // LFOs at K-rate
-      UpdateLFOsIfNeeded();
+      UpdateLFOsIfNeeded(samplesLeftInBlock);
 
       // process modulations here. sources have just been set, and past here we're getting many destination values.
       // processing here ensures fairly up-to-date accurate values.
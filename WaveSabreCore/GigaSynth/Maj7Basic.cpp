@@ -32,6 +32,16 @@ QualitySetting GetQualitySetting()
   return gQualitySetting;
 }
 
+int gVoiceLimit = gNoVoiceLimit;
+int GetVoiceLimit()
+{
+  return gVoiceLimit;
+}
+void SetVoiceLimit(int n)
+{
+  gVoiceLimit = n;
+}
+
 #endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
 
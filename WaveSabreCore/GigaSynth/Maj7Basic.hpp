@@ -76,6 +76,12 @@ extern uint16_t GetModulationRecalcSampleMask();
 extern QualitySetting GetQualitySetting();
 extern void SetQualitySetting(QualitySetting);
 
+// caps every synth's polyphony, on top of its own max voices. voices already playing above the cap are left to
+// finish. set between blocks (by the players' quality governor, under load); at least 1.
+static constexpr int gNoVoiceLimit = 0x7fff;
+extern int GetVoiceLimit();
+extern void SetVoiceLimit(int);
+
 #else
 
 // #121 hardcode it.
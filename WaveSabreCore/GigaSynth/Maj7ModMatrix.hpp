@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../Basic/Arena.hpp"
 #include "../Basic/DSPMath.hpp"
 #include "../GigaSynth/GigaParams.hpp"
 #include "../Params/Maj7ParamAccessor.hpp"
@@ -900,7 +901,7 @@ enum ModulationSpecType
   SourceAmp,
 };
 
-struct ModulationSpec
+struct ModulationSpec : ArenaAllocated
 {
   ParamAccessor mParams;
   bool const* mpDestSourceEnabledCached = &gAlwaysTrue;
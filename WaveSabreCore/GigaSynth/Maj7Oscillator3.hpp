@@ -4,6 +4,7 @@
 
 #include "../Waveshapes/Maj7Oscillator3Waveshapes.hpp"
 #include "../Waveshapes/Maj7Oscillator4WS.hpp"
+#include "../Basic/Arena.hpp"
 #include "Maj7Basic.hpp"
 #include "Maj7Oscillator3Base.hpp"
 
@@ -73,6 +74,7 @@ struct FoldedTriGenerator : public IShapeGenerator
 
 inline OscillatorCore* InstantiateWaveformCore(OscillatorWaveform w, OscillatorIntention intention)
 {
+  ArenaSubsystemScope subsystemScope{MemorySubsystem::Oscillators};
   const M7Osc4::AntiAliasingOption aaOpt = (intention == OscillatorIntention::LFO)
                                                ? M7Osc4::AntiAliasingOption::None
                                                : M7Osc4::AntiAliasingOption::PolyBlep;
@@ -161,6 +163,16 @@ struct KRateRecalculator
     }
     mNSamplesElapsed = (mNSamplesElapsed + 1) & GetModulationRecalcSampleMask();
   }
+  // the same over nSamples at once; callers keep blocks from running past the next recalc point.
+  template <typename T>
+  void visit(T run, int nSamples)
+  {
+    if (mNSamplesElapsed == 0)
+    {
+      run();
+    }
+    mNSamplesElapsed = (mNSamplesElapsed + nSamples) & GetModulationRecalcSampleMask();
+  }
 };
 
 struct OscillatorNode : ISoundSourceDevice::Voice
@@ -242,13 +254,12 @@ public:
     return mPreviousSample;
   }
 
-#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
-  // for debug only, alternate streams, expose how many samples since last recalculation of k-rate params.
+  // how many samples since last recalculation of k-rate params. for alternate streams, and for callers
+  // that render in blocks and need to end them on the next recalc point.
   size_t GetSamplesSinceRecalc() const
   {
     return mKRateRecalc.mNSamplesElapsed;
   }
-#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
   virtual void NoteOn(bool legato) override
   {
@@ -369,7 +380,7 @@ public:
                                                       0);  //mpOscDevice->mFrequencyMul.mCachedVal;// .GetRangedValue();
           freq *= detuneFreqMul;
           // 0 frequencies would cause math problems, denormals, infinites... but fortunately they're inaudible so...
-          freq = math::clamp(freq, 0.0001f, Helpers::NyquistHz);
+          freq = math::clamp(freq, 0.0001f, Helpers::NyquistHz());
           mCurrentFrequencyHz = freq;
 
           float syncFreq = 1;
@@ -380,7 +391,7 @@ public:
                                            gSyncFreqConfig,
                                            noteHz,
                                            syncFreqModVal);
-            syncFreq = math::clamp(syncFreq, 0.0001f, Helpers::NyquistHz);
+            syncFreq = math::clamp(syncFreq, 0.0001f, Helpers::NyquistHz());
           }
 
           SetWaveformShape(params.GetEnumValue<OscillatorWaveform>(OscParamIndexOffsets::Waveform));
@@ -414,9 +425,12 @@ public:
 
   //CoreSample mLastSample;
 
-  // render one sample for LFO, advance phase.
-  // forceSilence skips rendering the wave but still advances phase
-  float RenderSampleForLFOAndAdvancePhase(bool forceSilence)
+  // render an LFO block of nSamples and advance phase past it.
+  // the mod matrix only reads its sources on recalc samples, so only the block's first sample is rendered
+  // and the core skips over the rest. the phase restart trigger and k-rate params are read once, at the
+  // start of the block, so blocks should end at the next recalc point.
+  // forceSilence skips rendering even the first sample but still advances phase
+  float RenderLFOBlockAndAdvancePhase(int nSamples, bool forceSilence)
   {
 #ifdef ENABLE_OSC_LOG
     auto ens = gOscLog.EnabledBlock(false);
@@ -484,7 +498,7 @@ public:
 
           // 0 frequencies would cause math problems, denormals, infinites... but fortunately they're inaudible so...
           //finalFreq = std::max(finalFreq, 0.0001f);
-          finalFreq = math::clamp(finalFreq, 0.0001f, Helpers::NyquistHz);
+          finalFreq = math::clamp(finalFreq, 0.0001f, Helpers::NyquistHz());
 
           SetWaveformShape(params.GetEnumValue<OscillatorWaveform>(LFOParamIndexOffsets::Waveform));
 
@@ -493,20 +507,19 @@ public:
           float waveShapeBModVal = mpModMatrix->GetDestinationValue(modDestBaseId, LFOModParamIndexOffsets::WaveshapeB);
           float waveshapeB = params.Get01Value(LFOParamIndexOffsets::WaveshapeB, waveShapeBModVal);
           mCore->SetKRateParams(waveshapeA, waveshapeB, finalFreq, false, 1);
-        });
+        },
+        nSamples);
 
-    // uncomment for prod
-    const auto outp = mCore->renderSampleAndAdvance(GetPhaseOffset());
-    //mLastSample = outp;
-
-    if (forceSilence)
+    const float phaseOffset = GetPhaseOffset();
+    int nSkip = nSamples;
+    mPreviousSample = 0.0f;
+    if (!forceSilence)
     {
-      mPreviousSample = 0.0f;
-      return 0.0f;
+      mPreviousSample = mCore->renderSampleAndAdvance(phaseOffset).amplitude;
+      --nSkip;
     }
-
-    mPreviousSample = outp.amplitude;
-    return outp.amplitude;
+    mCore->advanceWithoutRendering(nSkip, phaseOffset);
+    return mPreviousSample;
   }
 
 };  // OscillatorNode
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "../Basic/Arena.hpp"
 #include "../Basic/DSPMath.hpp"
 #include "../Basic/Helpers.h"
 #include "Maj7Basic.hpp"
@@ -113,7 +114,7 @@ struct PhaseAccumulator
   }
   void setFrequencyHz(double hz)
   {
-    mDelta = std::max(hz * Helpers::CurrentSampleRateRecipF, 0.0);
+    mDelta = std::max(hz * Helpers::CurrentSampleRateRecipF(), 0.0);
   }
   double getPhase01() const
   {
@@ -150,6 +151,12 @@ struct PhaseAccumulator
     return {begin, mDelta, true, alpha01};  //, end};
   }
 
+  // n samples at once, no resets. equal to n advanceOneSampleNoReset() calls up to double rounding.
+  void advanceSamplesNoReset(int n)
+  {
+    mPhase01 = math::wrap01(mPhase01 + mDelta * n);
+  }
+
   // for high rate frequencies, may wrap more than once per sample.
   size_t advanceOneSampleReturningWrapsCrossed()
   {
@@ -214,6 +221,21 @@ struct HardSyncPhase
       return slave.advanceOneSampleNoReset();
     return slave.advanceOneSampleWithReset(alpha);
   }
+
+  // n samples without producing steps; with hard sync every reset has to be found, so that's per sample.
+  void advanceSamples(int n)
+  {
+    if (enabled)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        advanceOneSample();
+      }
+      return;
+    }
+    master.advanceSamplesNoReset(n);
+    slave.advanceSamplesNoReset(n);
+  }
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -239,7 +261,7 @@ enum class OscillatorCoreResetFlags
   PhaseRestart = 1 << 2,  // requesting phase restart
 };
 
-struct OscillatorCore
+struct OscillatorCore : ArenaAllocated
 {
 public:
   HardSyncPhase mPhaseAcc;
@@ -306,6 +328,17 @@ public:
   // so we can just shift phaseBegin01 and phaseEnd01 by the offset when you evaluate the shape, keeping the logic simple.
   virtual CoreSample renderSampleAndAdvance(float audioRatePhaseOffset) = 0;
 
+  // advance n samples without producing output; LFOs use this between mod recalcs. cores with state beyond
+  // the phase (streaming shapes, noise) still have to run every sample; cores whose output is a pure function
+  // of phase override this to jump straight there.
+  virtual void advanceWithoutRendering(int n, float audioRatePhaseOffset)
+  {
+    for (int i = 0; i < n; ++i)
+    {
+      renderSampleAndAdvance(audioRatePhaseOffset);
+    }
+  }
+
   // helper for frequency params.
   float GetFrequency(float param01) const
   {
@@ -8,7 +8,7 @@ namespace WaveSabreCore
 namespace M7
 {
 // sampler, oscillator, LFO @ device level
-struct ISoundSourceDevice
+struct ISoundSourceDevice : ArenaAllocated
 {
   ParamAccessor mParams;
   bool mEnabledCache;
@@ -48,7 +48,7 @@ struct ISoundSourceDevice
   }
   virtual void EndBlock() = 0;
 
-  struct Voice
+  struct Voice : ArenaAllocated
   {
     ISoundSourceDevice* mpSrcDevice;
     ModMatrixNode* mpModMatrix;
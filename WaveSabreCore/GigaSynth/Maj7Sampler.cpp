@@ -146,10 +146,14 @@ void SamplerDevice::LoadGmDlsSample(int sampleIndex)
     return;
   }
 
+  // with the bank missing there's no data to point the offset params at; keep the sample that was there.
+  if (!mSample.LoadGmDlsIndex(sampleIndex))
+  {
+    return;
+  }
+
   //mParams.SetEnumValue(SamplerParamIndexOffsets::SampleSource, SampleSource::GmDls);
   mParams.SetIntValue(SamplerParamIndexOffsets::GmDlsIndex, sampleIndex);
-  
-  mSample.LoadGmDlsIndex(sampleIndex);
 
   // store mSample.mpSampleData and mSample.mSampleLength in params so they can be serialized.
   const int offset = (uintptr_t)mSample.mpSampleData - (uintptr_t)GmDls::gpData;
@@ -193,7 +197,7 @@ void SamplerDevice::BeginBlock()
   mSampleRateCorrectionFactor =
       GmDlsSample::kSampleRate /
       (2 * base_hz *
-       Helpers::CurrentSampleRateF);  // WHY * 2? because it corresponds more naturally to other synth octave ranges.
+       Helpers::CurrentSampleRateF());  // WHY * 2? because it corresponds more naturally to other synth octave ranges.
 }
 
 void SamplerDevice::EndBlock()
@@ -212,6 +216,9 @@ void SamplerVoice::ClearState()
 {
   mSamplePlayer = SamplePlayer{};
   mNoteIsOn = false;
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+  mRenderedPos = mRenderedCount = 0;
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
   // mDelayPos01 = 0;
   // mDelayStep = 0;
 }
@@ -240,6 +247,7 @@ void SamplerVoice::ConfigPlayer()
   //mSamplePlayer.InterpolationMode = mpSamplerDevice->mParams.GetEnumValue<InterpolationMode>(SamplerParamIndexOffsets::InterpolationType); //mpSamplerDevice->mInterpolationMode.GetEnumValue();
   mSamplePlayer.Reverse = mpSamplerDevice->mParams.GetBoolValue(
       SamplerParamIndexOffsets::Reverse);  //mpSamplerDevice->mReverse.GetBoolValue();
+  mSamplePlayer.Interpolation = GetSamplerInterpolation();
 }
 
 void SamplerVoice::NoteOn(bool legato)
@@ -305,6 +313,9 @@ float SamplerVoice::ProcessSample(real_t midiNote, float detuneFreqMul, float fm
     if (mDelayPos01 >= 1)
     {
       mSamplePlayer.InitPos();  // play.
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+      mRenderedPos = mRenderedCount = 0;
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
     }
   }
   auto ms = mpSamplerDevice->mParams.GetPowCurvedValue(
@@ -313,6 +324,13 @@ float SamplerVoice::ProcessSample(real_t midiNote, float detuneFreqMul, float fm
       mpModMatrix->GetDestinationValue((int)mpSrcDevice->mModDestBaseID + (int)SamplerModParamIndexOffsets::Delay));
   mDelayStep = math::CalculateInc01PerSampleForMS(ms);
 
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+  if (mRenderedPos < mRenderedCount)
+  {
+    return math::clampN11(mRendered[mRenderedPos++] * ampEnvLin);
+  }
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
+
   // todo: unify freq calculation with oscillator.
   // but it would mean changing mod dest offsets so they are the same
   // and changing param offsets to match as well. for maybe a savings of like 60 bytes of squished code.
@@ -335,7 +353,16 @@ float SamplerVoice::ProcessSample(real_t midiNote, float detuneFreqMul, float fm
 
   mSamplePlayer.SetPlayRate(rate);
 
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+  // a k-rate run at a time, whichever kernel is selected, so switching kernels changes nothing but the
+  // interpolation.
+  mRenderedCount = GetModulationRecalcSampleMask() + 1;
+  mSamplePlayer.Render(mRendered, mRenderedCount);
+  mRenderedPos = 1;
+  return math::clampN11(mRendered[0] * ampEnvLin);  // clamp addresses craz glitch when changing samples.
+#else
   return math::clampN11(mSamplePlayer.Next() * ampEnvLin);  // clamp addresses craz glitch when changing samples.
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
 }
 
 
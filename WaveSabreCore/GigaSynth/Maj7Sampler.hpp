@@ -17,6 +17,7 @@
 #endif  // MAJ7_INCLUDE_GSM_SUPPORT
 #include "../DSP/SamplePlayer.h"
 #include "../GigaSynth/SampleSource.hpp"
+#include "Maj7Basic.hpp"
 #include "Maj7Oscillator.hpp"
 
 
@@ -84,6 +85,15 @@ struct SamplerVoice : ISoundSourceDevice::Voice
   float mDelayPos01 = 0;
   float mDelayStep = 0;  // per sample, how much to advance the delay stage. meaningless outside of delay stage.
 
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+  // the player renders a k-rate run at a time with the selected kernel; pitch modulation is picked up at
+  // the next run, same as the oscillators' k-rate frequency. size builds render per sample with Next().
+  static constexpr int kMaxRenderAhead = gModulationRecalcSampleMaskValues[0] + 1;
+  float mRendered[kMaxRenderAhead];
+  int mRenderedPos = 0;
+  int mRenderedCount = 0;
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
+
   SamplerVoice(ModMatrixNode& modMatrix, SamplerDevice* pDevice, EnvelopeNode* pAmpEnv);
   void ConfigPlayer();
   void ClearState();
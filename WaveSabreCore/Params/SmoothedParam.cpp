@@ -0,0 +1,115 @@
+#include "SmoothedParam.hpp"
+
+namespace WaveSabreCore::M7
+{
+
+void SmoothedParam::Reset(float value)
+{
+  mTarget = mCurrent = value;
+  mRemaining = 0;
+  mSettled = true;
+  mHasValue = true;
+}
+
+void SmoothedParam::SetTarget(float target)
+{
+  if (mHasValue && target == mTarget)
+  {
+    return;
+  }
+  const int rampSamples = (int)math::MillisecondsToSamples(mRampTimeMS);
+  if (!mHasValue || rampSamples < 1)
+  {
+    Reset(target);
+    return;
+  }
+  mTarget = target;
+  mSettled = false;
+  if (mCurve == Curve::Linear)
+  {
+    // from wherever it is now, so retargeting mid-ramp doesn't jump.
+    mRemaining = rampSamples;
+    mStep = (mTarget - mCurrent) / rampSamples;
+  }
+  else
+  {
+    mStep = 1 - math::expf(-1.0f / rampSamples);
+  }
+}
+
+float SmoothedParam::StepExponential()
+{
+  mCurrent += (mTarget - mCurrent) * mStep;
+  if (std::abs(mTarget - mCurrent) < gSettleThreshold)
+  {
+    mCurrent = mTarget;
+    mSettled = true;
+  }
+  return mCurrent;
+}
+
+bool SmoothedParam::Process(float* out, int n)
+{
+  if (mSettled || n <= 0)
+  {
+    return false;
+  }
+  int i = 0;
+  if (mCurve == Curve::Linear)
+  {
+    // computed from the block's start rather than accumulated, so the loop has no carried dependency.
+    const int ramp = n < mRemaining ? n : mRemaining;
+    const float start = mCurrent;
+    for (; i < ramp; ++i)
+    {
+      out[i] = start + mStep * (i + 1);
+    }
+    mRemaining -= ramp;
+    if (mRemaining == 0)
+    {
+      // land exactly on the target.
+      out[ramp - 1] = mTarget;
+      mSettled = true;
+    }
+    mCurrent = out[ramp - 1];
+  }
+  else
+  {
+    for (; i < n && !mSettled; ++i)
+    {
+      out[i] = StepExponential();
+    }
+  }
+  for (; i < n; ++i)
+  {
+    out[i] = mCurrent;
+  }
+  return true;
+}
+
+float SmoothedParam::Advance(int n)
+{
+  if (mSettled)
+  {
+    return mCurrent;
+  }
+  if (mCurve == Curve::Linear)
+  {
+    const int ramp = n < mRemaining ? n : mRemaining;
+    mRemaining -= ramp;
+    mCurrent = mCurrent + mStep * ramp;
+    if (mRemaining == 0)
+    {
+      mCurrent = mTarget;
+      mSettled = true;
+    }
+    return mCurrent;
+  }
+  for (int i = 0; i < n && !mSettled; ++i)
+  {
+    StepExponential();
+  }
+  return mCurrent;
+}
+
+}  // namespace WaveSabreCore::M7
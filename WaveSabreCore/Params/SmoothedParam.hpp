@@ -1,55 +1,81 @@
 #pragma once
 
-// a param reader that smooths its output value over time.
+// a param value that glides to its target instead of jumping, a block at a time.
 
 #include "../Basic/DSPMath.hpp"
 
 namespace WaveSabreCore::M7
 {
 
+// devices set the target whenever the param changes (usually OnParamsChanged), then per block of n samples
+// either consume the values as a vector:
+//   if (p.Process(values, n)) -> moving; values[0..n) has one value per sample
+//   else                      -> settled at GetCurrent() for the whole block
+// or, for coefficients, recompute only while it moves:
+//   if (!p.IsSettled()) RecalcCoefficients(p.Advance(n));
 //
-//class SmoothedParam
-//{
-//public:
-//  // smoothing coefficient: smaller = smoother (more lag, less ripple); larger = less smooth (less lag, more ripple)
-//  static constexpr float kCoeff = 1.0f / 6400.0f;
-//
-//  explicit SmoothedParam(float initialValue = 0.0f)
-//      : mTarget(initialValue)
-//      , mCurrent(initialValue)
-//  {
-//  }
-//
-//  void setTarget(float target)
-//  {
-//    mTarget = target;
-//  }
-//
-//  void reset(float value)
-//  {
-//    mTarget = value;
-//    mCurrent = value;
-//  }
-//
-//  float onSampleAndGetSmoothed()
-//  {
-//    mCurrent += (mTarget - mCurrent) * kCoeff;
-//    return mCurrent;
-//  }
-//
-//  float getTarget() const
-//  {
-//    return mTarget;
-//  }
-//  float getCurrent() const
-//  {
-//    return mCurrent;
-//  }
-//
-//private:
-//  float mTarget;
-//  float mCurrent;
-//};
+// where the param maps nonlinearly (frequency, time), smooth the 0-1 param value and map the result, so
+// the glide follows the knob. the exponential settle threshold assumes values of about that scale.
+struct SmoothedParam
+{
+  enum class Curve  // : uint8_t
+  {
+    Linear,       // reaches the target in exactly the ramp time.
+    Exponential,  // one-pole; the ramp time is the time constant.
+  };
+
+  static constexpr float gDefaultRampTimeMS = 20;
+  // exponential glides snap to the target once they're this close.
+  static constexpr float gSettleThreshold = 1e-5f;
+
+  explicit SmoothedParam(Curve curve = Curve::Linear, float rampTimeMS = gDefaultRampTimeMS)
+      : mCurve(curve)
+      , mRampTimeMS(rampTimeMS)
+  {
+  }
+
+  // the first target after construction or Reset() is taken immediately; there's nothing to glide from.
+  // setting the current target again doesn't restart the ramp, so it's fine to call for every param change.
+  void SetTarget(float target);
+  // jump straight to value.
+  void Reset(float value);
+  // takes effect at the next SetTarget().
+  void SetRampTime(float ms)
+  {
+    mRampTimeMS = ms;
+  }
+
+  bool IsSettled() const
+  {
+    return mSettled;
+  }
+  float GetCurrent() const
+  {
+    return mCurrent;
+  }
+  float GetTarget() const
+  {
+    return mTarget;
+  }
+
+  // advances n samples. while moving, fills out[0..n) with the value at each sample and returns true.
+  // once settled (or for an empty block) it returns false and out is left alone; the value is GetCurrent()
+  // throughout.
+  bool Process(float* out, int n);
+  // advances n samples and returns the value at the last one. same values as Process().
+  float Advance(int n);
+
+private:
+  float StepExponential();
 
+  Curve mCurve;
+  float mRampTimeMS;
+  float mTarget = 0;
+  float mCurrent = 0;
+  float mStep = 0;       // linear: added per sample. exponential: the one-pole coefficient.
+  int mRemaining = 0;    // linear: samples left in the ramp.
+  bool mSettled = true;
+  bool mHasValue = false;
+};
 
 }  // namespace WaveSabreCore::M7
@@ -0,0 +1,76 @@
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+
+#include "AnalysisWorker.hpp"
+#include "Device.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace WaveSabreCore
+{
+AnalysisWorker& AnalysisWorker::Instance()
+{
+  static AnalysisWorker sInstance;
+  return sInstance;
+}
+
+AnalysisWorker::~AnalysisWorker()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  StopThread(lock);
+}
+
+void AnalysisWorker::Register(Device* device)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  if (std::find(mDevices.begin(), mDevices.end(), device) != mDevices.end())
+    return;
+  mDevices.push_back(device);
+  if (!mThread.joinable())
+  {
+    const int generation = mGeneration;
+    mThread = std::thread([this, generation] { ThreadProc(generation); });
+  }
+}
+
+void AnalysisWorker::Unregister(Device* device)
+{
+  // holding the mutex means no drain is in progress.
+  std::unique_lock<std::mutex> lock(mMutex);
+  mDevices.erase(std::remove(mDevices.begin(), mDevices.end(), device), mDevices.end());
+  if (mDevices.empty())
+  {
+    StopThread(lock);
+  }
+}
+
+void AnalysisWorker::StopThread(std::unique_lock<std::mutex>& lock)
+{
+  if (!mThread.joinable())
+    return;
+  // bumping the generation stops exactly this thread, even if Register() starts a new one
+  // while we're waiting for the join below.
+  ++mGeneration;
+  mWake.notify_all();
+  std::thread t = std::move(mThread);
+  lock.unlock();
+  t.join();
+  lock.lock();
+}
+
+void AnalysisWorker::ThreadProc(int generation)
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (mGeneration == generation)
+  {
+    for (auto* device : mDevices)
+    {
+      device->DrainAnalysis();
+    }
+    mWake.wait_for(lock, std::chrono::milliseconds(kIntervalMS), [this, generation] { return mGeneration != generation; });
+  }
+}
+
+}  // namespace WaveSabreCore
+
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
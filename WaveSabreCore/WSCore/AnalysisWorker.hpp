@@ -0,0 +1,52 @@
+#pragma once
+
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+
+  #include <condition_variable>
+  #include <mutex>
+  #include <thread>
+  #include <vector>
+
+namespace WaveSabreCore
+{
+class Device;
+
+// Background thread which runs meters / spectrum analysis for every device whose editor is open.
+//
+// The audio thread only pushes raw samples into each analysis object's AnalysisTap; this thread
+// wakes at display rate and calls Device::DrainAnalysis() on all registered devices, so the
+// audio-thread cost of an open editor is a ring push per analyzed sample regardless of FFT size,
+// overlap or smoothing settings.
+//
+// Devices are registered while their GUI is visible (see Device::SetGuiVisible). The thread is
+// started with the first registration and stopped when the last device unregisters. A device must
+// be unregistered before its derived part (and so its analysis streams) is destroyed.
+class AnalysisWorker
+{
+public:
+  static constexpr int kIntervalMS = 15;
+
+  static AnalysisWorker& Instance();
+
+  void Register(Device* device);
+  // blocks until any in-flight drain of this device has finished, so it's safe to destroy
+  // the device after this returns.
+  void Unregister(Device* device);
+
+private:
+  AnalysisWorker() = default;
+  ~AnalysisWorker();
+
+  void ThreadProc(int generation);
+  void StopThread(std::unique_lock<std::mutex>& lock);
+
+  std::mutex mMutex;
+  std::condition_variable mWake;
+  std::vector<Device*> mDevices;
+  std::thread mThread;
+  int mGeneration = 0;
+};
+
+}  // namespace WaveSabreCore
+
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
@@ -2,6 +2,7 @@
 #include "../Basic/DSPMath.hpp"
 #include "../Basic/Helpers.h"
 #include "../Basic/GmDls.h"
+#include "AnalysisWorker.hpp"
 
 namespace WaveSabreCore
 {
@@ -13,15 +14,18 @@ namespace WaveSabreCore
 	{
 	  // this is the best place to do static init
 	  GmDls::EnsureInitialized();
-      if (!M7::math::gLuts)
-      {
-          M7::math::gLuts = new M7::math::LUTs();
-      }
+	  M7::math::EnsureLUTsInitialized();
 		chunkData = nullptr;
 	}
 
 	Device::~Device()
 	{
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+		// too late for the analysis streams, which the derived destructor has already run over; owners hide the
+		// gui first (see VstPlug). this only keeps the worker from holding on to a dangling pointer.
+		if (IsGuiVisible())
+			AnalysisWorker::Instance().Unregister(this);
+#endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 #ifdef MIN_SIZE_REL
 		// this is a virtual method so don't gate it out entirely.
   #pragma message("Device::~Device() Leaking memory to save bits.")
@@ -33,36 +37,65 @@ namespace WaveSabreCore
 	void Device::NoteOn(int note, int velocity, int deltaSamples) { }
 	void Device::NoteOff(int note, int deltaSamples) { }
 
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+	void Device::SetGuiVisible(bool visible)
+	{
+		mGuiVisible.store(visible, std::memory_order_relaxed);
+		if (visible)
+		{
+			AnalysisWorker::Instance().Register(this);
+		}
+		else
+		{
+			AnalysisWorker::Instance().Unregister(this);
+		}
+	}
+#endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
+
 #ifndef MIN_SIZE_REL
+	// these set the process default context, which is what plugins render with.
 	void Device::SetSampleRate(float sampleRate)
 	{
-		Helpers::CurrentSampleRateI = (int)sampleRate;
-		Helpers::CurrentSampleRate = (double)sampleRate;
-		Helpers::CurrentSampleRateF = sampleRate;
-		Helpers::CurrentSampleRateRecipF = 1.0f / sampleRate;
+		RenderContext::SetDefault((int)sampleRate, RenderContext::GetDefault().mTempo);
 	}
 	void Device::SetTempo(int tempo)
 	{
-		Helpers::CurrentTempo = tempo;
+		RenderContext::SetDefault(RenderContext::GetDefault().mSampleRateI, tempo);
 	}
 #endif
 
-	void Device::LoadDefaults() {
+	void Device::ImportDefaults() {
 		M7::ImportDefaultsArray(numParams, mDefaults16__, mParamCache__);
-		SetParam(0, mParamCache__[0]);
 	}
 
+	void Device::LoadDefaults() {
+		ImportDefaults();
+		OnBulkParamsChanged();
+	}
 
-	void Device::SetBinary16DiffChunk(M7::Deserializer& ds)
+	void Device::ReadBinary16DiffChunk(M7::Deserializer& ds)
 	{
-		this->LoadDefaults(); // important for delta behavior to start with defaults.
-		for (int i = 0; i < this->numParams; ++i)
+		ImportDefaults(); // important for delta behavior to start with defaults.
+		int count = this->numParams;
+		// a chunk saved before the device gained params ends early; the new ones keep their defaults.
+		// this holds for size builds too; songs exported with the old layout play there.
+		if (ds.mpEnd && ds.mpEnd - ds.mpCursor < count * (int)sizeof(int16_t))
+		{
+			count = int(ds.mpEnd - ds.mpCursor) / (int)sizeof(int16_t);
+		}
+		for (int i = 0; i < count; ++i)
 		{
-			float f = GetParam(i) + ds.ReadInt16NormalizedFloat();
-			SetParam(i, f);
+			mParamCache__[i] += ds.ReadInt16NormalizedFloat();
 		}
 	}
 
+	// one recalc for the whole chunk instead of one per param.
+	void Device::SetBinary16DiffChunk(M7::Deserializer& ds)
+	{
+		ReadBinary16DiffChunk(ds);
+		OnBulkParamsChanged();
+	}
+
 	void Device::clearOutputs(float **outputs, int numSamples)
 	{
 		for (int i = 0; i < 2; i++)
@@ -1,7 +1,9 @@
 #ifndef __WAVESABRECORE_DEVICE_H__
 #define __WAVESABRECORE_DEVICE_H__
 
+#include "../Basic/Arena.hpp"
 #include "../Basic/Serializer.hpp"
+#include "../Basic/RenderContext.hpp"
 
 #include <Windows.h>
 #include <stdint.h>
@@ -21,7 +23,7 @@
 
 namespace WaveSabreCore
 {
-	class Device
+	class Device : public ArenaAllocated
 	{
 	public:
 		explicit Device(int numParams, float* paramCache, const int16_t* defaults16);
@@ -49,8 +51,14 @@ namespace WaveSabreCore
 			return mParamCache__[index];
 		}
 
+		// the whole param cache was just written (defaults / chunk); bring derived state up to date once.
+		// devices whose SetParam() recalcs everything regardless of index don't need to override.
+		virtual void OnBulkParamsChanged() {
+			SetParam(0, mParamCache__[0]);
+		}
+
 		// support for maj7 style chunks, which are 16-bit and differential from default values
-		virtual void LoadDefaults();
+		void LoadDefaults();
 		virtual void SetBinary16DiffChunk(M7::Deserializer& ds);
 
 #ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
@@ -58,11 +66,21 @@ namespace WaveSabreCore
 		bool IsGuiVisible() const {
 			return mGuiVisible.load(std::memory_order_relaxed);
 		}
+		// called by the editor on open/close; while visible the device is drained by the AnalysisWorker. must be
+		// set back to false before the device is deleted, while its analysis streams still exist.
+		void SetGuiVisible(bool visible);
+		// runs on the analysis worker thread; drain every analysis stream / spectrum tap the device writes.
+		virtual void DrainAnalysis() {}
 #endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
 	protected:
 		void clearOutputs(float **outputs, int numSamples);
 
+		// writes default values into the param cache, without any recalc.
+		virtual void ImportDefaults();
+		// decodes a chunk into the param cache on top of the defaults, without any recalc.
+		void ReadBinary16DiffChunk(M7::Deserializer& ds);
+
 		int numParams;
 		void *chunkData;
 
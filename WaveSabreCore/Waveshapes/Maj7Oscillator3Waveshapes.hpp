@@ -290,6 +290,11 @@ struct SilenceOsc : public OscillatorCore
         //.phaseAdvance = step,
     };
   }
+
+  void advanceWithoutRendering(int n, float /*audioRatePhaseOffset*/) override
+  {
+    mPhaseAcc.advanceSamples(n);
+  }
 };
 
 
@@ -407,6 +412,12 @@ struct SineCoreExt : public OscillatorCore
         //.phaseAdvance = step,
     };
   }
+
+  // stateless beyond the phase.
+  void advanceWithoutRendering(int n, float /*audioRatePhaseOffset*/) override
+  {
+    mPhaseAcc.advanceSamples(n);
+  }
 };
 
 struct FoldedSineCore : public OscillatorCore
@@ -455,6 +466,11 @@ struct FoldedSineCore : public OscillatorCore
         //.phaseAdvance = step,
     };
   }
+
+  void advanceWithoutRendering(int n, float /*audioRatePhaseOffset*/) override
+  {
+    mPhaseAcc.advanceSamples(n);
+  }
 };
 
 struct SAHNoiseCore : public OscillatorCore
@@ -650,7 +666,7 @@ struct ContinuousNoiseCore : public OscillatorCore
     // want enough speed to feel like really NOISE; that doesn't happen until after 150 or so. but below that you get a lot of variation.
     // so go for high max, but use a curve to allow good control at low speeds.
     mMovementSpeed = math::lerp(0,
-                                400.0f * kOneOverTravelRadius * Helpers::CurrentSampleRateRecipF,
+                                400.0f * kOneOverTravelRadius * Helpers::CurrentSampleRateRecipF(),
                                 mWaveshapeB * mWaveshapeB);
   }
 
@@ -9,6 +9,8 @@
 #include "../DSP/DelayBuffer.h"
 #include "../Basic/GmDls.h"
 #include "../Basic/MxcsrFlagGuard.h"
+#include "../Basic/Arena.hpp"
+#include "../Basic/Threading.hpp"
 
 #include "./Devices.h"
 
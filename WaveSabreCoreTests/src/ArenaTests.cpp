@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <WaveSabreCore/../../Basic/Arena.hpp>
+#include <WaveSabreCore/../../Basic/PodVector.hpp>
+
+using namespace WaveSabreCore;
+
+namespace
+{
+struct Node : ArenaAllocated
+{
+  M7::PodVector<int> mValues;
+};
+}  // namespace
+
+TEST(Arena, RestoreRollsBackObjectGraph)
+{
+  Arena arena{size_t(64) << 20};
+  Node* node;
+  {
+    Arena::Scope scope{&arena};
+    node = new Node;
+    node->mValues = {1, 2, 3};
+  }
+  EXPECT_TRUE(arena.Contains(node));
+  EXPECT_TRUE(arena.Contains(node->mValues.data()));
+
+  Arena::Snapshot snapshot;
+  arena.Save(snapshot);
+  EXPECT_FALSE(arena.Contains(snapshot.data()));
+  const size_t usedAtSnapshot = arena.GetUsedBytes();
+
+  {
+    Arena::Scope scope{&arena};
+    node->mValues[0] = 10;
+    for (int i = 0; i < 100; i++)
+      node->mValues.push_back(i);  // regrows inside the arena
+  }
+  EXPECT_EQ(node->mValues.size(), 103u);
+  EXPECT_GT(arena.GetUsedBytes(), usedAtSnapshot);
+
+  arena.Restore(snapshot);
+  EXPECT_EQ(arena.GetUsedBytes(), usedAtSnapshot);
+  ASSERT_EQ(node->mValues.size(), 3u);
+  EXPECT_EQ(node->mValues[0], 1);
+  EXPECT_EQ(node->mValues[2], 3);
+
+  // only ArenaAllocated types and explicit allocations go to the arena; nothing is bound here anyway.
+  Node* heapNode = new Node;
+  int* heapInt;
+  {
+    Arena::Scope scope{&arena};
+    heapInt = new int(5);
+  }
+  EXPECT_EQ(Arena::FindOwner(heapNode), nullptr);
+  EXPECT_EQ(Arena::FindOwner(heapInt), nullptr);
+  EXPECT_EQ(Arena::FindOwner(node), &arena);
+  delete heapNode;
+  delete heapInt;
+}
+
+TEST(Arena, FreedBlocksAreReused)
+{
+  Arena arena{size_t(64) << 20};
+  Arena::Scope scope{&arena};
+  void* a = ArenaAllocate(100, 16);
+  const size_t used = arena.GetUsedBytes();
+  // replacing state over and over (a waveform core per automation step) stays at its peak.
+  for (int i = 0; i < 1000; i++)
+  {
+    ArenaFree(a);
+    a = ArenaAllocate(90 + i % 20, 16);
+  }
+  EXPECT_EQ(arena.GetUsedBytes(), used);
+
+  // over-aligned payloads, in the same blocks.
+  void* b = ArenaAllocate(40, 64);
+  EXPECT_EQ((uintptr_t)b % 64, 0u);
+  ArenaFree(b);
+  void* c = ArenaAllocate(40, 64);
+  EXPECT_EQ(c, b);
+  ArenaFree(c);
+  ArenaFree(a);
+}
+
+TEST(Arena, AccountsByOwnerAndSubsystem)
+{
+  Arena arena{size_t(64) << 20};
+  arena.EnableAccounting(2);
+  int* a;
+  int* b;
+  int* c;
+  {
+    Arena::Scope scope{&arena};
+    {
+      Arena::OwnerScope owner{1};
+      a = ArenaNewArray<int>(4);
+      ArenaSubsystemScope subsystem{MemorySubsystem::Voices};
+      b = ArenaNewArray<int>(8);
+    }
+    c = ArenaNewArray<int>(2);  // unowned
+  }
+  EXPECT_EQ(arena.GetAccountedBytes(1, MemorySubsystem::Other), sizeof(int) * 4);
+  EXPECT_EQ(arena.GetAccountedBytes(1, MemorySubsystem::Voices), sizeof(int) * 8);
+  EXPECT_EQ(arena.GetAccountedBytes(0, MemorySubsystem::Other), 0u);
+  EXPECT_EQ(arena.GetAccountedBytes(-1, MemorySubsystem::Other), sizeof(int) * 2);
+  // an owner's small allocations are packed into its own chunk.
+  EXPECT_LT((uint8_t*)b - (uint8_t*)a, 128);
+  EXPECT_TRUE(arena.Contains(c));
+
+  // freeing takes the bytes back off the account they were charged to, whatever is bound now.
+  ArenaFree(b);
+  EXPECT_EQ(arena.GetAccountedBytes(1, MemorySubsystem::Voices), 0u);
+  EXPECT_EQ(arena.GetAccountedBytes(1, MemorySubsystem::Other), sizeof(int) * 4);
+  ArenaFree(a);
+  ArenaFree(c);
+  EXPECT_EQ(arena.GetAccountedBytes(1, MemorySubsystem::Other), 0u);
+  EXPECT_EQ(arena.GetAccountedBytes(-1, MemorySubsystem::Other), 0u);
+}
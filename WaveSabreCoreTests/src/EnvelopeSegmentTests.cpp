@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <WaveSabreCore/../../DSP/Maj7Envelope.hpp>
+#include <WaveSabreCore/../../GigaSynth/Maj7Basic.hpp>
+
+using namespace WaveSabreCore;
+using namespace WaveSabreCore::M7;
+
+namespace
+{
+// an envelope with its own params and (unmodulated) mod matrix.
+struct TestEnvelope
+{
+  ModMatrixNode mModMatrix;
+  float mParamCache[(int)EnvParamIndexOffsets::Count] = {};
+  EnvelopeNode mEnv{mModMatrix, mParamCache, {ModDestination::Env1DelayTime, (GigaSynthParamIndices)0, ModSource::ModEnv1}};
+
+  explicit TestEnvelope(EnvelopeMode mode)
+  {
+    ParamAccessor p{mParamCache, 0};
+    p.SetPowCurvedValue(EnvParamIndexOffsets::DelayTime, gEnvTimeCfg, 3);
+    p.SetPowCurvedValue(EnvParamIndexOffsets::AttackTime, gEnvTimeCfg, 20);
+    p.SetN11Value(EnvParamIndexOffsets::AttackCurve, 0.4f);
+    p.SetPowCurvedValue(EnvParamIndexOffsets::HoldTime, gEnvTimeCfg, 7);
+    p.SetPowCurvedValue(EnvParamIndexOffsets::DecayTime, gEnvTimeCfg, 45);
+    p.SetN11Value(EnvParamIndexOffsets::DecayCurve, -0.5f);
+    p.Set01Val(EnvParamIndexOffsets::SustainLevel, 0.6f);
+    p.SetPowCurvedValue(EnvParamIndexOffsets::ReleaseTime, gEnvTimeCfg, 30);
+    p.SetN11Value(EnvParamIndexOffsets::ReleaseCurve, -0.3f);
+    p.SetEnumValue(EnvParamIndexOffsets::Mode, mode);
+  }
+};
+
+// what Maj7Voice does: events between blocks, BeginBlock() at the start of each, and segments capped at the
+// block end. returns every sample the envelope produced while it was playing.
+std::vector<float> Render(bool segments, EnvelopeMode mode, int noteOffAtBlock)
+{
+  static const int kBlockSizes[] = {37, 256, 5, 128, 1, 300, 64, 3, 190};
+  TestEnvelope t{mode};
+  std::vector<float> out;
+  t.mEnv.EnvelopeNoteOn(VoiceNoteOnFlags::None);
+  for (int block = 0; block < 200 && t.mEnv.IsPlaying(); ++block)
+  {
+    if (block == noteOffAtBlock)
+      t.mEnv.EnvelopeNoteOff();
+    t.mEnv.BeginBlock();
+    const int n = kBlockSizes[block % std::size(kBlockSizes)];
+    float seg[EnvelopeNode::gMaxSegmentSamples];
+    int segLength = 0, segPos = 0;
+    for (int i = 0; i < n && t.mEnv.IsPlaying(); ++i)
+    {
+      if (!segments)
+      {
+        out.push_back(t.mEnv.ProcessSample());
+        continue;
+      }
+      if (segPos == segLength)
+      {
+        const int left = n - i;
+        segLength = t.mEnv.ProcessSegment(seg, left < EnvelopeNode::gMaxSegmentSamples ? left : EnvelopeNode::gMaxSegmentSamples);
+        segPos = 0;
+        EXPECT_GE(segLength, 1);
+        EXPECT_LE(segLength, left);
+      }
+      out.push_back(seg[segPos++]);
+    }
+  }
+  return out;
+}
+}  // namespace
+
+TEST(EnvelopeSegment, MatchesPerSampleProcessing)
+{
+  const auto previousQuality = GetQualitySetting();
+  for (int quality = 0; quality < (int)QualitySetting::Count; ++quality)
+  {
+    SetQualitySetting((QualitySetting)quality);
+    for (auto mode : {EnvelopeMode::Sustain, EnvelopeMode::OneShot})
+    {
+      for (int noteOffAtBlock : {1, 6, 20})
+      {
+        auto expected = Render(false, mode, noteOffAtBlock);
+        auto actual = Render(true, mode, noteOffAtBlock);
+        // every stage, through to idle.
+        ASSERT_GT(expected.size(), 1000u);
+        ASSERT_EQ(actual.size(), expected.size()) << "quality " << quality << " note off at block " << noteOffAtBlock;
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+          ASSERT_EQ(actual[i], expected[i]) << "quality " << quality << " note off at block " << noteOffAtBlock
+                                            << " sample " << i;
+        }
+      }
+    }
+  }
+  SetQualitySetting(previousQuality);
+}
+
+TEST(EnvelopeSegment, IdleFillsTheWholeRun)
+{
+  TestEnvelope t{EnvelopeMode::Sustain};
+  float seg[EnvelopeNode::gMaxSegmentSamples];
+  for (auto& s : seg)
+    s = 1;
+  EXPECT_EQ(t.mEnv.ProcessSegment(seg, 50), 50);
+  for (int i = 0; i < 50; ++i)
+    EXPECT_EQ(seg[i], 0);
+}
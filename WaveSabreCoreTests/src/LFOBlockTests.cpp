@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <WaveSabreCore/../../GigaSynth/Maj7Oscillator3.hpp>
+
+using namespace WaveSabreCore;
+using namespace WaveSabreCore::M7;
+
+// LFOs render the first sample of each block and skip over the rest with advanceWithoutRendering().
+// that must land where rendering every sample does, for cores that override it (pure functions of phase)
+// and for those that don't. noise cores share the global RNG, so they can't be compared this way.
+TEST(LFOBlock, SkippingMatchesRenderingEverySample)
+{
+  static const OscillatorWaveform kWaveforms[] = {
+      OscillatorWaveform::SineDCClip,
+      OscillatorWaveform::SineClipSqueeze,
+      OscillatorWaveform::SineHarmDCClip,
+      OscillatorWaveform::SineHarmClipSqueeze,
+      OscillatorWaveform::ShapeCoreSawTri,
+      OscillatorWaveform::ShapeCoreSawPulse2,
+      OscillatorWaveform::ShapeCoreSawPulse3,
+      OscillatorWaveform::ShapeCoreSawTriSquare,
+      OscillatorWaveform::FoldedSine,
+  };
+  static const int kBlockSizes[] = {128, 1, 37, 64, 128, 5, 128, 16};
+
+  for (auto w : kWaveforms)
+  {
+    std::unique_ptr<OscillatorCore> everySample{InstantiateWaveformCore(w, OscillatorIntention::LFO)};
+    std::unique_ptr<OscillatorCore> blocks{InstantiateWaveformCore(w, OscillatorIntention::LFO)};
+    everySample->SetKRateParams(0.3f, 0.6f, 37.0f, false, 1);
+    blocks->SetKRateParams(0.3f, 0.6f, 37.0f, false, 1);
+
+    // a few seconds, so the phase wraps many times.
+    int sampleIndex = 0;
+    for (int iblock = 0; sampleIndex < 200000; ++iblock)
+    {
+      const int n = kBlockSizes[iblock % std::size(kBlockSizes)];
+      const float expected = everySample->renderSampleAndAdvance(0).amplitude;
+      for (int i = 1; i < n; ++i)
+      {
+        everySample->renderSampleAndAdvance(0);
+      }
+
+      const float actual = blocks->renderSampleAndAdvance(0).amplitude;
+      blocks->advanceWithoutRendering(n - 1, 0);
+
+      ASSERT_NEAR(actual, expected, 1e-4f) << "waveform " << (int)w << " at sample " << sampleIndex;
+      sampleIndex += n;
+    }
+  }
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include <WaveSabreCore/../../Basic/MathKernels.hpp>
+
+using namespace WaveSabreCore;
+using namespace WaveSabreCore::M7;
+
+namespace
+{
+std::vector<float> MakeRamp(int n, float lo, float hi)
+{
+  std::vector<float> ret(n);
+  for (int i = 0; i < n; ++i)
+  {
+    // a non-uniform step so lanes don't all land on the same table phase
+    const float t = float(i) / (n - 1);
+    ret[i] = lo + (hi - lo) * (t + 0.013f * std::sin(i * 1.7f) * (1 - t) * t);
+  }
+  return ret;
+}
+
+struct Case
+{
+  const char* name;
+  float lo, hi;
+  void (*arrayFn)(const float*, float*, int);
+  float (*scalarFn)(float);
+  double (*referenceFn)(double);
+  bool relative;
+  double maxError;
+};
+
+// the tanh table spans [-pi, pi] and clamps outside it, so it's only measured inside.
+const Case gCases[] = {
+    {"sin", -40, 40, math::sin_n, [](float x) { return math::sin(x); }, [](double x) { return std::sin(x); }, false, 1e-5},
+    {"cos", -40, 40, math::cos_n, [](float x) { return math::cos(x); }, [](double x) { return std::cos(x); }, false, 1e-5},
+    {"tanh", -3, 3, math::tanh_n, [](float x) { return math::tanh(x); }, [](double x) { return std::tanh(x); }, false, 1e-5},
+    {"pow2", -16, 16, math::pow2_n, math::pow2_N16_16, [](double x) { return std::pow(2.0, x); }, true, 1e-5},
+};
+}  // namespace
+
+// the array kernels must be drop-in replacements for the scalar calls, including the odd tail.
+TEST(MathKernels, ArrayMatchesScalar)
+{
+  math::EnsureLUTsInitialized();
+  for (auto& c : gCases)
+  {
+    auto in = MakeRamp(1003, c.lo * 1.1f, c.hi * 1.1f);  // a little past the table range
+    std::vector<float> out(in.size());
+    c.arrayFn(in.data(), out.data(), (int)in.size());
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+      ASSERT_NEAR(out[i], c.scalarFn(in[i]), std::abs(out[i]) * 1e-6f + 1e-7f) << c.name << " x=" << in[i];
+    }
+  }
+
+  auto x = MakeRamp(1003, -1.2f, 1.2f);
+  auto k = MakeRamp(1003, 1.1f, -1.1f);
+  std::vector<float> out(x.size()), outFixedK(x.size());
+  math::curve_n(x.data(), k.data(), out.data(), (int)x.size());
+  math::curve_n(x.data(), 0.37f, outFixedK.data(), (int)x.size());
+  for (size_t i = 0; i < x.size(); ++i)
+  {
+    ASSERT_NEAR(out[i], math::modCurve_xN11_kN11(x[i], k[i]), 1e-6f) << "curve x=" << x[i] << " k=" << k[i];
+    ASSERT_NEAR(outFixedK[i], math::modCurve_xN11_kN11(x[i], 0.37f), 1e-6f) << "curve x=" << x[i];
+  }
+}
+
+TEST(MathKernels, AccuracyAgainstCrt)
+{
+  math::EnsureLUTsInitialized();
+  for (auto& c : gCases)
+  {
+    auto in = MakeRamp(100001, c.lo, c.hi);
+    std::vector<float> out(in.size());
+    c.arrayFn(in.data(), out.data(), (int)in.size());
+    double maxError = 0;
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+      const double ref = c.referenceFn(in[i]);
+      double e = std::abs(out[i] - ref);
+      if (c.relative)
+        e /= ref;
+      maxError = (e > maxError) ? e : maxError;
+    }
+    EXPECT_LT(maxError, c.maxError) << c.name;
+  }
+}
+
+// throughput comparison: run with --gtest_also_run_disabled_tests in an optimized build.
+TEST(MathKernels, DISABLED_Benchmark)
+{
+  math::EnsureLUTsInitialized();
+  constexpr int kBlock = 256;
+  constexpr int kIterations = 20000;
+  using Clock = std::chrono::steady_clock;
+
+  for (auto& c : gCases)
+  {
+    auto in = MakeRamp(kBlock, c.lo, c.hi);
+    std::vector<float> out(kBlock);
+    volatile float sink = 0;
+
+    auto t0 = Clock::now();
+    for (int it = 0; it < kIterations; ++it)
+    {
+      for (int i = 0; i < kBlock; ++i)
+        out[i] = c.scalarFn(in[i]);
+      sink = sink + out[it & (kBlock - 1)];
+    }
+    auto t1 = Clock::now();
+    for (int it = 0; it < kIterations; ++it)
+    {
+      c.arrayFn(in.data(), out.data(), kBlock);
+      sink = sink + out[it & (kBlock - 1)];
+    }
+    auto t2 = Clock::now();
+    for (int it = 0; it < kIterations; ++it)
+    {
+      for (int i = 0; i < kBlock; ++i)
+        out[i] = (float)c.referenceFn(in[i]);
+      sink = sink + out[it & (kBlock - 1)];
+    }
+    auto t3 = Clock::now();
+
+    const double samples = double(kBlock) * kIterations;
+    auto ns = [&](Clock::duration d) { return std::chrono::duration<double, std::nano>(d).count() / samples; };
+    printf("%-6s scalar LUT %6.2f ns   array %6.2f ns   crt %6.2f ns\n", c.name, ns(t1 - t0), ns(t2 - t1), ns(t3 - t2));
+  }
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <format>
+#include <memory>
 
 #include <WaveSabreCore/../../Basic/Helpers.h>
 #include <WaveSabreCore/../../GigaSynth/Maj7Basic.hpp>
@@ -303,3 +304,18 @@ TEST(ShapeTests, TwoSegmentShapeWalking)
   //  EXPECT_EQ(encounters, 3);
   //}
 }
+
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+TEST(MathTests, ParallelCurveLUTMatchesSerial)
+{
+  M7::math::EnsureLUTsInitialized();
+  ASSERT_NE(M7::math::gLuts, nullptr);
+
+  auto serial = std::make_unique<M7::math::CurveLUT>();
+  serial->FillRows(0, M7::math::gLutSize2D);
+  for (size_t i = 0; i < M7::math::gLutSize2D * M7::math::gLutSize2D; ++i)
+  {
+    ASSERT_EQ(serial->mpTable[i], M7::math::gLuts->gCurveLUT.mpTable[i]) << "index " << i;
+  }
+}
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
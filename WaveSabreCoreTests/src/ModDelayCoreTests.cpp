@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <WaveSabreCore/../../DSP/ModDelayCore.hpp>
+#include <WaveSabreCore/../../Basic/Helpers.h>
+
+using namespace WaveSabreCore;
+using namespace WaveSabreCore::M7;
+
+namespace
+{
+struct Stereo
+{
+  std::vector<float> l, r;
+  explicit Stereo(int n) : l(n), r(n) {}
+  float* const* Ptrs()
+  {
+    ptrs[0] = l.data();
+    ptrs[1] = r.data();
+    return ptrs;
+  }
+  float* ptrs[2];
+};
+
+// runs in uneven chunks, so blocks don't always line up with the core's LFO blocks.
+Stereo RunWet(ModDelayCore& core, Stereo& in)
+{
+  const int n = (int)in.l.size();
+  Stereo out{n};
+  for (int offset = 0, chunk = 1; offset < n; offset += chunk, chunk = chunk % 37 + 5)
+  {
+    if (chunk > n - offset)
+      chunk = n - offset;
+    const float* ip[2] = {in.l.data() + offset, in.r.data() + offset};
+    float* op[2] = {out.l.data() + offset, out.r.data() + offset};
+    core.Run(ip, op, chunk, 0, 1);
+  }
+  return out;
+}
+
+float DelayMsForSamples(float samples)
+{
+  return samples * 1000 / Helpers::CurrentSampleRateF();
+}
+}  // namespace
+
+TEST(ModDelayCore, StaticDelayReadsThePast)
+{
+  // unmodulated, every voice reads the same tap, so the mix is that tap: a 4-point cubic read of the input
+  // 10.25 samples ago. at this frequency that's accurate to well under 1e-4.
+  const float delaySamples = 10.25f;
+  for (int voices = 1; voices <= ModDelayCore::gVoiceCount; ++voices)
+  {
+    ModDelayCore core;
+    core.mVoices = voices;
+    core.mDepth = 0;
+    core.mDelayMs = DelayMsForSamples(delaySamples);
+
+    const int n = 2000;
+    Stereo in{n};
+    for (int i = 0; i < n; ++i)
+    {
+      in.l[i] = (float)std::sin(i * 0.02);
+      in.r[i] = (float)std::cos(i * 0.03);
+    }
+    Stereo out = RunWet(core, in);
+    for (int i = 20; i < n; ++i)
+    {
+      ASSERT_NEAR(out.l[i], std::sin((i - delaySamples) * 0.02), 1e-4) << "voices " << voices << " at " << i;
+      ASSERT_NEAR(out.r[i], std::cos((i - delaySamples) * 0.03), 1e-4) << "voices " << voices << " at " << i;
+    }
+  }
+}
+
+TEST(ModDelayCore, FeedbackRepeatsDecay)
+{
+  ModDelayCore core;
+  core.mDepth = 0;
+  core.mDelayMs = DelayMsForSamples(100);
+  core.mFeedback = -0.5f;
+
+  Stereo in{1000};
+  in.l[0] = in.r[0] = 1;
+  Stereo out = RunWet(core, in);
+  float expected = 1;
+  for (int repeat = 1; repeat * 100 < 1000; ++repeat)
+  {
+    EXPECT_NEAR(out.l[repeat * 100], expected, 1e-4) << "repeat " << repeat;
+    EXPECT_NEAR(out.r[repeat * 100], expected, 1e-4) << "repeat " << repeat;
+    EXPECT_NEAR(out.l[repeat * 100 + 50], 0, 1e-4);
+    expected *= -0.5f;
+  }
+}
+
+TEST(ModDelayCore, ModulationStaysInsideTheLine)
+{
+  // the longest delay at full depth and feedback, fast LFO, all voices: taps must stay inside the line
+  // and the output bounded.
+  ModDelayCore core;
+  core.mVoices = ModDelayCore::gVoiceCount;
+  core.mDelayMs = ModDelayCore::gMaxDelayMs;
+  core.mDepth = 1;
+  core.mRateHz = 15;
+  core.mVoiceSpread = 1;
+  core.mStereoPhase = 1;
+  core.mFeedback = -0.95f;
+
+  const int n = 44100 * 2;
+  Stereo in{n};
+  unsigned seed = 1;
+  for (int i = 0; i < n; ++i)
+  {
+    seed = seed * 1664525 + 1013904223;
+    in.l[i] = in.r[i] = ((seed >> 9) / float(1 << 23)) * 2 - 1;
+  }
+  Stereo out = RunWet(core, in);
+  float peak = 0;
+  for (int i = 0; i < n; ++i)
+  {
+    ASSERT_TRUE(std::isfinite(out.l[i]) && std::isfinite(out.r[i])) << i;
+    peak = std::max(peak, std::max(std::abs(out.l[i]), std::abs(out.r[i])));
+  }
+  EXPECT_LT(peak, 40);
+  EXPECT_GT(peak, 0.1f);
+}
+
+TEST(ModDelayCore, LineFollowsSampleRateChanges)
+{
+  // built at 44.1k, then the host switches to 192k: the longest delay must still be reachable, not clamped
+  // to the line sized at construction.
+  ModDelayCore* core;
+  {
+    const RenderContext ctx44{44100, 120};
+    RenderContext::Scope scope{ctx44};
+    core = new ModDelayCore();
+  }
+  core->mDepth = 0;
+  core->mDelayMs = ModDelayCore::gMaxDelayMs;
+
+  const RenderContext ctx192{192000, 120};
+  RenderContext::Scope scope{ctx192};
+  const int delaySamples = 192000 * (int)ModDelayCore::gMaxDelayMs / 1000;
+  Stereo in{delaySamples + 100};
+  in.l[0] = in.r[0] = 1;
+  Stereo out = RunWet(*core, in);
+  delete core;
+  int peakAt = 0;
+  for (int i = 0; i < (int)out.l.size(); ++i)
+  {
+    if (std::abs(out.l[i]) > std::abs(out.l[peakAt]))
+      peakAt = i;
+  }
+  EXPECT_EQ(peakAt, delaySamples);
+}
+
+TEST(ModDelayCore, PhaserStagesAreAllpass)
+{
+  // with no feedback the chain is allpass: an impulse comes out with the same energy, just smeared in time.
+  for (int stages = 1; stages <= ModDelayCore::gMaxStages; ++stages)
+  {
+    ModDelayCore core;
+    core.mMode = ModDelayCore::Mode::Phaser;
+    core.mStages = stages;
+    core.mDepth = 0;
+    core.mCenterHz = 800;
+
+    Stereo in{8192};
+    in.l[0] = in.r[0] = 1;
+    Stereo out = RunWet(core, in);
+    double energy = 0;
+    for (float s : out.l)
+    {
+      energy += (double)s * s;
+    }
+    EXPECT_NEAR(energy, 1, 1e-3) << stages << " stages";
+    EXPECT_LT(std::abs(out.l[0]), 1) << stages << " stages";
+  }
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "../../WaveSabrePlayerLib/include/WaveSabrePlayerLib/PlaybackScheduler.hpp"
+
+using WSPlayerApp::PlaybackScheduler;
+using Action = PlaybackScheduler::Action;
+
+namespace
+{
+constexpr int32_t kSampleRate = 44100;
+constexpr int32_t kSongFrames = kSampleRate * 120;
+constexpr uint32_t kMaxPrecalcMs = 30000;
+
+// renders and plays on a simulated 10ms clock. renderSpeed(frame) is the render speed (x real-time)
+// at that point of the song. returns the time playback started, or -1 if it never did.
+struct Simulation
+{
+  PlaybackScheduler scheduler{kSongFrames, kSampleRate, kMaxPrecalcMs};
+  double rendered = 0;
+  double played = 0;
+  bool playing = false;
+  bool everPlayed = false;
+  int startMs = -1;
+  int pauses = 0;
+  int qualityDrops = 0;
+  bool underrun = false;
+
+  template <typename TSpeed>
+  void Run(TSpeed renderSpeed, double speedupPerQualityDrop = 1)
+  {
+    constexpr int kStepMs = 10;
+    for (uint32_t now = kStepMs; played < kSongFrames && now < 1000000; now += kStepMs)
+    {
+      double speed = renderSpeed(rendered);
+      for (int i = 0; i < qualityDrops; i++)
+        speed *= speedupPerQualityDrop;
+      rendered = std::min<double>(kSongFrames, rendered + speed * kSampleRate * kStepMs / 1000);
+      scheduler.OnRendered(now, (int64_t)rendered);
+      if (playing)
+      {
+        played += kSampleRate * kStepMs / 1000;
+        if (played > rendered && rendered < kSongFrames)
+          underrun = true;
+      }
+      switch (scheduler.Decide(now, playing, (int64_t)played, true))
+      {
+        case Action::Play:
+          if (!everPlayed)
+            startMs = now;
+          everPlayed = playing = true;
+          break;
+        case Action::Pause:
+          pauses++;
+          playing = false;
+          break;
+        case Action::LowerQuality:
+          qualityDrops++;
+          break;
+        case Action::Wait:
+          break;
+      }
+    }
+  }
+};
+}  // namespace
+
+TEST(PlaybackScheduler, FastRenderStartsAlmostImmediately)
+{
+  Simulation sim;
+  sim.Run([](double) { return 4.0; });
+  EXPECT_GE(sim.startMs, (int)PlaybackScheduler::kMinModelMilliseconds);
+  EXPECT_LT(sim.startMs, 2000);
+  EXPECT_FALSE(sim.underrun);
+  EXPECT_EQ(sim.pauses, 0);
+}
+
+TEST(PlaybackScheduler, SlowRenderWaitsJustLongEnough)
+{
+  // at 0.5x, the whole song takes 240s to render; playing takes 120s, so ~120s of precalc are needed.
+  // that's past the max precalc time; the fallback starts early and playback has to pause once.
+  Simulation sim;
+  sim.Run([](double) { return 0.5; });
+  EXPECT_EQ(sim.startMs, (int)kMaxPrecalcMs);
+  EXPECT_FALSE(sim.underrun);
+  EXPECT_EQ(sim.pauses, 1);
+
+  // 0.8x needs ~30s; the model should start no later than the fallback and never pause.
+  Simulation sim2;
+  sim2.Run([](double) { return 0.8; });
+  EXPECT_GE(sim2.startMs, 28000);
+  EXPECT_LE(sim2.startMs, (int)kMaxPrecalcMs);
+  EXPECT_FALSE(sim2.underrun);
+}
+
+TEST(PlaybackScheduler, SlowdownLowersQualityBeforePausing)
+{
+  // fast start, then a section that renders at 0.7x. each quality drop makes rendering 1.3x faster.
+  Simulation sim;
+  sim.Run([](double frame) { return frame < kSampleRate * 20 ? 3.0 : 0.7; }, 1.3);
+  EXPECT_LT(sim.startMs, 2000);
+  EXPECT_GE(sim.qualityDrops, 1);
+  EXPECT_EQ(sim.pauses, 0);
+  EXPECT_FALSE(sim.underrun);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "../../WaveSabrePlayerLib/include/WaveSabrePlayerLib/QualityGovernor.h"
+
+using WaveSabrePlayerLib::QualityGovernor;
+
+namespace
+{
+constexpr double kBlockMs = 5.8;  // 256 frames at 44.1kHz
+
+struct Transition
+{
+  int from;
+  int to;
+  double atMs;
+};
+
+// replays a synthetic trace of 5.8ms blocks. load(t, level) is the render time / deadline of the block at t
+// when running at that level; each level below full quality is assumed to cost a fixed fraction less.
+struct Trace
+{
+  QualityGovernor governor;
+  std::vector<Transition> transitions;
+  double nowMs = 0;
+  int overruns = 0;  // blocks that missed their deadline
+
+  explicit Trace(int levelCount) : governor(levelCount, OnTransition, this) {}
+
+  static void OnTransition(int from, int to, double, void* data)
+  {
+    auto* t = (Trace*)data;
+    t->transitions.push_back({from, to, t->nowMs});
+  }
+
+  template <typename TLoad>
+  void Run(double durationMs, TLoad load)
+  {
+    for (double end = nowMs + durationMs; nowMs < end; nowMs += kBlockMs)
+    {
+      double l = load(nowMs, governor.GetLevel());
+      if (l > 1)
+        overruns++;
+      governor.OnBlock(nowMs, l * kBlockMs, kBlockMs);
+    }
+  }
+};
+
+double Scaled(double fullQualityLoad, int level)
+{
+  double l = fullQualityLoad;
+  for (int i = 0; i < level; i++)
+    l *= 0.8;
+  return l;
+}
+}  // namespace
+
+TEST(QualityGovernor, LightLoadNeverDegrades)
+{
+  Trace trace{6};
+  trace.Run(20000, [](double t, int) { return 0.3 + 0.2 * ((int)(t / 100) % 2); });  // jittery, but under 0.8
+  EXPECT_EQ(trace.governor.GetLevel(), 0);
+  EXPECT_TRUE(trace.transitions.empty());
+}
+
+TEST(QualityGovernor, DenseSectionDegradesThenRecovers)
+{
+  Trace trace{6};
+  trace.Run(5000, [](double, int level) { return Scaled(0.4, level); });
+  // a dense section that needs two steps down to fit.
+  trace.Run(10000, [](double, int level) { return Scaled(0.95, level); });
+  EXPECT_GE(trace.governor.GetLevel(), 1);
+  EXPECT_LE(trace.governor.GetLevel(), 2);
+  EXPECT_LT(trace.overruns, 5);
+  // hysteresis: it settles rather than flapping for the rest of the section.
+  int settledAt = (int)trace.transitions.size();
+  trace.Run(10000, [](double, int level) { return Scaled(0.95, level); });
+  EXPECT_EQ((int)trace.transitions.size(), settledAt);
+
+  // light again; it climbs back up to full quality, one level at a time, no faster than the hold time.
+  trace.Run(30000, [](double, int level) { return Scaled(0.3, level); });
+  EXPECT_EQ(trace.governor.GetLevel(), 0);
+  for (size_t i = 1; i < trace.transitions.size(); i++)
+  {
+    EXPECT_EQ(std::abs(trace.transitions[i].to - trace.transitions[i].from), 1);
+    if (trace.transitions[i].to < trace.transitions[i].from)
+    {
+      EXPECT_GE(trace.transitions[i].atMs - trace.transitions[i - 1].atMs, QualityGovernor::RecoverHoldMs);
+    }
+  }
+}
+
+TEST(QualityGovernor, SpikeOverTheDeadlineStepsDownImmediately)
+{
+  Trace trace{3};
+  trace.Run(1000, [](double, int) { return 0.3; });
+  trace.Run(kBlockMs, [](double, int) { return 1.5; });
+  EXPECT_EQ(trace.governor.GetLevel(), 1);
+  // and never below the last level.
+  trace.Run(5000, [](double, int) { return 2.0; });
+  EXPECT_EQ(trace.governor.GetLevel(), 2);
+  EXPECT_FALSE(trace.governor.StepDown(trace.nowMs));
+}
+
+TEST(QualityGovernor, ShortBlocksCarryLessWeight)
+{
+  QualityGovernor governor{3};
+  for (double t = 0; t < 1000; t += 20)
+    governor.OnBlock(t, 0.3 * 20, 20);
+  // a few frames at a high (but not overrunning) load barely move the average; a long block moves it more.
+  governor.OnBlock(1000, 0.95 * 0.1, 0.1);
+  EXPECT_NEAR(governor.GetSmoothedLoad(), 0.3, 0.01);
+  EXPECT_EQ(governor.GetLevel(), 0);
+  governor.OnBlock(1020, 0.95 * 100, 100);
+  EXPECT_GT(governor.GetSmoothedLoad(), 0.8);
+  EXPECT_EQ(governor.GetLevel(), 1);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include <WaveSabreCore/../../Analysis/RealFFT.hpp>
+
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+
+using namespace WaveSabreCore;
+
+// reference O(N^2) DFT in double precision
+static void NaiveDFT(const std::vector<float>& x, std::vector<double>& re, std::vector<double>& im)
+{
+  const int n = (int)x.size();
+  re.assign(n / 2 + 1, 0);
+  im.assign(n / 2 + 1, 0);
+  for (int k = 0; k <= n / 2; ++k)
+  {
+    for (int t = 0; t < n; ++t)
+    {
+      const double a = -2.0 * 3.14159265358979323846 * k * t / n;
+      re[k] += x[t] * std::cos(a);
+      im[k] += x[t] * std::sin(a);
+    }
+  }
+}
+
+TEST(RealFFT, MatchesNaiveDFT)
+{
+  for (int n : {4, 8, 16, 64, 512, 2048})
+  {
+    std::vector<float> x(n);
+    unsigned seed = 1234;
+    for (auto& s : x)
+    {
+      seed = seed * 1664525u + 1013904223u;
+      s = (float)((seed >> 8) & 0xffff) / 32768.0f - 1.0f;
+    }
+
+    RealFFT fft(n);
+    ASSERT_EQ(fft.GetBinCount(), n / 2 + 1);
+    fft.Forward(x.data(), nullptr);
+
+    std::vector<double> re, im;
+    NaiveDFT(x, re, im);
+    const double tol = 1e-4 * n;
+    for (int k = 0; k <= n / 2; ++k)
+    {
+      EXPECT_NEAR(fft.Real()[k], re[k], tol) << "n=" << n << " k=" << k;
+      EXPECT_NEAR(fft.Imag()[k], im[k], tol) << "n=" << n << " k=" << k;
+    }
+  }
+}
+
+TEST(RealFFT, WindowIsAppliedDuringGather)
+{
+  const int n = 256;
+  std::vector<float> x(n), w(n), xw(n);
+  for (int i = 0; i < n; ++i)
+  {
+    x[i] = std::sin(0.3f * i) + 0.25f;
+    w[i] = 0.5f * (1.0f - std::cos(6.2831853f * i / (n - 1)));
+    xw[i] = x[i] * w[i];
+  }
+
+  RealFFT a(n), b(n);
+  a.Forward(x.data(), w.data());
+  b.Forward(xw.data(), nullptr);
+  for (int k = 0; k < a.GetBinCount(); ++k)
+  {
+    EXPECT_FLOAT_EQ(a.Real()[k], b.Real()[k]);
+    EXPECT_FLOAT_EQ(a.Imag()[k], b.Imag()[k]);
+  }
+}
+
+TEST(RealFFT, TablesAreSharedPerSize)
+{
+  EXPECT_EQ(&RealFFT::GetTables(1024), &RealFFT::GetTables(1024));
+  EXPECT_NE(&RealFFT::GetTables(1024), &RealFFT::GetTables(2048));
+}
+
+TEST(RealFFT, SineLandsInItsBin)
+{
+  const int n = 1024;
+  const int bin = 37;
+  std::vector<float> x(n);
+  for (int i = 0; i < n; ++i)
+    x[i] = std::cos(2.0 * 3.14159265358979323846 * bin * i / n);
+
+  RealFFT fft(n);
+  fft.Forward(x.data(), nullptr);
+  std::vector<float> mag(fft.GetBinCount());
+  fft.Magnitudes(mag.data());
+  EXPECT_NEAR(mag[bin], n * 0.5f, 1e-2f);
+  EXPECT_NEAR(mag[bin + 3], 0.0f, 1e-2f);
+}
+
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
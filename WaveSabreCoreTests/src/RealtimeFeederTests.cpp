@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "../../WaveSabrePlayerLib/include/WaveSabrePlayerLib/RealtimeFeeder.h"
+
+using namespace WaveSabrePlayerLib;
+
+namespace
+{
+constexpr int kSampleRate = 44100;
+
+// a looping buffer whose play cursor follows a fake clock. rendering advances the clock by costRatio times the
+// audio it produces, so the play cursor moves while a chunk renders, like a real device.
+struct FakeOutput : IRealtimeOutput
+{
+  std::vector<int16_t> ring;
+  double nowMs = 0;
+  double costRatio = 0;
+  double fixedCostMs = 0;  // per callback, like a graph dispatch
+  int64_t framesWritten = 0;
+  int64_t nextValue = 0;
+  bool underrun = false;
+  bool misordered = false;
+  int renderCalls = 0;
+
+  explicit FakeOutput(int bufferMs) : ring((size_t)kSampleRate * bufferMs / 1000 * 2) {}
+
+  int64_t PlayedFrames() const { return (int64_t)(nowMs * kSampleRate / 1000); }
+  int BufferFrames() const { return (int)ring.size() / 2; }
+
+  int GetBufferSizeBytes() override { return (int)ring.size() * 2; }
+  int GetPlayCursorBytes() override { return (int)(PlayedFrames() % BufferFrames()) * 4; }
+  bool Lock(int offsetBytes, int bytes, int16_t** p1, int* b1, int16_t** p2, int* b2) override
+  {
+    int size = GetBufferSizeBytes();
+    *p1 = &ring[offsetBytes / 2];
+    *b1 = std::min(bytes, size - offsetBytes);
+    *b2 = bytes - *b1;
+    *p2 = *b2 ? &ring[0] : nullptr;
+    return true;
+  }
+  void Unlock(int16_t*, int b1, int16_t*, int b2) override
+  {
+    framesWritten += (b1 + b2) / 4;
+    // the write must land before the play cursor comes around to it.
+    if (PlayedFrames() > framesWritten + BufferFrames())
+      underrun = true;
+  }
+  double GetTimeMs() override { return nowMs; }
+
+  static void Render(int16_t* buffer, int numSamples, void* data)
+  {
+    auto* o = (FakeOutput*)data;
+    for (int i = 0; i < numSamples; i += 2)
+    {
+      buffer[i] = buffer[i + 1] = (int16_t)o->nextValue++;
+    }
+    o->nowMs += o->fixedCostMs + o->costRatio * (numSamples / 2) * 1000.0 / kSampleRate;
+    o->renderCalls++;
+  }
+
+  // services every 3ms, like DirectSoundRenderThread, for durationMs.
+  void Run(RealtimeFeeder& feeder, double durationMs)
+  {
+    while (nowMs < durationMs && !underrun)
+    {
+      feeder.Service(*this);
+      nowMs += 3;
+    }
+    // everything written is the render stream in order.
+    int64_t base = framesWritten - BufferFrames();
+    for (int64_t f = std::max<int64_t>(0, base); f < framesWritten; f++)
+    {
+      if (ring[(f % BufferFrames()) * 2] != (int16_t)f)
+        misordered = true;
+    }
+  }
+};
+}  // namespace
+
+TEST(RealtimeFeeder, CheapRenderingUsesBigChunks)
+{
+  FakeOutput output{200};
+  output.costRatio = 0.2;
+  output.fixedCostMs = 0.3;
+  RealtimeFeeder feeder{FakeOutput::Render, &output, kSampleRate, 20, kSampleRate};
+  output.Run(feeder, 10000);
+
+  auto stats = feeder.GetStats();
+  EXPECT_FALSE(output.underrun);
+  EXPECT_FALSE(output.misordered);
+  EXPECT_GT(output.framesWritten, kSampleRate * 9);
+  // fixed 100-frame steps would be ~4400 dispatches for 10s.
+  EXPECT_LT(stats.Chunks, 1000);
+  EXPECT_LE(stats.LastChunkFrames, kSampleRate * 20 / 1000);
+  EXPECT_GT(stats.Callbacks, 0);
+  EXPECT_EQ(stats.Starved, 0);
+  EXPECT_GT(stats.MinHeadroomMs, 100);
+  EXPECT_NEAR(stats.RenderCostRatio, 0.2, 0.1);
+}
+
+TEST(RealtimeFeeder, SlowRenderingShrinksChunksToTheHeadroom)
+{
+  // the budget would allow 500ms chunks, but with rendering at 0.9x real-time only small ones keep up.
+  FakeOutput output{100};
+  output.costRatio = 0.9;
+  RealtimeFeeder feeder{FakeOutput::Render, &output, kSampleRate, 500, kSampleRate};
+  output.Run(feeder, 5000);
+
+  auto stats = feeder.GetStats();
+  EXPECT_FALSE(output.underrun);
+  EXPECT_FALSE(output.misordered);
+  // each chunk renders in at most half the audio that was queued.
+  EXPECT_LE(stats.LastChunkFrames * stats.RenderCostRatio, stats.LastHeadroomMs * kSampleRate / 1000 * 0.5 + 1);
+  EXPECT_LE(stats.MinHeadroomMs, stats.AverageHeadroomMs);
+}
+
+namespace
+{
+struct ServiceLog
+{
+  FakeOutput* output;
+  int services = 0;
+  double audioMs = 0;
+  double minAudioMs = 1e300;
+  double maxLoad = 0;
+
+  static void Render(int16_t* buffer, int numSamples, void* data)
+  {
+    FakeOutput::Render(buffer, numSamples, ((ServiceLog*)data)->output);
+  }
+  static void OnServiced(double, double renderMs, double audioMs, double, void* data)
+  {
+    auto* log = (ServiceLog*)data;
+    log->services++;
+    log->audioMs += audioMs;
+    log->minAudioMs = std::min(log->minAudioMs, audioMs);
+    log->maxLoad = std::max(log->maxLoad, renderMs / audioMs);
+  }
+};
+}  // namespace
+
+TEST(RealtimeFeeder, ReportsEachServiceOnce)
+{
+  // 1000 frames don't divide the ring, so chunks keep wrapping into two render callbacks.
+  FakeOutput output{100};
+  output.costRatio = 0.5;
+  output.fixedCostMs = 0.1;
+  ServiceLog log{&output};
+  RealtimeFeeder feeder{ServiceLog::Render, &log, kSampleRate, 23, kSampleRate, ServiceLog::OnServiced};
+  output.Run(feeder, 3000);
+
+  EXPECT_FALSE(output.underrun);
+  EXPECT_GT(output.renderCalls, feeder.GetStats().Chunks);
+  EXPECT_EQ(log.services, feeder.GetStats().Callbacks);
+  EXPECT_NEAR(log.audioMs, output.framesWritten * 1000.0 / kSampleRate, 1e-6);
+  // a wrapped chunk's tail is never timed on its own.
+  EXPECT_GE(log.minAudioMs, 100 * 1000.0 / kSampleRate);
+  EXPECT_LT(log.maxLoad, 1.5);
+}
+
+TEST(RenderChunkPlanner, ChunksFollowTheBudgetAndTheHeadroom)
+{
+  RenderChunkPlanner planner{kSampleRate, 10, 100, 1000};
+  // the first chunk is small, to measure.
+  EXPECT_EQ(planner.PlanChunkFrames(5000, 40000), 100);
+  planner.OnChunkRendered(100, 1.0);  // ~0.44x real-time
+  EXPECT_EQ(planner.PlanChunkFrames(5000, 40000), 441);
+  EXPECT_EQ(planner.PlanChunkFrames(300, 40000), 300);
+  // with 300 frames queued, a chunk may only take 150 frames' worth of time to render.
+  EXPECT_NEAR(planner.PlanChunkFrames(5000, 300), 340, 1);
+  EXPECT_EQ(planner.PlanChunkFrames(5000, 10), 100);
+
+  // plenty queued: hold off until a whole chunk is writable.
+  EXPECT_FALSE(planner.IsWorthRendering(300, 40000));
+  EXPECT_TRUE(planner.IsWorthRendering(441, 40000));
+  // little queued: take what there is.
+  EXPECT_TRUE(planner.IsWorthRendering(300, 600));
+}
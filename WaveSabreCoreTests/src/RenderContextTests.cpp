@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <WaveSabreCore/../../Basic/Helpers.h>
+
+using namespace WaveSabreCore;
+
+TEST(RenderContext, ScopeBindsPerThread)
+{
+  Helpers::SetSampleRate(44100);
+  const RenderContext ctx48{48000, 140};
+  const RenderContext ctx96{96000, 90};
+
+  float otherThreadRate = 0;
+  {
+    RenderContext::Scope scope{ctx48};
+    EXPECT_EQ(Helpers::CurrentSampleRateI(), 48000);
+    EXPECT_EQ(Helpers::CurrentTempo(), 140);
+    EXPECT_FLOAT_EQ(Helpers::NyquistHz(), 24000.0f);
+    {
+      RenderContext::Scope inner{ctx96};
+      EXPECT_FLOAT_EQ(Helpers::CurrentSampleRateRecipF(), 1.0f / 96000);
+    }
+    EXPECT_EQ(Helpers::CurrentSampleRateI(), 48000);
+
+    // another thread doesn't see this thread's binding.
+    std::thread([&]() { otherThreadRate = Helpers::CurrentSampleRateF(); }).join();
+  }
+  EXPECT_FLOAT_EQ(otherThreadRate, 44100.0f);
+  EXPECT_EQ(Helpers::CurrentSampleRateI(), 44100);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include <WaveSabreCore/../../Params/SmoothedParam.hpp>
+
+using namespace WaveSabreCore;
+using namespace WaveSabreCore::M7;
+
+TEST(SmoothedParam, FirstTargetIsImmediate)
+{
+  SmoothedParam p;
+  p.SetTarget(0.7f);
+  EXPECT_TRUE(p.IsSettled());
+  EXPECT_EQ(p.GetCurrent(), 0.7f);
+  float values[16];
+  EXPECT_FALSE(p.Process(values, 16));
+}
+
+TEST(SmoothedParam, LinearRampLandsOnTarget)
+{
+  SmoothedParam p{SmoothedParam::Curve::Linear, 10};
+  const int rampSamples = (int)math::MillisecondsToSamples(10);
+  p.Reset(0);
+  p.SetTarget(1);
+  // setting the same target again mustn't restart the ramp.
+  p.SetTarget(1);
+
+  // uneven blocks, with the ramp ending inside one of them.
+  float values[37];
+  int elapsed = 0;
+  float previous = 0;
+  while (!p.IsSettled())
+  {
+    ASSERT_TRUE(p.Process(values, 37));
+    for (int i = 0; i < 37; ++i, ++elapsed)
+    {
+      const float expected = elapsed + 1 >= rampSamples ? 1 : float(elapsed + 1) / rampSamples;
+      ASSERT_NEAR(values[i], expected, 1e-5f) << "sample " << elapsed;
+      ASSERT_GE(values[i], previous);
+      previous = values[i];
+    }
+  }
+  EXPECT_EQ(p.GetCurrent(), 1);
+  EXPECT_EQ(values[36], 1);
+  EXPECT_FALSE(p.Process(values, 37));
+}
+
+TEST(SmoothedParam, AdvanceMatchesProcess)
+{
+  for (auto curve : {SmoothedParam::Curve::Linear, SmoothedParam::Curve::Exponential})
+  {
+    SmoothedParam processed{curve, 5};
+    SmoothedParam advanced{curve, 5};
+    processed.Reset(-0.5f);
+    advanced.Reset(-0.5f);
+    processed.SetTarget(0.25f);
+    advanced.SetTarget(0.25f);
+    float values[32];
+    for (int block = 0; block < 1000 && !processed.IsSettled(); ++block)
+    {
+      processed.Process(values, 32);
+      EXPECT_NEAR(advanced.Advance(32), values[31], 1e-5f) << "block " << block;
+      EXPECT_EQ(advanced.IsSettled(), processed.IsSettled()) << "block " << block;
+    }
+    EXPECT_TRUE(processed.IsSettled());
+    EXPECT_EQ(advanced.GetCurrent(), 0.25f);
+  }
+}
+
+TEST(SmoothedParam, ExponentialApproachesWithoutOvershoot)
+{
+  SmoothedParam p{SmoothedParam::Curve::Exponential, 10};
+  const float tau = math::MillisecondsToSamples(10);
+  p.Reset(1);
+  p.SetTarget(0);
+  float values[64];
+  int elapsed = 0;
+  while (p.Process(values, 64))
+  {
+    for (int i = 0; i < 64; ++i, ++elapsed)
+    {
+      ASSERT_GE(values[i], 0);
+      if (values[i] > 0)
+      {
+        // e^(-t/tau), give or take float rounding.
+        ASSERT_NEAR(values[i], std::exp(-(elapsed + 1) / tau), 1e-4f) << "sample " << elapsed;
+      }
+    }
+    ASSERT_LT(elapsed, tau * 20);
+  }
+  EXPECT_EQ(p.GetCurrent(), 0);
+}
+
+TEST(SmoothedParam, RetargetingMidRampDoesNotJump)
+{
+  SmoothedParam p{SmoothedParam::Curve::Linear, 10};
+  p.Reset(0);
+  p.SetTarget(1);
+  const float midway = p.Advance((int)math::MillisecondsToSamples(5));
+  p.SetTarget(-1);
+  float values[4];
+  ASSERT_TRUE(p.Process(values, 4));
+  EXPECT_LT(values[0], midway);
+  EXPECT_NEAR(values[0], midway, 0.01f);
+}
+
+TEST(SmoothedParam, EmptyBlockLeavesTheRampAlone)
+{
+  SmoothedParam p{SmoothedParam::Curve::Linear, 10};
+  p.Reset(0);
+  p.SetTarget(1);
+  float values[4] = {};
+  EXPECT_FALSE(p.Process(values + 1, 0));
+  EXPECT_FALSE(p.IsSettled());
+  EXPECT_EQ(p.GetCurrent(), 0);
+  EXPECT_EQ(values[0], 0);
+}
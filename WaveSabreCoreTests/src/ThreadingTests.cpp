@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <WaveSabreCore/../../Basic/Threading.hpp>
+
+using namespace WaveSabreCore;
+
+namespace
+{
+struct PingPong
+{
+  Event ping;
+  Event pong;
+  int value = 0;
+};
+
+ThreadResult WS_THREADAPI PingPongProc(void* param)
+{
+  auto* p = (PingPong*)param;
+  for (int i = 0; i < 1000; i++)
+  {
+    p->ping.Wait();
+    p->value++;
+    p->pong.Set();
+  }
+  return 0;
+}
+
+struct Waiter
+{
+  std::atomic<int32_t> state{0};
+  std::atomic<int32_t> seen{0};
+};
+
+struct Counter
+{
+  Mutex mutex;
+  int value = 0;
+};
+
+ThreadResult WS_THREADAPI CounterProc(void* param)
+{
+  auto* c = (Counter*)param;
+  for (int i = 0; i < 100000; i++)
+  {
+    Mutex::Guard guard{c->mutex};
+    c->value++;
+  }
+  return 0;
+}
+
+ThreadResult WS_THREADAPI WaiterProc(void* param)
+{
+  auto* w = (Waiter*)param;
+  int32_t s;
+  while ((s = w->state.load()) == 0)
+    WaitOnValue(w->state, 0);
+  w->seen = s;
+  return 0;
+}
+}  // namespace
+
+TEST(Threading, AutoResetEventsHandOffWork)
+{
+  // the same handshake GraphProcessor2 does with its workers.
+  PingPong p;
+  Thread thread;
+  ASSERT_TRUE(thread.Start(PingPongProc, &p));
+  thread.SetPriority(ThreadPriority::AboveNormal);  // a hint; may be ignored
+  for (int i = 0; i < 1000; i++)
+  {
+    p.ping.Set();
+    p.pong.Wait();
+    ASSERT_EQ(p.value, i + 1);
+  }
+  thread.Join();
+  EXPECT_FALSE(thread.IsStarted());
+
+  // an auto-reset event's signal is consumed by one wait.
+  Event e;
+  e.Set();
+  EXPECT_TRUE(e.Wait(0));
+  EXPECT_FALSE(e.Wait(10));
+}
+
+TEST(Threading, ManualResetEventStaysSignalled)
+{
+  Event e{true};
+  e.Set();
+  EXPECT_TRUE(e.Wait(0));
+  EXPECT_TRUE(e.Wait(0));
+  e.Reset();
+  EXPECT_FALSE(e.Wait(10));
+}
+
+TEST(Threading, WaitOnValueWakes)
+{
+  Waiter w;
+  Thread thread;
+  ASSERT_TRUE(thread.Start(WaiterProc, &w));
+  SleepMilliseconds(20);
+  w.state = 7;
+  WakeAll(w.state);
+  thread.Join();
+  EXPECT_EQ(w.seen.load(), 7);
+}
+
+TEST(Threading, MutexSerializesIncrements)
+{
+  Counter c;
+  Thread threads[4];
+  for (auto& t : threads)
+    ASSERT_TRUE(t.Start(CounterProc, &c));
+  for (auto& t : threads)
+    t.Join();
+  EXPECT_EQ(c.value, 400000);
+}
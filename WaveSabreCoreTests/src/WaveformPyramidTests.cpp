@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "../../WaveSabrePlayerLib/include/WaveSabrePlayerLib/WaveformPyramid.hpp"
+
+using WSPlayerApp::WaveformPyramid;
+
+namespace
+{
+// deterministic noise with a slow envelope, so ranges differ.
+std::vector<int16_t> MakeSong(int64_t frames)
+{
+  std::vector<int16_t> ret((size_t)frames * 2);
+  uint32_t seed = 1;
+  for (int64_t i = 0; i < frames; i++)
+  {
+    double env = 0.1 + 0.9 * std::fabs(std::sin(i * 0.0003));
+    for (int ch = 0; ch < 2; ch++)
+    {
+      seed = seed * 1664525 + 1013904223;
+      ret[i * 2 + ch] = (int16_t)((int32_t)(seed >> 16) - 32768) * env;
+    }
+  }
+  return ret;
+}
+
+// what Query() should return: a scan of the whole buckets covering the range.
+WaveformPyramid::Summary Scan(const std::vector<int16_t>& song, int64_t begin, int64_t end)
+{
+  constexpr int64_t B = WaveformPyramid::kBaseFrames;
+  const int64_t frames = (int64_t)song.size() / 2;
+  begin = begin / B * B;
+  end = std::min(frames, (end + B - 1) / B * B);
+  WaveformPyramid::Summary ret;
+  ret.mMin = INT16_MAX;
+  ret.mMax = INT16_MIN;
+  for (int64_t i = begin * 2; i < end * 2; i++)
+  {
+    ret.mMin = std::min(ret.mMin, song[i]);
+    ret.mMax = std::max(ret.mMax, song[i]);
+  }
+  return ret;
+}
+}  // namespace
+
+TEST(WaveformPyramid, QueriesMatchAScanAtAnyZoom)
+{
+  // an odd length, so the last bucket is partial and the upper levels have ragged ends.
+  const int64_t frames = 44100 * 7 + 123;
+  auto song = MakeSong(frames);
+  WaveformPyramid pyramid{frames};
+  for (int64_t i = 0; i < frames; i++)
+    pyramid.ProcessFrame(song[i * 2], song[i * 2 + 1]);
+  pyramid.ProcessFrame(1, 1);  // past the end; ignored
+  EXPECT_EQ(pyramid.GetCompletedFrames(), frames);
+
+  for (int width : {1, 7, 300, 1400, 5000})
+  {
+    for (int x = 0; x < width; x++)
+    {
+      int64_t begin = x * frames / width;
+      int64_t end = (x + 1) * frames / width;
+      auto expected = Scan(song, begin, end);
+      auto actual = pyramid.Query(begin, end);
+      ASSERT_EQ(actual.mMin, expected.mMin) << width << " " << x;
+      ASSERT_EQ(actual.mMax, expected.mMax) << width << " " << x;
+    }
+  }
+
+  // uniform noise over the full range has an RMS of ~32768/sqrt(3); the envelope brings it down.
+  auto whole = pyramid.Query(0, frames);
+  EXPECT_GT(whole.mRms, 5000);
+  EXPECT_LT(whole.mRms, 19000);
+}
+
+TEST(WaveformPyramid, ReadersSeeOnlyCompletedBuckets)
+{
+  const int64_t frames = 44100 * 20;
+  auto song = MakeSong(frames);
+  WaveformPyramid pyramid{frames};
+  EXPECT_TRUE(pyramid.Query(0, frames).IsEmpty());
+
+  std::thread writer([&] {
+    for (int64_t i = 0; i < frames; i++)
+      pyramid.ProcessFrame(song[i * 2], song[i * 2 + 1]);
+  });
+  int64_t last = 0;
+  bool ok = true;
+  while (ok && last < frames)
+  {
+    int64_t completed = pyramid.GetCompletedFrames();
+    ok = completed >= last;
+    last = completed;
+    if (!completed)
+      continue;
+    // the writer has moved on by now, but everything up to what was published is final.
+    auto expected = Scan(song, 0, completed);
+    auto actual = pyramid.Query(0, completed);
+    ok = ok && actual.mMin == expected.mMin && actual.mMax == expected.mMax;
+  }
+  writer.join();
+  EXPECT_TRUE(ok);
+}
@@ -66,7 +66,9 @@ int32_t gPrecalcProgressPercent = 0;
 
 void UpdateStatusText()
 {
-    auto lock = gpRenderer->gCritsec.Enter();
+    // progress is published lock-free; take one consistent-enough snapshot.
+    auto songRendered = gpRenderer->gSongRendered.Load();
+    auto renderTime = gpRenderer->gRenderTime.Load();
 
 #ifdef WS_EXEPLAYER_RELEASE_FEATURES
 
@@ -79,10 +81,10 @@ void UpdateStatusText()
         "%s\r\n" // instructions
         ;
 
-    int32_t renderPercent = gpRenderer->gSongRendered.AsPercentOf(gpRenderer->gSongLength);
+    int32_t renderPercent = songRendered.AsPercentOf(gpRenderer->gSongLength);
 
     // actual precalc time will be the sooner of: [max_precalc_allowed, complete render]
-    gPrecalcProgressPercent = std::max(renderPercent, gpRenderer->gRenderTime.AsPercentOf(WSTime::FromMilliseconds(gMaxPrecalcMilliseconds)));
+    gPrecalcProgressPercent = std::max(renderPercent, renderTime.AsPercentOf(WSTime::FromMilliseconds(gMaxPrecalcMilliseconds)));
 
     char saveIndicatorText[1000] = { 0 };
     if (gSavedToFilename[0]) {
@@ -118,22 +120,22 @@ void UpdateStatusText()
         // TODO: wav writing status & destination
         ;
 
-    int32_t renderPercent = gpRenderer->gSongRendered.AsPercentOf(gpRenderer->gSongLength);
+    int32_t renderPercent = songRendered.AsPercentOf(gpRenderer->gSongLength);
 
-    auto renderRate = gpRenderer->gSongRendered.AsRateOf_x100(gpRenderer->gRenderTime);
-    auto songYetToRender = gpRenderer->gSongLength - gpRenderer->gSongRendered;
+    auto renderRate = songRendered.AsRateOf_x100(renderTime);
+    auto songYetToRender = gpRenderer->gSongLength - songRendered;
     auto remainingRenderTime = songYetToRender.DividedByRate_x100(renderRate);
-    auto estTotalRenderTime = remainingRenderTime + gpRenderer->gRenderTime;
+    auto estTotalRenderTime = remainingRenderTime + renderTime;
 
     // now let's calculate some buffering stuff. well this is going to be unreliable because the song doesn't render at the same rate throughout.
     // we want to show "how long until the song should be playable without buffering?"
     // basically it's similar to saying "at what point does the render-time-remaining fall below play-time-remaining?
     auto totalPrecalcTime = estTotalRenderTime - gpRenderer->gSongLength;
-    auto remainingPrecalcTime = totalPrecalcTime - gpRenderer->gRenderTime; // subtract how much you've already waited.
+    auto remainingPrecalcTime = totalPrecalcTime - renderTime; // subtract how much you've already waited.
     remainingPrecalcTime.Max0();
     totalPrecalcTime.Max0();
 
-    gPrecalcProgressPercent = std::max(renderPercent, gpRenderer->gRenderTime.AsPercentOf(WSTime::FromMilliseconds(gMaxPrecalcMilliseconds)));
+    gPrecalcProgressPercent = std::max(renderPercent, renderTime.AsPercentOf(WSTime::FromMilliseconds(gMaxPrecalcMilliseconds)));
 
     char saveIndicatorText[1000] = { 0 };
     if (gSavedToFilename[0]) {
@@ -149,7 +151,7 @@ void UpdateStatusText()
         renderPercent,
         renderRate / 100, renderRate % 100,
         WaveSabreCore::kSongMaxThreads,
-        gpRenderer->gRenderTime.GetMinutes(), gpRenderer->gRenderTime.GetSecondsOfMinute(), gpRenderer->gRenderTime.GetTenthsOfSecondsOfSeconds(),
+        renderTime.GetMinutes(), renderTime.GetSecondsOfMinute(), renderTime.GetTenthsOfSecondsOfSeconds(),
         remainingRenderTime.GetMinutes(), remainingRenderTime.GetSecondsOfMinute(), remainingRenderTime.GetTenthsOfSecondsOfSeconds(),
         estTotalRenderTime.GetMinutes(), estTotalRenderTime.GetSecondsOfMinute(), estTotalRenderTime.GetTenthsOfSecondsOfSeconds(),
         remainingPrecalcTime.GetMinutes(), remainingPrecalcTime.GetSecondsOfMinute(), remainingPrecalcTime.GetTenthsOfSecondsOfSeconds(),
@@ -199,9 +201,10 @@ void RenderWaveform_Fancy(GdiDeviceContext& dc)
     static constexpr  auto left = waveformRect.GetLeft();
     //Point renderCursorP1{ waveformRect.GetLeft() + gpWaveformGen->mProcessedWidth, waveformRect.GetTop() };
     //Point renderCursorP2{ renderCursorP1.GetX(), waveformRect.GetBottom() };
-    auto lock = gpRenderer->gCritsec.Enter(); // don't give waveformgen its own critsec for 1) complexity (lock hierarchies!) and 2) code size.
-    for (int i = 0; i < gpWaveformGen->mProcessedWidth; ++i) {
-        auto h = gpWaveformGen->mHeights[i];
+    // no lock; the waveform is published by the render thread as it goes.
+    const int processedWidth = gpWaveformGen->GetProcessedWidth();
+    for (int i = 0; i < processedWidth; ++i) {
+        auto c = gpWaveformGen->GetColumn(i);
 
         //const Point p1{ left + i, midY - h };
         //const Point p2{ p1.GetX(), midY + h };
@@ -217,7 +220,7 @@ void RenderWaveform_Fancy(GdiDeviceContext& dc)
         //    );
         //
         //dc.DrawLine(p1, p2, gTheme.WaveformForeground);
-        dc.SolidFill({ left + i, midY - h, 1, h * 2 }, gTheme.WaveformForeground);
+        dc.SolidFill({ left + i, midY - c.mAbove, 1, c.mAbove + c.mBelow }, gTheme.WaveformForeground);
     }
     //dc.HatchFill(gpWaveformGen->GetUnprocessedRect(), gTheme.WaveformUnrenderedHatch1, gTheme.WaveformUnrenderedHatch2);
     
@@ -329,7 +332,7 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
             return 0;
         }
         int xPos = LOWORD(lParam) - gTheme.grcWaveform.GetLeft();
-        uint32_t ms = MulDiv(xPos, gpRenderer->gSongLength.GetMilliseconds(), gTheme.grcWaveform.GetWidth());
+        auto ms = WSTime::Scale(gpRenderer->gSongLength.GetMilliseconds(), xPos, gTheme.grcWaveform.GetWidth());
         if (gpPlayer->IsPlaying()) {
             gpPlayer->PlayFrom(WSTime::FromMilliseconds(ms));
         }
@@ -188,7 +188,7 @@ void renderManualTestsUI(Maj7SynthWrapper& synth, Maj7ManualTestState& state)
                      //MakeButtonSpec("Invert Bleps", &invertBleps),
                  });
 
-  int sampleCount = (int)(Helpers::CurrentSampleRateF * state.secondsToShow);
+  int sampleCount = (int)(Helpers::CurrentSampleRateF() * state.secondsToShow);
   static std::vector<WFVSample> samples;
 
   if (samples.size() != sampleCount)
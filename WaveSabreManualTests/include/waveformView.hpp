@@ -354,7 +354,7 @@ static inline std::optional<WFVSample> WaveformViewImpl(const char* id,
     const auto& s = samples[hoveredIdx];
     const float vLin = s.sample.amplitude;
     const float vDb = M7::math::LinearToDecibels(std::max(std::abs(vLin), M7::gMinGainLinear));
-    const float sampleRate = Helpers::CurrentSampleRateF;
+    const float sampleRate = Helpers::CurrentSampleRateF();
     //const float tSec = sampleRate > 0.0f ? (float)hoveredIdx / sampleRate : 0.0f;
     //const float tMs = tSec * 1000.0f;
     // Phase 0..1 (avoid hitting exactly 1.0 at the end)
@@ -0,0 +1,59 @@
+#ifndef __WAVESABREPLAYERLIB_BATCHRENDERER_H__
+#define __WAVESABREPLAYERLIB_BATCHRENDERER_H__
+
+#ifndef MIN_SIZE_REL
+
+#include "SongRenderer.h"
+
+namespace WaveSabrePlayerLib
+{
+	// renders many jobs (songs, or one song at several rates / several tracks) to WAV files at once.
+	// instead of a SongRenderer with its own graph threads per job, the track graphs of every job are
+	// scheduled on one work-stealing pool, so a machine with more cores than a song has parallel tracks
+	// still gets filled. jobs advance block by block and the queues are FIFO, so they progress at a
+	// similar rate rather than one finishing before the next starts.
+	class BatchRenderer
+	{
+	public:
+		typedef void (*ProgressCallback)(double progress, void *data);
+
+		struct Job
+		{
+			// must be an export of the same layout as the linked song; see SongRenderer.
+			const WaveSabreCore::Song* Song = &WaveSabreCore::gSong;
+			int SampleRate = 44100;
+			// the track whose post-fader output is written; -1 is the master. past the last track fails the job.
+			int TrackIndex = -1;
+			const char* FileName = nullptr;
+
+			// filled in by Render().
+			double WallSeconds = 0; // from loading the song until its last block is written
+			double RealtimeFactor = 0; // seconds of audio per wall second
+			// the track index was out of range, or the file couldn't be opened or written. a file that was
+			// opened is left incomplete.
+			bool Failed = false;
+		};
+
+		struct Stats
+		{
+			double WallSeconds;
+			double AudioSeconds;
+			double RealtimeFactor;
+			int FailedJobs;
+		};
+
+		// numThreads <= 0 uses every hardware thread.
+		explicit BatchRenderer(int numThreads);
+
+		// renders all jobs and blocks until every file is written.
+		// the callback gets overall progress, called from worker threads one at a time.
+		Stats Render(Job* jobs, int numJobs, ProgressCallback callback, void *data);
+
+	private:
+		int numThreads;
+	};
+}
+
+#endif // #ifndef MIN_SIZE_REL
+
+#endif
@@ -2,6 +2,7 @@
 #define __WAVESABREPLAYERLIB_DIRECTSOUNDRENDERTHREAD_H__
 
 #include "SongRenderer.h"
+#include "RealtimeFeeder.h"
 
 #include <Windows.h>
 #include <dsound.h>
@@ -11,23 +12,27 @@ namespace WaveSabrePlayerLib
 	class DirectSoundRenderThread
 	{
 	public:
-		typedef void (*RenderCallback)(SongRenderer::Sample *buffer, int numSamples, void *data);
+		typedef RealtimeRenderCallback RenderCallback;
 
-		DirectSoundRenderThread(RenderCallback callback, void *callbackData, int sampleRate, int bufferSizeMs = 1000);
+		// the callback is given chunks of at most chunkBudgetMs (and never more than a second, which is as much as
+		// SongRenderer can render at once); smaller when little audio is queued and rendering is slow. onServiced is
+		// called after each batch of chunks; see RealtimeServicedCallback.
+		DirectSoundRenderThread(RenderCallback callback, void *callbackData, int sampleRate, int bufferSizeMs = 1000, int chunkBudgetMs = 20,
+			RealtimeServicedCallback onServiced = nullptr);
 		~DirectSoundRenderThread();
 
 		double GetPlayPositionMs();
+		RenderChunkPlanner::Stats GetChunkStats();
 
 	private:
-		static DWORD WINAPI threadProc(LPVOID lpParameter);
+		static WaveSabreCore::ThreadResult WS_THREADAPI threadProc(void *lpParameter);
 
-		RenderCallback callback;
-		void *callbackData;
+		RealtimeFeeder feeder;
 		int sampleRate;
 		int bufferSizeMs;
 		int bufferSizeBytes;
 
-		HANDLE thread;
+		WaveSabreCore::Thread thread;
 		WaveSabreCore::CriticalSection criticalSection;
 		WaveSabreCore::CriticalSection playPositionCriticalSection;
 		bool shutdown;
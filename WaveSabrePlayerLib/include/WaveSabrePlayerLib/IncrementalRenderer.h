@@ -0,0 +1,62 @@
+#ifndef __WAVESABREPLAYERLIB_INCREMENTALRENDERER_H__
+#define __WAVESABREPLAYERLIB_INCREMENTALRENDERER_H__
+
+#ifndef MIN_SIZE_REL
+
+#include <stdint.h>
+
+#include <string>
+
+#include "SongRenderer.h"
+
+namespace WaveSabrePlayerLib
+{
+	// renders the song to a WAV while keeping every rendered track's post-fader output in a cache
+	// directory, so a re-export after a change only re-renders what the change can reach.
+	//
+	// a track's key hashes its own inputs (Track::HashInputs) together with the keys of every track it
+	// receives from, so a changed device, automation lane or midi lane dirties exactly that track and the
+	// tracks downstream of it. cached tracks aren't run at all; they're streamed back into their buffers
+	// only when a track being rendered receives from them. tracks nothing dirty depends on are skipped.
+	//
+	// keys are per track, not per time segment: a device's state at any point depends on everything
+	// before it, so a dirty track always renders from the start. the cache files are streamed through
+	// in segments, so memory use doesn't grow with the song.
+	class IncrementalRenderer
+	{
+	public:
+		typedef void (*ProgressCallback)(double progress, void *data);
+
+		struct Stats
+		{
+			int TracksRendered;
+			int TracksFromCache;
+			int TracksSkipped;
+			// cached tracks whose file was the wrong size, or came up short while reading. a wrong size is
+			// caught up front and the track rendered; a short read mixes in silence instead. either way the
+			// entry is deleted, so the next export renders them.
+			int CacheReadErrors;
+			// rendered tracks whose cache file couldn't be written or closed; it's deleted instead of kept.
+			int CacheWriteErrors;
+			// the output WAV couldn't be opened, written or closed.
+			bool Failed;
+			double WallSeconds;
+		};
+
+		// cacheDirectory must exist. salt goes into every key; change it whenever the engine itself
+		// changes, since cached output from another build would otherwise be reused.
+		IncrementalRenderer(int numRenderThreads, const char *cacheDirectory, uint64_t salt);
+
+		// each call renders the song from the start with a fresh renderer.
+		Stats Write(const char *fileName, ProgressCallback callback, void *data);
+
+	private:
+		int numRenderThreads;
+		std::string cacheDirectory;
+		uint64_t salt;
+	};
+}
+
+#endif // #ifndef MIN_SIZE_REL
+
+#endif
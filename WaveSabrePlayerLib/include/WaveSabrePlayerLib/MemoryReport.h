@@ -0,0 +1,31 @@
+#ifndef __WAVESABREPLAYERLIB_MEMORYREPORT_H__
+#define __WAVESABREPLAYERLIB_MEMORYREPORT_H__
+
+#ifndef MIN_SIZE_REL
+
+#include <stdio.h>
+
+#include "SongRenderer.h"
+
+namespace WaveSabrePlayerLib
+{
+	// loads the song and prints where its arena's bytes went: by subsystem, device type and track.
+	// devices create some state on first use (oscillator cores, ...), so render a while first to see
+	// the steady-state footprint rather than just the loaded one.
+	class MemoryReport
+	{
+	public:
+		explicit MemoryReport(int numRenderThreads);
+		~MemoryReport();
+
+		void Render(double seconds);
+		void Write(FILE *out);
+
+	private:
+		SongRenderer *songRenderer;
+	};
+}
+
+#endif // #ifndef MIN_SIZE_REL
+
+#endif
@@ -27,7 +27,7 @@ namespace WSPlayerApp
                 write(&p, n);
             };
 
-            int bufferSizeBytes = renderer.gSongLength.GetStereoSamples() * sizeof(renderer.gpBuffer[0]);
+            int bufferSizeBytes = (int)renderer.gSongLength.GetStereoSamples() * sizeof(renderer.gpBuffer[0]);
 
             // TODO: add metadata via "LIST" section.
 
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace WSPlayerApp
+{
+    // decides when render-while-playing playback can start, and what to do when playback is predicted to
+    // catch up with rendering. it never reads a clock: times are wall milliseconds since rendering began,
+    // positions are frames, and the caller feeds both in (so it runs the same against a simulated clock).
+    //
+    // the model is a smoothed render rate. assuming rendering continues at that rate, the gap between the
+    // render cursor and a play cursor starting at frame p changes linearly until rendering finishes, so it's
+    // smallest either now or at the end:
+    //   margin = min(rendered - p, songFrames - p - playRate * (songFrames - rendered) / renderRate)
+    // songs don't render at a constant rate, so the rate is derated and a headroom is required on top.
+    struct PlaybackScheduler
+    {
+        enum class Action
+        {
+            Wait,         // not playing, and not safe to start yet
+            Play,         // start, resume or keep playing
+            LowerQuality, // predicted to underrun before rendering finishes; render the rest cheaper
+            Pause,        // about to play past the render cursor; hold until it's safe again
+        };
+
+        static constexpr uint32_t kRateSampleMilliseconds = 250;
+        static constexpr uint32_t kMinModelMilliseconds = 1000; // don't predict from less than this
+        static constexpr double kRateSmoothing = 0.25;
+        static constexpr double kRateDerate = 0.85;
+        static constexpr int32_t kHeadroomMilliseconds = 2000; // required margin before starting / resuming
+        static constexpr int32_t kPauseGuardMilliseconds = 300; // pause when the lead falls below this
+
+        // maxPrecalcMilliseconds: start anyway after this long, like before there was a model.
+        PlaybackScheduler(int64_t songFrames, int32_t sampleRate, uint32_t maxPrecalcMilliseconds) :
+            mSongFrames(songFrames),
+            mFramesPerMillisecond(sampleRate / 1000.0),
+            mMaxPrecalcMilliseconds(maxPrecalcMilliseconds)
+        {
+        }
+
+        // call as rendering progresses; renderedFrames is the end of the rendered region.
+        void OnRendered(uint32_t nowMs, int64_t renderedFrames)
+        {
+            mNowMs = nowMs;
+            mRenderedFrames = renderedFrames;
+            uint32_t dt = nowMs - mSampleMs;
+            if (dt < kRateSampleMilliseconds)
+                return;
+            double rate = (renderedFrames - mSampleFrames) / (double)dt;
+            mRate = (mRate > 0) ? mRate + (rate - mRate) * kRateSmoothing : rate;
+            mSampleMs = nowMs;
+            mSampleFrames = renderedFrames;
+        }
+
+        // forget the rate (after the render cost changed, e.g. quality was lowered) and measure it again.
+        void ResetRate()
+        {
+            mRate = 0;
+            mModelStartMs = mSampleMs = mNowMs;
+            mSampleFrames = mRenderedFrames;
+        }
+
+        bool IsRenderComplete() const
+        {
+            return mRenderedFrames >= mSongFrames;
+        }
+
+        bool IsModelReady() const
+        {
+            return mRate > 0 && mNowMs - mModelStartMs >= kMinModelMilliseconds;
+        }
+
+        // smoothed render speed relative to real-time, x100.
+        int32_t GetRenderRate_x100() const
+        {
+            return (int32_t)(mRate * 100 / mFramesPerMillisecond);
+        }
+
+        // predicted smallest lead (frames) of rendering over playback started at playFrame now.
+        // negative means an underrun. only meaningful once the model is ready.
+        int64_t PredictMarginFrames(int64_t playFrame) const
+        {
+            int64_t lead = mRenderedFrames - playFrame;
+            if (IsRenderComplete())
+                return lead;
+            double rate = mRate * kRateDerate;
+            if (rate >= mFramesPerMillisecond)
+                return lead;
+            double remainingMs = (mSongFrames - mRenderedFrames) / (rate > 0 ? rate : 1e-9);
+            double atEnd = mSongFrames - playFrame - mFramesPerMillisecond * remainingMs;
+            if (atEnd < -1e15)
+                atEnd = -1e15;
+            return atEnd < lead ? (int64_t)atEnd : lead;
+        }
+
+        // playFrame is where playback is (or would start). canLowerQuality says whether the caller can act
+        // on LowerQuality; when it returns that, the caller is expected to lower the quality.
+        Action Decide(uint32_t nowMs, bool playing, int64_t playFrame, bool canLowerQuality)
+        {
+            if (IsRenderComplete())
+                return Action::Play;
+            const int64_t lead = mRenderedFrames - playFrame;
+            const bool ready = IsModelReady();
+            const int64_t margin = ready ? PredictMarginFrames(playFrame) : lead;
+
+            if (!playing)
+            {
+                if (!mStarted && nowMs >= mMaxPrecalcMilliseconds && lead > MillisecondsToFrames(kPauseGuardMilliseconds))
+                    return Start();
+                if (ready && margin >= MillisecondsToFrames(kHeadroomMilliseconds))
+                    return Start();
+                return Action::Wait;
+            }
+
+            if (lead < MillisecondsToFrames(kPauseGuardMilliseconds))
+                return Action::Pause;
+            if (ready && margin < 0 && canLowerQuality)
+            {
+                ResetRate();
+                return Action::LowerQuality;
+            }
+            return Action::Play;
+        }
+
+    private:
+        Action Start()
+        {
+            mStarted = true;
+            return Action::Play;
+        }
+
+        int64_t MillisecondsToFrames(int32_t ms) const
+        {
+            return (int64_t)(ms * mFramesPerMillisecond);
+        }
+
+        const int64_t mSongFrames;
+        const double mFramesPerMillisecond; // playback rate
+        const uint32_t mMaxPrecalcMilliseconds;
+
+        uint32_t mNowMs = 0;
+        int64_t mRenderedFrames = 0;
+
+        double mRate = 0; // rendered frames per wall millisecond; 0 = not measured yet
+        uint32_t mModelStartMs = 0;
+        uint32_t mSampleMs = 0;
+        int64_t mSampleFrames = 0;
+
+        bool mStarted = false; // the max precalc fallback only applies to the first start
+    };
+
+} // namespace WSPlayerApp
@@ -50,9 +50,8 @@ namespace WSPlayerApp
 
     // in an ideal world we could know when it's 100% safe to play the track without "buffering".
     // the track renders at different rates at different places so it's not possible to really know reliably.
-    // therefore, only play the track when either 1) the track is finished rendering, or 2) the max precalc time allowed has passed.
-    // so what if the max precalc time is not enough? in this case simply present the user with the option to play.
-    // that will buy us at least few more seconds.
+    // PlaybackScheduler predicts it from the render rate so far, and playback pauses if the prediction was wrong.
+    // this is the fallback: if the prediction still says "not yet" after this long, play anyway.
     static constexpr int32_t gMaxPrecalcMilliseconds = 30000;
 
     static constexpr uint32_t gBlockSizeSamples = 256; // don't try to bite off too much; modulations will be too loose. try to replicate DAW behavior. Note these are samples not frames. 128 sample buffer probably means 256 here.
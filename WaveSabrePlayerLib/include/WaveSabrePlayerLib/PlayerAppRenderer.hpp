@@ -2,9 +2,11 @@
 
 #include <WaveSabreCore.h>
 #include <WaveSabrePlayerLib/SongRenderer.h>
+#include <WaveSabrePlayerLib/QualityLadder.h>
 
 #include "PlayerAppConfig.hpp"
 #include "PlayerAppUtils.hpp"
+#include "PlaybackScheduler.hpp"
 
 namespace WSPlayerApp
 {
@@ -20,8 +22,9 @@ namespace WSPlayerApp
         };
         //WaveSabreCore::Song gSong;
         WSTime gSongLength;
-        WSTime gSongRendered;
-        WSTime gRenderTime;
+        // published by the render thread after each block; poll from anywhere without the critsec.
+        AtomicWSTime gSongRendered;
+        AtomicWSTime gRenderTime;
 
         SongRenderer* gpRenderer = nullptr;
         SongRenderer::Sample* gpBuffer = nullptr;
@@ -33,11 +36,26 @@ namespace WSPlayerApp
         WAVEHDR WaveHDR;
         WaveSabreCore::CriticalSection gCritsec;
         HWND mhWndNotify;
-        HANDLE mhRenderThread;
+        WaveSabreCore::Thread mRenderThread;
         DWORD mProcessorCount = 0;
+        PlaybackScheduler mScheduler; // guarded by gCritsec
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+        // there's no deadline per block when rendering ahead of playback, so the governor only acts on the
+        // scheduler's predictions here. quality is global state read while rendering, so only the render thread
+        // applies the level.
+        WaveSabrePlayerLib::QualityLadder mQualityLadder;
+        WaveSabrePlayerLib::QualityGovernor mGovernor; // guarded by gCritsec
+        std::atomic<int> mGovernorLevel{ 0 };
+#endif
 
         Renderer(HWND hWndNotify) :
-            mhWndNotify(hWndNotify)
+            mhWndNotify(hWndNotify),
+            mScheduler(WSTime::FromMilliseconds(WaveSabreCore::kSongLengthSeconds * 1000).GetFrames(),
+                       WaveSabreCore::Helpers::CurrentSampleRateI(),
+                       gMaxPrecalcMilliseconds)
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+            , mGovernor(mQualityLadder.GetLevelCount(), WaveSabrePlayerLib::QualityLadder::LogTransition, &mQualityLadder)
+#endif
         {
             SYSTEM_INFO sysInfo;
             GetSystemInfo(&sysInfo);
@@ -48,8 +66,8 @@ namespace WSPlayerApp
 
             gSongLength.SetMilliseconds(WaveSabreCore::kSongLengthSeconds * 1000);
             static_assert(SongRenderer::NumChannels == 2, "everything here assumes stereo");
-            gAllocatedSampleCount = gSongLength.GetStereoSamples() +
-                                    (WaveSabreCore::Helpers::CurrentSampleRateI *
+            gAllocatedSampleCount = (int)gSongLength.GetStereoSamples() +
+                                    (WaveSabreCore::Helpers::CurrentSampleRateI() *
                                      2);  // allocate more than the song requires for good measure.
             gpBuffer = new SongRenderer::Sample[gAllocatedSampleCount];
             auto bufferSizeBytes = gAllocatedSampleCount * sizeof(SongRenderer::Sample);
@@ -57,7 +75,7 @@ namespace WSPlayerApp
 
             WaveFMT.wFormatTag = WAVE_FORMAT_PCM;
             WaveFMT.nChannels = 2;
-            WaveFMT.nSamplesPerSec = WaveSabreCore::Helpers::CurrentSampleRateI;
+            WaveFMT.nSamplesPerSec = WaveSabreCore::Helpers::CurrentSampleRateI();
             WaveFMT.wBitsPerSample = sizeof(SongRenderer::Sample) * 8;
             WaveFMT.nBlockAlign = (WaveFMT.nChannels * WaveFMT.wBitsPerSample) / 8;
             WaveFMT.nAvgBytesPerSec = WaveFMT.nSamplesPerSec * WaveFMT.nBlockAlign;
@@ -76,7 +94,7 @@ namespace WSPlayerApp
         {
             mpAdditionalProcessor = pAdditionalProcessor;
             renderingStartedTick = GetTickCount();
-            mhRenderThread = ::CreateThread(0, 0, RenderThread, this, 0, 0);
+            mRenderThread.Start(RenderThread, this);
         }
 
         RenderStatus GetRenderStatus() const
@@ -84,12 +102,39 @@ namespace WSPlayerApp
             return this->mRenderStatus;
         }
 
-        static DWORD WINAPI RenderThread(LPVOID capture)
+        // asks the scheduler whether playback at playPos should start / continue, from any thread.
+        // LowerQuality is handled here (where possible), so callers only see Wait, Play and Pause.
+        PlaybackScheduler::Action Schedule(bool playing, WSTime playPos)
+        {
+            auto lock = gCritsec.Enter();
+            if (!renderingStartedTick)
+                return PlaybackScheduler::Action::Wait; // not begun
+            mScheduler.OnRendered((uint32_t)gRenderTime.Load().GetMilliseconds(), gSongRendered.Load().GetFrames());
+            const DWORD nowMs = GetTickCount() - renderingStartedTick;
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+            bool canLowerQuality = mGovernor.GetLevel() + 1 < mGovernor.GetLevelCount();
+#else
+            bool canLowerQuality = false; // quality is compiled in
+#endif
+            auto action = mScheduler.Decide(nowMs, playing, playPos.GetFrames(), canLowerQuality);
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+            if (action == PlaybackScheduler::Action::LowerQuality)
+            {
+                // the render thread picks this up at its next block.
+                mGovernor.StepDown(nowMs);
+                mGovernorLevel.store(mGovernor.GetLevel(), std::memory_order_release);
+                action = PlaybackScheduler::Action::Play;
+            }
+#endif
+            return action;
+        }
+
+        static WaveSabreCore::ThreadResult WS_THREADAPI RenderThread(void* capture)
         {
             ((Renderer*)capture)->RenderThread2();
             // HACK / TODO: crash when this thread exits. my guess is because i have elided freeing resources to save bits; it's hard to repro and not important so just ... don't return from this thread.
             while (true) {
-                Sleep(100);
+                WaveSabreCore::SleepMilliseconds(100);
             }
             return 0;
         }
@@ -97,11 +142,24 @@ namespace WSPlayerApp
         DWORD RenderThread2()
         {
             mRenderStatus = RenderStatus::Rendering;
-            for (int i = 0; i < gSongLength.GetStereoSamples(); i += gBlockSizeSamples)
+            const WSTime::Int songStereoSamples = gSongLength.GetStereoSamples();
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+            int appliedLevel = 0;
+#endif
+            for (WSTime::Int i = 0; i < songStereoSamples; i += gBlockSizeSamples)
             {
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+                int level = mGovernorLevel.load(std::memory_order_acquire);
+                if (level != appliedLevel)
+                {
+                    mQualityLadder.Apply(level);
+                    appliedLevel = level;
+                }
+#endif
                 gpRenderer->RenderSamples(gpBuffer + i, gBlockSizeSamples);
-                gSongRendered.SetStereoSamples(i);
-                gRenderTime.SetMilliseconds(GetTickCount() - renderingStartedTick);
+                // the block's samples are visible to whoever sees the new position (release).
+                gSongRendered.Store(WSTime::FromFrames((i + gBlockSizeSamples) / 2));
+                gRenderTime.Store(WSTime::FromMilliseconds(GetTickCount() - renderingStartedTick));
                 if (mpAdditionalProcessor) mpAdditionalProcessor->ProcessSamples(gpBuffer + i, gBlockSizeSamples);
             }
 
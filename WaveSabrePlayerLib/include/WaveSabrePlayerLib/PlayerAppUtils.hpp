@@ -3,6 +3,7 @@
 #include <Windows.h>
 #include <string.h>
 #include <typeinfo>
+#include <atomic>
 
 #include "SongRenderer.h"
 
@@ -65,61 +66,76 @@ namespace WSPlayerApp
     };
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // a song position / duration in frames (stereo samples). 64-bit, so hours-long songs are fine, and
+    // conversions multiply before dividing, truncating toward zero.
+    // x86 size builds stay 32-bit and use MulDiv (rounding to nearest), because 64-bit multiplies and divides
+    // there link the CRT's __allmul / __alldiv. that still covers 13 hours at 44.1kHz.
     class WSTime
     {
-        int32_t mFrames = 0; // stereo samples
-        explicit WSTime(int32_t f) : mFrames(f) {}
+    public:
+#if defined(MIN_SIZE_REL) && !defined(_WIN64)
+        using Int = int32_t;
+#else
+        using Int = int64_t;
+#endif
+        // a * mul / div, without the product overflowing.
+        static Int Scale(Int a, Int mul, Int div)
+        {
+#if defined(MIN_SIZE_REL) && !defined(_WIN64)
+            return MulDiv(a, mul, div);
+#else
+            return a * mul / div;
+#endif
+        }
+
+    private:
+        Int mFrames = 0; // stereo samples
+        explicit WSTime(Int f) : mFrames(f) {}
     public:
         WSTime() {}
-        static int32_t MillisecondsToFrames(int32_t ms)
+        static Int MillisecondsToFrames(Int ms)
         {
-          return MulDiv(ms, WaveSabreCore::Helpers::CurrentSampleRateI, 1000);
-            // this will overflow for even moderate ms amounts. need to be careful. for example a 10 minute value
-            // = 60 sec = 60000 ms * 44100 = 2,646,000,000, overflowing. so assume the samplerate is a multiple of 10.
-            // 2,147,483,647
-            // that gives us max ms of 486,957, or ~30 minutes.
-            //auto srDiv10 = gSampleRate / 10;
-            //return ms * srDiv10 / 100;
+            return Scale(ms, WaveSabreCore::Helpers::CurrentSampleRateI(), 1000);
         }
-        int32_t GetFrames() const {
-            return (int32_t)mFrames;
+        Int GetFrames() const {
+            return mFrames;
         }
-        int32_t GetStereoSamples() const {
-            return int32_t(mFrames * 2);
+        Int GetStereoSamples() const {
+            return mFrames * 2;
         }
-        int32_t GetMilliseconds() const {
-          return MulDiv(mFrames, 1000, WaveSabreCore::Helpers::CurrentSampleRateI);
+        Int GetMilliseconds() const {
+            return Scale(mFrames, 1000, WaveSabreCore::Helpers::CurrentSampleRateI());
         }
-        int32_t GetBytes() const {
+        Int GetBytes() const {
             static_assert(std::is_same_v<WaveSabrePlayerLib::SongRenderer::Sample, int16_t>, "assuming 16-bit sample format");
             return GetStereoSamples() * sizeof(int16_t);
         }
         int GetMinutes() const {
-            return GetMilliseconds() / 60000;
+            return int(GetMilliseconds() / 60000);
         }
         int GetSecondsOfMinute() const {
-            return (GetMilliseconds() % 60000) / 1000;
+            return int((GetMilliseconds() % 60000) / 1000);
         }
         int GetMillisecondsOfSeconds() const {
-            return (GetMilliseconds() % 1000);
+            return int(GetMilliseconds() % 1000);
         }
         int GetTenthsOfSecondsOfSeconds() const {
             return GetMillisecondsOfSeconds() / 100;
         }
-        void SetMilliseconds(int32_t ms) {
+        void SetMilliseconds(Int ms) {
             mFrames = MillisecondsToFrames(ms);
         }
-        void SetStereoSamples(int32_t ss) {
+        void SetStereoSamples(Int ss) {
             mFrames = ss / 2;
         }
-        void SetFrames(int32_t f) {
+        void SetFrames(Int f) {
             mFrames = f;
         }
-        static WSTime FromMilliseconds(int32_t ms)
+        static WSTime FromMilliseconds(Int ms)
         {
             return WSTime{ MillisecondsToFrames(ms) };
         }
-        static WSTime FromFrames(int32_t f)
+        static WSTime FromFrames(Int f)
         {
             return WSTime{ f };
         }
@@ -129,8 +145,7 @@ namespace WSPlayerApp
         {
             if (mFrames <= 0) return 0;
             if (mFrames >= rhs.mFrames) return 100;
-            return MulDiv(mFrames, 100, rhs.mFrames);
-            //return int32_t(mFrames * 100) / int32_t(rhs.mFrames); // avoid __alldiv
+            return int32_t(Scale(mFrames, 100, rhs.mFrames));
         }
 
         // returns this value as a rate of another value, multiplied by 100. so if this is 6, and rhs is 10, returns 60.
@@ -140,8 +155,7 @@ namespace WSPlayerApp
         {
             if (mFrames <= 0) return 0;
             if (rhs.mFrames <= 0) return 100;
-            return MulDiv(mFrames, 100, rhs.mFrames);
-            //return int32_t(mFrames * 100) / int32_t(rhs.mFrames); // avoid __alldiv
+            return int32_t(Scale(mFrames, 100, rhs.mFrames));
         }
         WSTime operator -(const WSTime& rhs) const
         {
@@ -156,17 +170,14 @@ namespace WSPlayerApp
         }
         WSTime MultipliedByRate_x100(int32_t r100) const
         {
-            auto frames = MulDiv(mFrames, r100, 100);// int32_t(mFrames * r100) / 100;
-            return WSTime{ frames };
+            return WSTime{ Scale(mFrames, r100, 100) };
         }
         WSTime DividedByRate_x100(int32_t r100) const
         {
             if (r100 == 0) {
                 return WSTime{ mFrames };
             }
-            auto frames = MulDiv(mFrames, 100, r100);// int32_t(mFrames * r100) / 100;
-            //auto frames = int32_t(mFrames * 100) / r100; // avoid __alldiv
-            return WSTime{ frames };
+            return WSTime{ Scale(mFrames, 100, r100) };
         }
 
         void Max0() { // just set a floor of 0.
@@ -174,6 +185,19 @@ namespace WSPlayerApp
         }
     };
 
+    // a WSTime one thread publishes (render progress, play position) and others poll, without locking.
+    class AtomicWSTime
+    {
+        std::atomic<WSTime::Int> mFrames{ 0 };
+    public:
+        void Store(WSTime t) {
+            mFrames.store(t.GetFrames(), std::memory_order_release);
+        }
+        WSTime Load() const {
+            return WSTime::FromFrames(mFrames.load(std::memory_order_acquire));
+        }
+    };
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     struct GdiDeviceContextBasic
     {
@@ -0,0 +1,109 @@
+#ifndef __WAVESABREPLAYERLIB_QUALITYGOVERNOR_H__
+#define __WAVESABREPLAYERLIB_QUALITYGOVERNOR_H__
+
+#include <math.h>
+
+namespace WaveSabrePlayerLib
+{
+	// watches how long each block takes to render against how long it plays (its deadline), and picks a
+	// degradation level: 0 is full quality, higher levels are cheaper. what a level means is up to the caller.
+	// it never reads a clock; the caller passes times in, so it runs the same against a synthetic trace.
+	//
+	// the load (render time / deadline) is smoothed over LoadTimeConstantMs of audio, each block weighted by its
+	// deadline, so a short block moves it less than a long one. above DegradeLoad it steps down a level, at most once per
+	// DegradeHoldMs so the new level's cost can show up first; a single block over its deadline steps down right
+	// away. it steps back up only after the load has stayed below RecoverLoad for RecoverHoldMs. the gap between
+	// the two thresholds keeps it from flapping between neighbouring levels.
+	class QualityGovernor
+	{
+	public:
+		static constexpr double LoadTimeConstantMs = 50;
+		static constexpr double DegradeLoad = 0.8;
+		static constexpr double RecoverLoad = 0.5;
+		static constexpr double DegradeHoldMs = 250;
+		static constexpr double RecoverHoldMs = 4000;
+
+		// called on every level change.
+		typedef void (*TransitionCallback)(int fromLevel, int toLevel, double load, void *data);
+
+		QualityGovernor(int levelCount, TransitionCallback onTransition = nullptr, void *onTransitionData = nullptr)
+			: levelCount(levelCount)
+			, onTransition(onTransition)
+			, onTransitionData(onTransitionData)
+		{
+		}
+
+		// returns true if the level changed.
+		bool OnBlock(double nowMs, double renderMs, double deadlineMs)
+		{
+			if (deadlineMs <= 0)
+				return false;
+			double load = renderMs / deadlineMs;
+			smoothedLoad = hasLoad ? smoothedLoad + (load - smoothedLoad) * (1 - exp(-deadlineMs / LoadTimeConstantMs)) : load;
+			hasLoad = true;
+
+			if (smoothedLoad >= RecoverLoad || level == 0)
+				calmSinceMs = nowMs;
+
+			bool overloaded = smoothedLoad > DegradeLoad || load > 1;
+			if (overloaded && level + 1 < levelCount && nowMs - lastTransitionMs >= (load > 1 ? 0 : DegradeHoldMs))
+				return SetLevel(nowMs, level + 1, load);
+			if (level > 0 && nowMs - calmSinceMs >= RecoverHoldMs && nowMs - lastTransitionMs >= RecoverHoldMs)
+				return SetLevel(nowMs, level - 1, load);
+			return false;
+		}
+
+		// for pressure seen elsewhere (e.g. a playback scheduler predicting an underrun). false if already at the bottom.
+		bool StepDown(double nowMs)
+		{
+			if (level + 1 >= levelCount)
+				return false;
+			return SetLevel(nowMs, level + 1, smoothedLoad);
+		}
+
+		int GetLevel() const
+		{
+			return level;
+		}
+
+		int GetLevelCount() const
+		{
+			return levelCount;
+		}
+
+		double GetSmoothedLoad() const
+		{
+			return smoothedLoad;
+		}
+
+		int GetTransitionCount() const
+		{
+			return transitionCount;
+		}
+
+	private:
+		bool SetLevel(double nowMs, int newLevel, double load)
+		{
+			int oldLevel = level;
+			level = newLevel;
+			lastTransitionMs = calmSinceMs = nowMs;
+			transitionCount++;
+			if (onTransition)
+				onTransition(oldLevel, newLevel, load, onTransitionData);
+			return true;
+		}
+
+		int levelCount;
+		TransitionCallback onTransition;
+		void *onTransitionData;
+
+		int level = 0;
+		bool hasLoad = false;
+		double smoothedLoad = 0;
+		double lastTransitionMs = -1e300;
+		double calmSinceMs = 0;
+		int transitionCount = 0;
+	};
+}
+
+#endif
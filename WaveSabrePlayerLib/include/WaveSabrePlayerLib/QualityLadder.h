@@ -0,0 +1,62 @@
+#ifndef __WAVESABREPLAYERLIB_QUALITYLADDER_H__
+#define __WAVESABREPLAYERLIB_QUALITYLADDER_H__
+
+#include <WaveSabreCore.h>
+
+#include <stdio.h>
+
+#include "QualityGovernor.h"
+
+namespace WaveSabrePlayerLib
+{
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+	// what QualityGovernor's levels mean for Maj7: level 0 is the quality in effect when the ladder was made, each
+	// level below steps the global quality down one notch until Potato, and the last levels cap polyphony.
+	// quality is compiled in for size builds, so there's nothing to govern there.
+	class QualityLadder
+	{
+	public:
+		static constexpr int VoiceCapCount = 2;
+		static constexpr int VoiceCaps[VoiceCapCount] = { 16, 8 };
+
+		QualityLadder()
+			: topQuality((int)WaveSabreCore::M7::GetQualitySetting())
+		{
+		}
+
+		int GetLevelCount() const
+		{
+			return topQuality + 1 + VoiceCapCount;
+		}
+
+		// call between blocks, on the render thread.
+		void Apply(int level) const
+		{
+			int quality = topQuality - level;
+			WaveSabreCore::M7::SetQualitySetting((WaveSabreCore::M7::QualitySetting)(quality > 0 ? quality : 0));
+			WaveSabreCore::M7::SetVoiceLimit(quality < 0 ? VoiceCaps[-quality - 1] : WaveSabreCore::M7::gNoVoiceLimit);
+		}
+
+		// a QualityGovernor::TransitionCallback; data is the ladder.
+		static void LogTransition(int fromLevel, int toLevel, double load, void *data)
+		{
+			QUALITY_SETTING_CAPTIONS(qualityNames);
+			auto ladder = (const QualityLadder *)data;
+			int quality = ladder->topQuality - toLevel;
+			char s[200];
+			sprintf(s, "quality governor: level %d -> %d at load %.2f (%s, %d voices max)\n",
+				fromLevel,
+				toLevel,
+				load,
+				qualityNames[quality > 0 ? quality : 0],
+				quality < 0 ? VoiceCaps[-quality - 1] : WaveSabreCore::M7::gMaxMaxVoices);
+			::OutputDebugStringA(s);
+		}
+
+	private:
+		int topQuality;
+	};
+#endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef __WAVESABREPLAYERLIB_RANGERENDERER_H__
+#define __WAVESABREPLAYERLIB_RANGERENDERER_H__
+
+#ifndef MIN_SIZE_REL
+
+#include <vector>
+
+#include "SongRenderer.h"
+
+namespace WaveSabrePlayerLib
+{
+	// renders arbitrary time ranges of the song without starting from sample 0 every time.
+	// the song renderer's object graph lives in its own arena (see WaveSabreCore::Arena), so the complete
+	// state of every track, automation and device (voices, delay lines, reverb tails) can be copied out and back.
+	// rendering keeps a snapshot at every interval boundary it passes; seeking restores the latest one at
+	// or before the target and renders silently from there.
+	//
+	// not captured: the CRT rand() state (used by random triggers), so those may differ from a render
+	// from the start, exactly as they already differ between threads.
+	class RangeRenderer
+	{
+	public:
+		typedef SongRenderer::Sample Sample;
+
+		// the interval is rounded to whole blocks. each snapshot costs the song's whole state in memory.
+		RangeRenderer(int numRenderThreads, double snapshotIntervalSeconds);
+		~RangeRenderer();
+
+		// positions and lengths are in stereo frames at the song's rate.
+		int GetPosition() const { return position; }
+		int GetLengthFrames() const { return lengthFrames; }
+		int GetSampleRate() const { return songRenderer->mRenderContext.mSampleRateI; }
+
+		// restores the latest snapshot at or before frame, then renders up to frame without output.
+		// that restores device parameters too, so apply edits after seeking, not before.
+		void Seek(int frame);
+
+		// renders interleaved 16-bit stereo from the current position; buffer may be null to just advance.
+		void Render(Sample *buffer, int numFrames);
+
+		// an edit between renders (devices' SetParam / SetChunk), applied from the current position on:
+		//   { auto edit = rangeRenderer.Edit(); edit->devices[i]->SetParam(...); }
+		// binds the song's arena and render context, so whatever the devices allocate lands with the rest of
+		// their state. when it ends, snapshots after the current position, which were taken from the
+		// unedited song, are dropped, and one at the current position is retaken.
+		class EditScope
+		{
+		public:
+			explicit EditScope(RangeRenderer &renderer);
+			~EditScope();
+			EditScope(const EditScope &) = delete;
+			EditScope &operator=(const EditScope &) = delete;
+
+			SongRenderer *operator->() const { return renderer.songRenderer; }
+			SongRenderer &GetSongRenderer() const { return *renderer.songRenderer; }
+
+		private:
+			RangeRenderer &renderer;
+			WaveSabreCore::Arena::Scope arenaScope;
+			WaveSabreCore::RenderContext::Scope renderContextScope;
+		};
+		EditScope Edit() { return EditScope{ *this }; }
+
+		size_t GetSnapshotBytes() const;
+
+	private:
+		void renderBlocks(Sample *buffer, int numFrames);
+		void endEdit();
+
+		WaveSabreCore::Arena arena;
+		SongRenderer *songRenderer;
+		int lengthFrames;
+		int intervalFrames;
+		int position = 0;
+		int lastSnapshotPosition = -1; // where the arena last matched a snapshot, to skip re-saving it
+		std::vector<WaveSabreCore::Arena::Snapshot> snapshots; // [i] is at i * intervalFrames; empty if not taken yet
+	};
+}
+
+#endif // #ifndef MIN_SIZE_REL
+
+#endif
@@ -0,0 +1,214 @@
+#ifndef __WAVESABREPLAYERLIB_REALTIMEFEEDER_H__
+#define __WAVESABREPLAYERLIB_REALTIMEFEEDER_H__
+
+#include <stdint.h>
+
+// keeps a looping output buffer (DirectSound's) filled behind its play cursor, rendering in chunks sized from
+// how much is writable, how much is still queued, and what rendering has been costing. no Windows
+// dependencies; DirectSoundRenderThread adapts DirectSound to IRealtimeOutput, and tests use a fake.
+namespace WaveSabrePlayerLib
+{
+	// 16-bit interleaved stereo, like SongRenderer::Sample.
+	typedef void (*RealtimeRenderCallback)(int16_t *buffer, int numSamples, void *data);
+	// called once per Service() that rendered anything, with its totals: how long the render callbacks took, how
+	// much audio they rendered, and how much was still queued when it started. a wrapping chunk is two render
+	// callbacks but one service, so this is where to measure load.
+	typedef void (*RealtimeServicedCallback)(double nowMs, double renderMs, double audioMs, double headroomMs, void *data);
+
+	class IRealtimeOutput
+	{
+	public:
+		virtual ~IRealtimeOutput() {}
+
+		virtual int GetBufferSizeBytes() = 0;
+		virtual int GetPlayCursorBytes() = 0;
+		// the region may wrap, in which case it comes back in two parts (p2 / b2 are 0 otherwise).
+		virtual bool Lock(int offsetBytes, int bytes, int16_t **p1, int *b1, int16_t **p2, int *b2) = 0;
+		virtual void Unlock(int16_t *p1, int b1, int16_t *p2, int b2) = 0;
+		// any monotonic clock; only differences are used.
+		virtual double GetTimeMs() = 0;
+	};
+
+	class RenderChunkPlanner
+	{
+	public:
+		static constexpr int BlockAlign = 4; // 16-bit stereo
+		static constexpr int MinWriteBytes = 1000; // don't bother for less
+		static constexpr double CostSmoothing = 0.2;
+		static constexpr double HeadroomUse = 0.5; // a chunk may take at most this much of the queued audio to render
+
+		struct Stats
+		{
+			int Callbacks = 0;
+			int Chunks = 0;
+			int Starved = 0; // callbacks that found less than one minimum chunk queued
+			double LastHeadroomMs = 0;
+			double MinHeadroomMs = 0;
+			double AverageHeadroomMs = 0;
+			int LastChunkFrames = 0;
+			double RenderCostRatio = 0; // render time / audio time, smoothed; 0 = not measured yet
+		};
+
+		// chunks are kept between minChunkFrames and latencyBudgetMs (and never above maxChunkFrames, which is
+		// what the renderer can do in one go).
+		RenderChunkPlanner(int sampleRate, int latencyBudgetMs, int minChunkFrames = 100, int maxChunkFrames = 0x7fffffff)
+			: sampleRate(sampleRate)
+			, minChunkFrames(minChunkFrames)
+		{
+			budgetFrames = sampleRate * latencyBudgetMs / 1000;
+			if (budgetFrames > maxChunkFrames)
+				budgetFrames = maxChunkFrames;
+			if (budgetFrames < minChunkFrames)
+				budgetFrames = minChunkFrames;
+		}
+
+		// called once per service; queuedFrames is the audio still ahead of the play cursor.
+		void OnCallback(int queuedFrames)
+		{
+			double headroomMs = queuedFrames * 1000.0 / sampleRate;
+			if (!stats.Callbacks || headroomMs < stats.MinHeadroomMs)
+				stats.MinHeadroomMs = headroomMs;
+			stats.AverageHeadroomMs += (headroomMs - stats.AverageHeadroomMs) / (stats.Callbacks + 1);
+			stats.LastHeadroomMs = headroomMs;
+			stats.Callbacks++;
+			if (queuedFrames < minChunkFrames)
+				stats.Starved++;
+		}
+
+		// the chunk size to aim for. big chunks amortize the graph dispatch; when little is queued and rendering is
+		// slow, small chunks get audio to the device sooner.
+		int GetTargetChunkFrames(int queuedFrames) const
+		{
+			if (stats.RenderCostRatio <= 0)
+				return minChunkFrames; // measure before committing to anything bigger
+			double affordable = queuedFrames * HeadroomUse / stats.RenderCostRatio;
+			if (affordable >= budgetFrames)
+				return budgetFrames;
+			return affordable < minChunkFrames ? minChunkFrames : (int)affordable;
+		}
+
+		int PlanChunkFrames(int writableFrames, int queuedFrames) const
+		{
+			int frames = GetTargetChunkFrames(queuedFrames);
+			return frames < writableFrames ? frames : writableFrames;
+		}
+
+		// false while more than two chunks' worth is queued and less than one chunk is writable.
+		bool IsWorthRendering(int writableFrames, int queuedFrames) const
+		{
+			int targetFrames = GetTargetChunkFrames(queuedFrames);
+			return writableFrames >= targetFrames || queuedFrames < targetFrames * 2;
+		}
+
+		void OnChunkRendered(int frames, double elapsedMs)
+		{
+			double ratio = elapsedMs * sampleRate / (1000.0 * frames);
+			stats.RenderCostRatio = stats.RenderCostRatio > 0 ? stats.RenderCostRatio + (ratio - stats.RenderCostRatio) * CostSmoothing : ratio;
+			stats.LastChunkFrames = frames;
+			stats.Chunks++;
+		}
+
+		const Stats &GetStats() const
+		{
+			return stats;
+		}
+
+	private:
+		int sampleRate;
+		int minChunkFrames;
+		int budgetFrames;
+		Stats stats;
+	};
+
+	class RealtimeFeeder
+	{
+	public:
+		// onServiced gets callbackData too.
+		RealtimeFeeder(RealtimeRenderCallback callback, void *callbackData, int sampleRate, int latencyBudgetMs, int maxChunkFrames = 0x7fffffff,
+			RealtimeServicedCallback onServiced = nullptr)
+			: callback(callback)
+			, onServiced(onServiced)
+			, callbackData(callbackData)
+			, sampleRate(sampleRate)
+			, planner(sampleRate, latencyBudgetMs, 100, maxChunkFrames)
+		{
+		}
+
+		// renders what the play cursor has freed up since the last call, in chunks. false if there wasn't enough to bother.
+		bool Service(IRealtimeOutput &output)
+		{
+			const int bufferSizeBytes = output.GetBufferSizeBytes();
+			const int playCursorPos = output.GetPlayCursorBytes();
+			int writableBytes = playCursorPos - writeCursorPos;
+			if (writableBytes < 0)
+				writableBytes += bufferSizeBytes;
+			if (writableBytes < RenderChunkPlanner::MinWriteBytes)
+				return false;
+
+			int queuedBytes = bufferSizeBytes - writableBytes;
+			// with plenty queued, wait until a whole chunk is writable rather than dispatching every poll. a
+			// remainder smaller than a chunk is left for the next poll, so chunks stay at the target size.
+			if (!planner.IsWorthRendering(writableBytes / RenderChunkPlanner::BlockAlign, queuedBytes / RenderChunkPlanner::BlockAlign))
+				return false;
+			planner.OnCallback(queuedBytes / RenderChunkPlanner::BlockAlign);
+			const double headroomMs = queuedBytes / RenderChunkPlanner::BlockAlign * 1000.0 / sampleRate;
+			double renderMs = 0;
+			int framesRendered = 0;
+
+			do
+			{
+				int frames = planner.PlanChunkFrames(writableBytes / RenderChunkPlanner::BlockAlign, queuedBytes / RenderChunkPlanner::BlockAlign);
+				int bytes = frames * RenderChunkPlanner::BlockAlign;
+
+				int16_t *p1, *p2;
+				int b1, b2;
+				if (!output.Lock(writeCursorPos, bytes, &p1, &b1, &p2, &b2))
+					return false;
+				double start = output.GetTimeMs();
+				callback(p1, b1 / (int)sizeof(int16_t), callbackData);
+				if (b2) callback(p2, b2 / (int)sizeof(int16_t), callbackData);
+				double elapsedMs = output.GetTimeMs() - start;
+				planner.OnChunkRendered(frames, elapsedMs);
+				output.Unlock(p1, b1, p2, b2);
+				renderMs += elapsedMs;
+				framesRendered += frames;
+
+				writeCursorPos = (writeCursorPos + bytes) % bufferSizeBytes;
+				bytesWritten += bytes;
+				writableBytes -= bytes;
+				queuedBytes += bytes;
+			} while (writableBytes >= RenderChunkPlanner::BlockAlign &&
+				planner.IsWorthRendering(writableBytes / RenderChunkPlanner::BlockAlign, queuedBytes / RenderChunkPlanner::BlockAlign));
+			if (onServiced)
+				onServiced(output.GetTimeMs(), renderMs, framesRendered * 1000.0 / sampleRate, headroomMs, callbackData);
+			return true;
+		}
+
+		// where the next chunk goes.
+		int GetWriteCursorBytes() const
+		{
+			return writeCursorPos;
+		}
+
+		double GetBytesWritten() const
+		{
+			return bytesWritten;
+		}
+
+		const RenderChunkPlanner::Stats &GetStats() const
+		{
+			return planner.GetStats();
+		}
+
+	private:
+		RealtimeRenderCallback callback;
+		RealtimeServicedCallback onServiced;
+		void *callbackData;
+		int sampleRate;
+		RenderChunkPlanner planner;
+		int writeCursorPos = 0;
+		double bytesWritten = 0;
+	};
+}
+
+#endif
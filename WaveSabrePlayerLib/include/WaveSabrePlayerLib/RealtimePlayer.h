@@ -4,13 +4,15 @@
 #include "IPlayer.h"
 #include "SongRenderer.h"
 #include "DirectSoundRenderThread.h"
+#include "QualityLadder.h"
 
 namespace WaveSabrePlayerLib
 {
 	class RealtimePlayer : public IPlayer
 	{
 	public:
-		explicit RealtimePlayer(int numRenderThreads, int bufferSizeMs = 1000);
+		// chunkBudgetMs bounds how much is rendered per graph dispatch; see DirectSoundRenderThread.
+		explicit RealtimePlayer(int numRenderThreads, int bufferSizeMs = 1000, int chunkBudgetMs = 20);
 		virtual ~RealtimePlayer();
 
 		virtual void Play();
@@ -20,15 +22,34 @@ namespace WaveSabrePlayerLib
 		//virtual double GetLength() const;
 		virtual double GetSongPos() const;
 
+		// headroom / chunk size statistics of the render thread, for profiling.
+		RenderChunkPlanner::Stats GetChunkStats() const;
+
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+		// 0 = full quality; see QualityLadder.
+		int GetQualityLevel() const;
+#endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
+
 	private:
 		static void renderCallback(SongRenderer::Sample *buffer, int numSamples, void *data);
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+		static void servicedCallback(double nowMs, double renderMs, double audioMs, double headroomMs, void *data);
+#endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 
 		const WaveSabreCore::Song *song;
 		int numRenderThreads;
 		int bufferSizeMs;
+		int chunkBudgetMs;
 
 		SongRenderer *songRenderer;
 		DirectSoundRenderThread *renderThread;
+
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+		// steps quality / polyphony down when chunks come close to their deadline, rather than glitching.
+		// only touched from the render thread (and while it isn't running).
+		QualityLadder qualityLadder;
+		QualityGovernor governor;
+#endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 	};
 }
 
@@ -2,6 +2,12 @@
 
 #include <new>     // for placement new
 #include <WaveSabreCore.h>
+#ifndef MIN_SIZE_REL
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#endif // #ifndef MIN_SIZE_REL
 #include "SongRenderer2.h"
 
 namespace WaveSabrePlayerLib
@@ -275,7 +281,7 @@ using GraphProcessor = GraphProcessor2;
 	////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	struct SongRenderer : GraphProcessor::INodeList
 	{
-		enum class EventType
+		enum class EventType : uint8_t
 		{
 			NoteOff = 0,
 			NoteOn = 1,
@@ -283,21 +289,51 @@ using GraphProcessor = GraphProcessor2;
 			//PitchBend = 3,
 		};
 
-		// POD because we have it in an array and sort it during deserialization.
+		// 8 bytes; tracks walk their lane front to back during playback.
 		typedef struct
 		{
 			// samples, DELTA since the previous entry.
 			// well, most of the time. DURING deserializion this can temporarily be an absolute position.
-			int TimeStamp; 
+			int TimeStamp;
 			EventType Type;
-			int Note;
-			int Velocity;
-
-			// -1 means N/A. for oneshot tracks for example; this would not produce any note off events.
-			// For note off events this is just ignored. It's only really used during deserialization
-			// before note ons & offs are separated.
-			int DurationSamples; 
+			uint8_t Note;
+			uint8_t Velocity;
+			uint8_t Unused; // zero, so lanes can be hashed as bytes
 		} Event;
+		static_assert(sizeof(Event) == 8, "keep midi events compact");
+
+		// min-heap on TimeStamp, for pending note offs during deserialization.
+		static void PushNoteOff(Event* heap, int& size, Event e) // by value: e may live in the heap's next slot
+		{
+			int i = size++;
+			while (i > 0 && heap[(i - 1) / 2].TimeStamp > e.TimeStamp)
+			{
+				heap[i] = heap[(i - 1) / 2];
+				i = (i - 1) / 2;
+			}
+			heap[i] = e;
+		}
+
+		static Event PopNoteOff(Event* heap, int& size)
+		{
+			Event top = heap[0];
+			Event last = heap[--size];
+			int i = 0;
+			while (true)
+			{
+				int child = i * 2 + 1;
+				if (child >= size)
+					break;
+				if (child + 1 < size && heap[child + 1].TimeStamp < heap[child].TimeStamp)
+					child++;
+				if (last.TimeStamp <= heap[child].TimeStamp)
+					break;
+				heap[i] = heap[child];
+				i = child;
+			}
+			heap[i] = last;
+			return top;
+		}
 
 		class Devices
 		{
@@ -318,6 +354,8 @@ using GraphProcessor = GraphProcessor2;
 		static constexpr int NumChannels = 2;
 		static constexpr int BitsPerSample = 16;
 		static constexpr int BlockAlign = NumChannels * BitsPerSample / 8;
+		// frames between automation updates; what WavWriter and PreRenderPlayer render per step.
+		static constexpr int AutomationStepFrames = 100;
 
 		struct Track : GraphProcessor::INode
 		{
@@ -333,7 +371,7 @@ using GraphProcessor = GraphProcessor2;
 				this->songRenderer = songRenderer;
 
 				for (int i = 0; i < numBuffers; i++) {
-					Buffers[i] = new float[WaveSabreCore::Helpers::CurrentSampleRateI];// songRenderer->sampleRate];
+					Buffers[i] = WaveSabreCore::ArenaNewArray<float>(WaveSabreCore::Helpers::CurrentSampleRateI());// songRenderer->sampleRate];
 				}
 
 				isLastInBatch = !!ds.ReadUByte();
@@ -344,7 +382,7 @@ using GraphProcessor = GraphProcessor2;
 				Receives = nullptr;
 				if (NumReceives)
 				{
-					Receives = new Receive[NumReceives];
+					Receives = WaveSabreCore::ArenaNewArray<Receive>(NumReceives);
 					for (int i = 0; i < NumReceives; i++)
 					{
 						auto& r = Receives[i];
@@ -357,7 +395,7 @@ using GraphProcessor = GraphProcessor2;
 				numDevices = ds.ReadVarUInt32();
 				if (numDevices)
 				{
-					devicesIndicies = new int[numDevices];
+					devicesIndicies = WaveSabreCore::ArenaNewArray<int>(numDevices);
 					for (int i = 0; i < numDevices; i++)
 					{
 						devicesIndicies[i] = ds.ReadVarUInt32();
@@ -369,11 +407,15 @@ using GraphProcessor = GraphProcessor2;
 				numAutomations = ds.ReadVarUInt32();
 				if (numAutomations)
 				{
-					automations = new Automation * [numAutomations];
+					WaveSabreCore::ArenaSubsystemScope subsystemScope{ WaveSabreCore::MemorySubsystem::Automation };
+					automations = WaveSabreCore::ArenaNewArray<Automation*>(numAutomations);
 					for (int i = 0; i < numAutomations; i++)
 					{
 						int deviceIndex = ds.ReadVarUInt32();
 						automations[i] = new Automation(songRenderer, songRenderer->devices[devicesIndicies[deviceIndex]], ds, WaveSabreCore::kSongTimenstampScaleLog2);
+#ifndef MIN_SIZE_REL
+						automations[i]->deviceIndex = deviceIndex;
+#endif // #ifndef MIN_SIZE_REL
 					}
 				}
 
@@ -387,20 +429,20 @@ using GraphProcessor = GraphProcessor2;
 #ifdef MIN_SIZE_REL
 #pragma message("SongRenderer2::Track::~Track() Leaking memory to save bits.")
 #else
-				for (int i = 0; i < numBuffers; i++) delete[] Buffers[i];
+				for (int i = 0; i < numBuffers; i++) WaveSabreCore::ArenaDeleteArray(Buffers[i]);
 
 				if (NumReceives)
-					delete[] Receives;
+					WaveSabreCore::ArenaDeleteArray(Receives);
 
 				if (numDevices)
 				{
-					delete[] devicesIndicies;
+					WaveSabreCore::ArenaDeleteArray(devicesIndicies);
 				}
 
 				if (numAutomations)
 				{
 					for (int i = 0; i < numAutomations; i++) delete automations[i];
-					delete[] automations;
+					WaveSabreCore::ArenaDeleteArray(automations);
 				}
 #endif // MIN_SIZE_REL
 			}
@@ -412,6 +454,28 @@ using GraphProcessor = GraphProcessor2;
 
 			virtual void INode_Run(int numSamples) override
 			{
+#ifndef MIN_SIZE_REL
+				WaveSabreCore::RenderContext::Scope renderContextScope{ songRenderer->mRenderContext };
+				WaveSabreCore::Arena::Scope arenaScope{ songRenderer->mpArena };
+				WaveSabreCore::Arena::OwnerScope trackOwnerScope{ GetTrackArenaOwner(int(this - songRenderer->tracks)) };
+#endif // #ifndef MIN_SIZE_REL
+				// automation is applied once per step, so however big the caller's blocks are (the realtime player's
+				// chunks run up to its budget), a lane moves at the same rate it does in 100-frame exports. tracks
+				// without automation render the block in one go.
+				const int stepSamples = numAutomations ? AutomationStepFrames : numSamples;
+				for (int offset = 0; offset < numSamples; offset += stepSamples)
+				{
+					RunStep(offset, numSamples - offset < stepSamples ? numSamples - offset : stepSamples);
+				}
+			}
+
+		private:
+			// renders [offset, offset + numSamples) of the block into Buffers.
+			void RunStep(int offset, int numSamples)
+			{
+				float* stepBuffers[numBuffers];
+				for (int i = 0; i < numBuffers; i++) stepBuffers[i] = Buffers[i] + offset;
+
 				MidiLane& lane = songRenderer->midiLanes[midiLaneId];
 				for (; eventIndex < lane.numEvents; eventIndex++)
 				{
@@ -419,6 +483,9 @@ using GraphProcessor = GraphProcessor2;
 					int samplesToEvent = accumEventTimestamp + e.TimeStamp - lastSamplePos;
 					if (samplesToEvent >= numSamples) break;
 					for (int i = 0; i < numDevices; i++) {
+#ifndef MIN_SIZE_REL
+						WaveSabreCore::Arena::OwnerScope deviceOwnerScope{ devicesIndicies[i] };
+#endif // #ifndef MIN_SIZE_REL
 						auto pd = songRenderer->devices[devicesIndicies[i]];
 						switch (e.Type)
 						{
@@ -441,7 +508,7 @@ using GraphProcessor = GraphProcessor2;
 
 				for (int i = 0; i < numAutomations; i++) automations[i]->Run(numSamples);
 
-				for (int i = 0; i < numBuffers; i++) memset(Buffers[i], 0, numSamples * sizeof(float));
+				for (int i = 0; i < numBuffers; i++) memset(stepBuffers[i], 0, numSamples * sizeof(float));
 				for (int i = 0; i < NumReceives; i++)
 				{
 					Receive* r = &Receives[i];
@@ -449,26 +516,59 @@ using GraphProcessor = GraphProcessor2;
 					for (int j = 0; j < 2; j++)
 					{
 						for (int k = 0; k < numSamples; k++) {
-							Buffers[j + r->ReceivingChannelIndex][k] += receiveBuffers[j][k] * r->Volume;
+							stepBuffers[j + r->ReceivingChannelIndex][k] += receiveBuffers[j][offset + k] * r->Volume;
 						}
 					}
 				}
 
 				for (int i = 0; i < numDevices; i++) {
-					songRenderer->devices[devicesIndicies[i]]->Run(Buffers, Buffers, numSamples);
+#ifndef MIN_SIZE_REL
+					// devices create some state (oscillator cores, ...) on first use.
+					WaveSabreCore::Arena::OwnerScope deviceOwnerScope{ devicesIndicies[i] };
+#endif // #ifndef MIN_SIZE_REL
+					songRenderer->devices[devicesIndicies[i]]->Run(stepBuffers, stepBuffers, numSamples);
 				}
 
 				if (volume != 1.0f)
 				{
 					for (int i = 0; i < numBuffers; i++)
 					{
-						for (int j = 0; j < numSamples; j++) Buffers[i][j] *= volume;
+						for (int j = 0; j < numSamples; j++) stepBuffers[i][j] *= volume;
 					}
 				}
 
 				lastSamplePos += numSamples;
 			}
 
+		public:
+
+#ifndef MIN_SIZE_REL
+			// everything this track's own output depends on apart from what it receives: volume, receive
+			// routing, its devices' chunks, its midi lane and its automation. see IncrementalRenderer.
+			uint64_t HashInputs(uint64_t h) const
+			{
+				h = HashBytes(h, &volume, sizeof(volume));
+				h = HashBytes(h, &NumReceives, sizeof(NumReceives));
+				if (NumReceives)
+					h = HashBytes(h, Receives, sizeof(Receive) * NumReceives);
+				for (int i = 0; i < numDevices; i++)
+				{
+					h = HashBytes(h, &songRenderer->deviceChunkHashes[devicesIndicies[i]], sizeof(uint64_t));
+				}
+				const MidiLane& lane = songRenderer->midiLanes[midiLaneId];
+				h = HashBytes(h, &lane.numEvents, sizeof(lane.numEvents));
+				h = HashBytes(h, lane.events, sizeof(Event) * lane.numEvents);
+				for (int i = 0; i < numAutomations; i++)
+				{
+					h = automations[i]->HashInputs(h);
+				}
+				return h;
+			}
+
+			int GetDeviceCount() const { return numDevices; }
+			int GetDeviceIndex(int i) const { return devicesIndicies[i]; }
+#endif // #ifndef MIN_SIZE_REL
+
 		private:
 			static constexpr int numBuffers = 4;
 		public:
@@ -481,7 +581,7 @@ using GraphProcessor = GraphProcessor2;
 			bool isLastInBatch;
 
 		private:
-			class Automation
+			class Automation : public WaveSabreCore::ArenaAllocated
 			{
 			public:
 				Automation(SongRenderer* songRenderer, WaveSabreCore::Device* device, WaveSabreCore::M7::Deserializer& ds, int timestampScaleLog2)
@@ -489,7 +589,7 @@ using GraphProcessor = GraphProcessor2;
 					this->device = device;
 					paramId = ds.ReadVarUInt32();
 					numPoints = ds.ReadVarUInt32();
-					points = new Point[numPoints];
+					points = WaveSabreCore::ArenaNewArray<Point>(numPoints);
 					int lastPointTime = 0;
 					for (int i = 0; i < numPoints; i++)
 					{
@@ -508,7 +608,7 @@ using GraphProcessor = GraphProcessor2;
 				}
 				~Automation()
 				{
-					delete[] points;
+					WaveSabreCore::ArenaDeleteArray(points);
 				}
 
 				void Run(int numSamples)
@@ -538,6 +638,17 @@ using GraphProcessor = GraphProcessor2;
 					samplePos += numSamples;
 				}
 
+#ifndef MIN_SIZE_REL
+				// the devices themselves are covered by the track's device list; which of them this lane drives is not.
+				uint64_t HashInputs(uint64_t h) const
+				{
+					h = HashBytes(h, &deviceIndex, sizeof(deviceIndex));
+					h = HashBytes(h, &paramId, sizeof(paramId));
+					h = HashBytes(h, &numPoints, sizeof(numPoints));
+					return HashBytes(h, points, sizeof(Point) * numPoints);
+				}
+#endif // #ifndef MIN_SIZE_REL
+
 			private:
 				typedef struct
 				{
@@ -553,6 +664,11 @@ using GraphProcessor = GraphProcessor2;
 
 				int samplePos;
 				int pointIndex;
+
+#ifndef MIN_SIZE_REL
+			public:
+				int deviceIndex = 0; // within the track's device list
+#endif // #ifndef MIN_SIZE_REL
 			};
 
 			SongRenderer* songRenderer;
@@ -573,9 +689,30 @@ using GraphProcessor = GraphProcessor2;
 		}; // class track
 
 
+#ifdef MIN_SIZE_REL
 		explicit SongRenderer(int numRenderThreads)
 		{
-			WaveSabreCore::M7::Deserializer ds{ (const uint8_t*)WaveSabreCore::gSong.blob };
+			const WaveSabreCore::Song& song = WaveSabreCore::gSong;
+#else
+		explicit SongRenderer(int numRenderThreads) :
+			SongRenderer(WaveSabreCore::gSong, numRenderThreads, true)
+		{
+		}
+
+		// song must be an export of the same layout as the linked one (the kSong* counts are compile-time).
+		// without graph threads, the caller runs the tracks itself (see BatchRenderer); RenderSamples() is unavailable.
+		SongRenderer(const WaveSabreCore::Song& song, int numRenderThreads, bool createGraphThreads)
+		{
+			WaveSabreCore::RenderContext::Scope renderContextScope{ mRenderContext };
+			if (!mpArena)
+			{
+				mpOwnedArena.reset(new WaveSabreCore::Arena());
+				mpArena = mpOwnedArena.get();
+			}
+			mpArena->EnableAccounting(kArenaOwnerCount);
+			WaveSabreCore::Arena::Scope arenaScope{ mpArena };
+#endif // #ifdef MIN_SIZE_REL
+			WaveSabreCore::M7::Deserializer ds{ (const uint8_t*)song.blob };
 
 			//ds.ReadUInt32(); // assert(r = WSBR)
 			//ds.ReadUInt32(); // assert 4-byte version
@@ -589,28 +726,33 @@ using GraphProcessor = GraphProcessor2;
 			// deserialize all devices
 			//numDevices = ds.ReadUInt32();
 			//devices = new WaveSabreCore::Device * [kSongDeviceCount];
+#ifdef MIN_SIZE_REL
 			for (int i = 0; i < WaveSabreCore::kSongDeviceCount; i++)
 			{
 				auto& d = devices[i];
-				d = WaveSabreCore::gSong.factory((WaveSabreCore::DeviceId)ds.ReadUByte());
+				d = song.factory((WaveSabreCore::DeviceId)ds.ReadUByte());
 				//d->SetSampleRate(HARD_CODED_SAMPLE_RATE);// (float)sampleRate);
-#ifndef MIN_SIZE_REL
-				// min-size builds hard-code bpm.
-				d->SetTempo(WaveSabreCore::kSongTempoBPM);
-#endif // #ifndef MIN_SIZE_REL
 				int chunkSize = ds.ReadVarUInt32();
 				const uint8_t* expectedCursor = ds.mpCursor + chunkSize;
+				ds.mpEnd = expectedCursor;
 				d->SetBinary16DiffChunk(ds);
 				CCASSERT(expectedCursor == ds.mpCursor);
 				//ds.mpCursor += chunkSize;
 			}
+			ds.mpEnd = nullptr;
+#else
+			ds.mpCursor = DeserializeDevices(song.factory, ds.mpCursor, numRenderThreads);
+#endif // #ifdef MIN_SIZE_REL
 
 			// we need to do extra work to separate note ons & note offs.
 			// the payload contains just note+duration data;
 
 			// deserialize all midi event lanes
 			//numMidiLanes = ds.ReadUInt32();
-			midiLanes = new MidiLane[WaveSabreCore::kSongMidiLaneCount];
+			{
+				WaveSabreCore::ArenaSubsystemScope subsystemScope{ WaveSabreCore::MemorySubsystem::Events };
+				midiLanes = WaveSabreCore::ArenaNewArray<MidiLane>(WaveSabreCore::kSongMidiLaneCount);
+			}
 			for (int i = 0; i < WaveSabreCore::kSongMidiLaneCount; i++)
 			{
 				int flags = ds.ReadUByte();
@@ -620,23 +762,29 @@ using GraphProcessor = GraphProcessor2;
 
 				int numEvents = ds.ReadUInt32();
 				auto& midiLane = midiLanes[i];
-				midiLane.numEvents = numEvents;
-				midiLane.events = new Event[numEvents * 2]; // pre-emptively allocate enough for note off events
+				midiLane.numEvents = numEvents * 2;
+				// noteOffs is scratch for the merge below, freed right after it. its block goes back on the arena's
+				// free list for the next lane, and the Events account only counts it while it's live.
+				Event* noteOffs;
+				{
+					WaveSabreCore::ArenaSubsystemScope subsystemScope{ WaveSabreCore::MemorySubsystem::Events };
+					midiLane.events = WaveSabreCore::ArenaNewArray<Event>(numEvents * 2); // room for a note off per note
+					noteOffs = WaveSabreCore::ArenaNewArray<Event>(numEvents);
+				}
 
-				// timestamps
+				// note ons go in the upper half, with absolute timestamps. the payload has them sorted.
+				Event* noteOns = midiLane.events + numEvents;
 				int timestampCursor = 0;
 				for (int m = 0; m < numEvents; m++)
 				{
-					auto& e = midiLane.events[m];
+					auto& e = noteOns[m];
 					auto t = ds.ReadVarUInt32();
-					//e.Type = (EventType)(t & 3);
-					//e.TimeStamp = t >> 2;
-					e.Type = EventType::NoteOn;
 					timestampCursor += t << WaveSabreCore::kSongTimenstampScaleLog2;
-					e.TimeStamp = timestampCursor; // NB: this is now an absolute time! to be later handled
+					e.TimeStamp = timestampCursor;
+					e.Type = EventType::NoteOn;
 					e.Note = 60;
 					e.Velocity = 100;
-					e.DurationSamples = -1;
+					e.Unused = 0;
 				}
 
 				// note value field.
@@ -644,7 +792,7 @@ using GraphProcessor = GraphProcessor2;
 				{
 					for (int m = 0; m < numEvents; m++)
 					{
-						midiLane.events[m].Note = ds.ReadUByte();
+						noteOns[m].Note = ds.ReadUByte();
 					}
 				}
 
@@ -653,75 +801,239 @@ using GraphProcessor = GraphProcessor2;
 				{
 					for (int m = 0; m < numEvents; m++)
 					{
-						midiLane.events[m].Velocity = ds.ReadUByte();
+						noteOns[m].Velocity = ds.ReadUByte();
 					}
 				}
 
-				// duration field
+				// duration field; note offs in note on order, so not sorted.
 				for (int m = 0; m < numEvents; m++)
 				{
-					midiLane.events[m].DurationSamples = oneShot ?
+					int duration = oneShot ?
 						WaveSabreCore::kSongOneshotDurationSamples :
 						ds.ReadVarUInt32() << WaveSabreCore::kSongNoteDurationScaleLog2;
+					auto& off = noteOffs[m];
+					off = noteOns[m];
+					off.TimeStamp += duration;
+					off.Type = EventType::NoteOff;
+					off.Velocity = 0;
 				}
 
-				// now we have a collection of notes, but we need to convert it to a list of note on / note off pairs.
-				midiLane.numEvents *= 2;
-				// we already have the space allocated. we need to fill that extra space with the note off events with absolute timestamps.
-				// then, use qsort() based on timestamp
-				// then, delta encode because that's what the graph processor wants.
-
-				auto noteOffCursor = midiLane.events + numEvents; // array position where we can write to.
-
-				for (int m = 0; m < numEvents; m++)
-				{
-					auto& e = midiLane.events[m];
-					noteOffCursor->Note = e.Note;
-					noteOffCursor->TimeStamp = e.TimeStamp + e.DurationSamples;
-					noteOffCursor->Type = EventType::NoteOff;
-					noteOffCursor++;
-				}
-
-				qsort(midiLane.events, midiLane.numEvents, sizeof(midiLane.events[0]), [](const void* a, const void* b) {
-					Event* eventA = (Event*)a;
-					Event* eventB = (Event*)b;
-					return eventA->TimeStamp - eventB->TimeStamp;
-					});
-
-				// delta encode.
+				// merge the sorted note ons with a min-heap of the offs of notes already started, delta encoding
+				// as we go. offs due at the same time as an on come first, so a retriggered note isn't cut.
+				// everything happens in place: the heap grows over noteOffs[] entries already consumed, and the
+				// output (m ons + at most m offs so far) stays behind the note on being read.
+				int heapSize = 0;
+				int outIndex = 0;
 				int lastEventTimestamp = 0;
-				for (int i = 0; i < midiLane.numEvents; i++)
-				{
-					auto& e = midiLane.events[i];
+				auto emit = [&](Event e) {
 					int t = e.TimeStamp;
 					e.TimeStamp -= lastEventTimestamp;
 					lastEventTimestamp = t;
+					midiLane.events[outIndex++] = e;
+				};
+				for (int m = 0; m < numEvents; m++)
+				{
+					const Event on = noteOns[m];
+					while (heapSize && noteOffs[0].TimeStamp <= on.TimeStamp)
+					{
+						emit(PopNoteOff(noteOffs, heapSize));
+					}
+					emit(on);
+					PushNoteOff(noteOffs, heapSize, noteOffs[m]);
+				}
+				while (heapSize)
+				{
+					emit(PopNoteOff(noteOffs, heapSize));
 				}
+				WaveSabreCore::ArenaDeleteArray(noteOffs);
 
 			} // for each midi lane
 
 			//numTracks = ds.ReadUInt32();
 			//this->INodeList_NodeCount = WaveSabreCore::kSongTrackCount;
 
+			WaveSabreCore::ArenaSubsystemScope tracksSubsystemScope{ WaveSabreCore::MemorySubsystem::Tracks };
+#ifdef MIN_SIZE_REL
 			this->tracks = (Track*)malloc(sizeof(Track) * WaveSabreCore::kSongTrackCount);
+#else
+			this->tracks = (Track*)WaveSabreCore::ArenaAllocate(sizeof(Track) * WaveSabreCore::kSongTrackCount, alignof(Track));
+#endif // #ifdef MIN_SIZE_REL
 			for (int i = 0; i < WaveSabreCore::kSongTrackCount; i++)
 			{
-				new (this->tracks + i) Track(this, WaveSabreCore::gSong.factory, ds);
+#ifndef MIN_SIZE_REL
+				WaveSabreCore::Arena::OwnerScope ownerScope{ GetTrackArenaOwner(i) };
+#endif // #ifndef MIN_SIZE_REL
+				new (this->tracks + i) Track(this, song.factory, ds);
 			}
 
 			// it's interesting to just create a thread for each track and let the system schedule (and therefore less synchronization in our threads). but it's not more efficient.
+#ifdef MIN_SIZE_REL
 			mpGraphRunner = new GraphProcessor(this);
+#else
+			if (createGraphThreads)
+			{
+				// not ArenaAllocated, so on the heap: its events are live OS / pthread objects the workers are
+				// parked on, which an arena Restore must not roll back.
+				mpGraphRunner = new GraphProcessor(this);
+			}
+			mConstructedMs = GetMillisecondsSinceProcessStart();
+#endif // #ifdef MIN_SIZE_REL
 		}
 
+#ifndef MIN_SIZE_REL
+		~SongRenderer()
+		{
+			delete mpGraphRunner; // joins its threads
+			for (int i = 0; i < WaveSabreCore::kSongTrackCount; i++)
+			{
+				tracks[i].~Track();
+			}
+			WaveSabreCore::ArenaFree(tracks);
+			for (int i = 0; i < WaveSabreCore::kSongMidiLaneCount; i++)
+			{
+				WaveSabreCore::ArenaDeleteArray(midiLanes[i].events);
+			}
+			WaveSabreCore::ArenaDeleteArray(midiLanes);
+			for (auto* d : devices)
+			{
+				delete d;
+			}
+		}
+#endif // #ifndef MIN_SIZE_REL
+
+#ifndef MIN_SIZE_REL
+		// the song's rate comes from whatever context was bound when the renderer was created (the default
+		// unless a caller binds its own); the song's tempo is baked in. bound on every thread that touches devices.
+		const WaveSabreCore::RenderContext mRenderContext{ WaveSabreCore::RenderContext::Current().mSampleRateI, WaveSabreCore::kSongTempoBPM };
+
+		// likewise the arena bound at creation is bound wherever the renderer allocates, so the whole song's
+		// state lives in it (see RangeRenderer). with none bound the renderer makes its own. either way it
+		// accounts per device and track, which keeps each one's allocations packed together.
+		WaveSabreCore::Arena* mpArena = WaveSabreCore::Arena::Current();
+		std::unique_ptr<WaveSabreCore::Arena> mpOwnedArena;
+
+		// arena owners: devices by index, then tracks.
+		static constexpr int kArenaOwnerCount = WaveSabreCore::kSongDeviceCount + WaveSabreCore::kSongTrackCount;
+		static constexpr int GetTrackArenaOwner(int trackIndex)
+		{
+			return WaveSabreCore::kSongDeviceCount + trackIndex;
+		}
+
+		WaveSabreCore::DeviceId deviceIds[WaveSabreCore::kSongDeviceCount];
+
+		// FNV-1a; for cache keys, not security.
+		static constexpr uint64_t kHashSeed = 14695981039346656037ull;
+		static uint64_t HashBytes(uint64_t h, const void* data, size_t size)
+		{
+			auto p = (const uint8_t*)data;
+			for (size_t i = 0; i < size; i++)
+			{
+				h = (h ^ p[i]) * 1099511628211ull;
+			}
+			return h;
+		}
+
+		uint64_t deviceChunkHashes[WaveSabreCore::kSongDeviceCount];
+
+		// startup profiling; milliseconds from process creation until the renderer was ready / produced its first block.
+		double mConstructedMs = 0;
+		// set by the render thread, read by whoever reports it.
+		std::atomic<double> mFirstBlockMs{ 0 };
+
+		static double GetMillisecondsSinceProcessStart()
+		{
+			FILETIME creation, exitTime, kernelTime, userTime, now;
+			if (!::GetProcessTimes(::GetCurrentProcess(), &creation, &exitTime, &kernelTime, &userTime))
+				return 0;
+			::GetSystemTimeAsFileTime(&now);
+			ULARGE_INTEGER a, b;
+			a.LowPart = creation.dwLowDateTime;
+			a.HighPart = creation.dwHighDateTime;
+			b.LowPart = now.dwLowDateTime;
+			b.HighPart = now.dwHighDateTime;
+			return double(b.QuadPart - a.QuadPart) / 10000.0; // 100ns units
+		}
+
+		// devices are independent of each other, and each chunk is length-prefixed, so find all chunk
+		// boundaries first then construct + load devices in parallel. a device's load is dominated by its
+		// own ctor / recalc (maj7 voices, filters, ...), so big projects load in roughly 1/threads the time.
+		// returns the cursor past the last device chunk.
+		const uint8_t* DeserializeDevices(WaveSabreCore::DeviceFactory factory, const uint8_t* cursor, int numThreads)
+		{
+			struct DeviceChunk
+			{
+				WaveSabreCore::DeviceId id;
+				const uint8_t* data;
+				const uint8_t* end;
+			};
+			std::vector<DeviceChunk> chunks(WaveSabreCore::kSongDeviceCount);
+			WaveSabreCore::M7::Deserializer scan{ cursor };
+			for (int i = 0; i < WaveSabreCore::kSongDeviceCount; i++)
+			{
+				auto& c = chunks[i];
+				const uint8_t* begin = scan.mpCursor;
+				c.id = (WaveSabreCore::DeviceId)scan.ReadUByte();
+				int chunkSize = scan.ReadVarUInt32();
+				c.data = scan.mpCursor;
+				c.end = c.data + chunkSize;
+				scan.mpCursor = c.end;
+				deviceChunkHashes[i] = HashBytes(kHashSeed, begin, c.end - begin); // id + chunk
+				deviceIds[i] = c.id;
+			}
+
+			std::atomic<int> nextDevice{ 0 };
+			auto worker = [&]() {
+				WaveSabreCore::RenderContext::Scope renderContextScope{ mRenderContext };
+				WaveSabreCore::Arena::Scope arenaScope{ mpArena };
+				for (int i = nextDevice++; i < WaveSabreCore::kSongDeviceCount; i = nextDevice++)
+				{
+					auto& c = chunks[i];
+					WaveSabreCore::Arena::OwnerScope ownerScope{ i };
+					devices[i] = factory(c.id);
+					WaveSabreCore::M7::Deserializer ds{ c.data };
+					ds.mpEnd = c.end;
+					devices[i]->SetBinary16DiffChunk(ds);
+					CCASSERT(c.end == ds.mpCursor);
+				}
+			};
+
+			// the calling thread takes part too.
+			int numWorkers = (numThreads < WaveSabreCore::kSongDeviceCount ? numThreads : WaveSabreCore::kSongDeviceCount) - 1;
+			std::vector<std::thread> workers;
+			for (int i = 0; i < numWorkers; i++)
+			{
+				workers.emplace_back(worker);
+			}
+			worker();
+			for (auto& t : workers)
+			{
+				t.join();
+			}
+			return scan.mpCursor;
+		}
+#endif // #ifndef MIN_SIZE_REL
+
 		void RenderSamples(Sample* buffer, int numSamples)
 		{
 			mpGraphRunner->ProcessGraph(numSamples);
+#ifndef MIN_SIZE_REL
+			if (!mFirstBlockMs.load(std::memory_order_relaxed))
+			{
+				mFirstBlockMs.store(GetMillisecondsSinceProcessStart(), std::memory_order_relaxed);
+			}
+#endif // #ifndef MIN_SIZE_REL
 
 			// Copy final output
-			float** masterTrackBuffers = tracks[WaveSabreCore::kSongTrackCount - 1].Buffers;
+			CopyTrackOutput(WaveSabreCore::kSongTrackCount - 1, buffer, numSamples);
+		}
+
+		// interleaves a track's last rendered block to 16-bit stereo. the last track is the master.
+		void CopyTrackOutput(int trackIndex, Sample* buffer, int numSamples)
+		{
+			float** trackBuffers = tracks[trackIndex].Buffers;
 			for (int i = 0; i < numSamples; i++)
 			{
-				buffer[i] = WaveSabreCore::M7::math::Sample32To16(masterTrackBuffers[i & 1][i >> 1]);
+				buffer[i] = WaveSabreCore::M7::math::Sample32To16(trackBuffers[i & 1][i >> 1]);
 			}
 		}
 
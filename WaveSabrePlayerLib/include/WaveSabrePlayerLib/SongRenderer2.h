@@ -19,11 +19,11 @@ namespace WaveSabrePlayerLib
 
 		struct Worker
 		{
-			HANDLE mWorkAvailableEvent;
-			HANDLE mWorkCompleteEvent;
+			WaveSabreCore::Event mWorkAvailableEvent;
+			WaveSabreCore::Event mWorkCompleteEvent;
 			INodeList* mNodeList;
-			HANDLE mThreadHandle;
-			int mNodeIndexToBeProcessed;
+			WaveSabreCore::Thread mThread;
+			int mNodeIndexToBeProcessed; // -1 tells the thread to exit
 			int mNumFrames;
 		};
 
@@ -36,21 +36,28 @@ namespace WaveSabrePlayerLib
 			for (int i = 0; i < WaveSabreCore::kSongMaxThreads; i++)
 			{
 				auto& worker = mWorkers[i];
-				worker.mWorkAvailableEvent = CreateEvent(0, FALSE, FALSE, 0);
-				worker.mWorkCompleteEvent = CreateEvent(0, FALSE, FALSE, 0);
 				worker.mNodeList = nodeList;
-				worker.mThreadHandle = CreateThread(0, 0, renderThreadProc, &worker, 0, 0);
+				worker.mThread.Start(renderThreadProc, &worker);
 				// on one hand this pulls in a DLL import, on the other hand a few bytes of text is trivial and this helps us get down to the precalc requirement.
-				SetThreadPriority(worker.mThreadHandle, THREAD_PRIORITY_ABOVE_NORMAL);
+				worker.mThread.SetPriority(WaveSabreCore::ThreadPriority::AboveNormal);
 			}
 		}
 
 		~GraphProcessor2()
 		{
-			// TODO: this.
+#ifdef MIN_SIZE_REL
 			// currently, since this is not in the VST, we don't really care much as this is a fire-once kind of class.
 			// ideally we would join all threads, close handles, close event handles ... but it will never be relevant.
 #pragma message("GraphProcessor2::~GraphProcessor2() Leaking memory to save bits.")
+#else
+			// offline tools create and destroy many of these; stop the threads so nothing outlives the node list.
+			for (auto& worker : mWorkers)
+			{
+				worker.mNodeIndexToBeProcessed = -1;
+				worker.mWorkAvailableEvent.Set();
+				worker.mThread.Join();
+			}
+#endif // MIN_SIZE_REL
 		}
 
 		void ProcessGraph(int numSamples)
@@ -67,7 +74,7 @@ namespace WaveSabrePlayerLib
 				auto& worker = mWorkers[currentBatchNodeIndex];
 				worker.mNodeIndexToBeProcessed = iExecOrder;
 				worker.mNumFrames = numFrames;
-				SetEvent(worker.mWorkAvailableEvent); // signal work is available.
+				worker.mWorkAvailableEvent.Set(); // signal work is available.
 				currentBatchNodeIndex ++; // assume enough threads (done by previous serialization)
 				if (mNodeList->INodeList_IsNodeLastInBatch(iExecOrder))
 				{
@@ -76,22 +83,26 @@ namespace WaveSabrePlayerLib
 					for (int i = 0; i < currentBatchNodeIndex; i++)
 					{
 						auto& worker = mWorkers[i];
-						WaitForSingleObject(worker.mWorkCompleteEvent, INFINITE);
-						ResetEvent(worker.mWorkCompleteEvent);
+						worker.mWorkCompleteEvent.Wait();
+						worker.mWorkCompleteEvent.Reset();
 					}
 					currentBatchNodeIndex = 0;
 				}
 			}
 		}
 
-		static DWORD WINAPI renderThreadProc(LPVOID lpParameter)
+		static WaveSabreCore::ThreadResult WS_THREADAPI renderThreadProc(void* lpParameter)
 		{
 			Worker* worker = (Worker*)lpParameter;
 			while (true)
 			{
-				WaitForSingleObject(worker->mWorkAvailableEvent, INFINITE);
+				worker->mWorkAvailableEvent.Wait();
+#ifndef MIN_SIZE_REL
+				if (worker->mNodeIndexToBeProcessed < 0)
+					break;
+#endif // MIN_SIZE_REL
 				worker->mNodeList->INodeList_GetNode(worker->mNodeIndexToBeProcessed)->INode_Run(worker->mNumFrames);
-				SetEvent(worker->mWorkCompleteEvent);
+				worker->mWorkCompleteEvent.Set();
 			}
 			return 0;
 		}
@@ -0,0 +1,44 @@
+#ifndef __WAVESABREPLAYERLIB_STEMWRITER_H__
+#define __WAVESABREPLAYERLIB_STEMWRITER_H__
+
+#ifndef MIN_SIZE_REL
+
+#include <stdio.h>
+
+#include "SongRenderer.h"
+
+namespace WaveSabrePlayerLib
+{
+	// writes the post-fader output of selected tracks during a single render of the song, instead of
+	// one render per solo configuration. each track's Buffers already hold exactly that after the graph
+	// runs, so tapping them costs a copy. files are written on a separate thread so the graph never
+	// waits on the disk.
+	class StemWriter
+	{
+	public:
+		typedef void (*ProgressCallback)(double progress, void *data);
+
+		explicit StemWriter(int numRenderThreads);
+		~StemWriter();
+
+		// both return false without rendering if there are no tracks, a track index is past the last track
+		// or a file can't be opened, and false after rendering if a file couldn't be fully written or closed.
+		// either way the files it created are removed again.
+
+		// one stereo WAV per track. trackIndices[i] goes to fileNames[i]; -1 is the master.
+		bool WriteStems(const int *trackIndices, const char *const *fileNames, int numTracks, ProgressCallback callback, void *data);
+
+		// one WAV with a stereo pair per track, in the given order.
+		bool WriteMultichannel(const int *trackIndices, int numTracks, const char *fileName, ProgressCallback callback, void *data);
+
+	private:
+		static bool validTracks(const int *trackIndices, int numTracks);
+		bool write(const int *trackIndices, int numTracks, FILE **files, int numFiles, ProgressCallback callback, void *data);
+
+		SongRenderer *songRenderer;
+	};
+}
+
+#endif // #ifndef MIN_SIZE_REL
+
+#endif
@@ -17,6 +17,12 @@ namespace WaveSabrePlayerLib
 
 		void Write(const char *fileName, ProgressCallback callback, void *data);
 
+#ifndef MIN_SIZE_REL
+		// 16-bit PCM header for numFrames frames; more than 2 channels uses WAVE_FORMAT_EXTENSIBLE.
+		// false (and nothing written) if the data won't fit a RIFF file's 32-bit sizes, or if the write fails.
+		static bool WriteHeader(FILE *file, int sampleRate, int numChannels, int numFrames);
+#endif // #ifndef MIN_SIZE_REL
+
 	private:
 		static void writeInt(int i, FILE *file);
 		static void writeShort(short s, FILE *file);
@@ -11,18 +11,23 @@ namespace WSPlayerApp
     {
         Renderer& mRenderer;
 
-        WSTime gPlayTime; // in song time, not relative to playtimeoffset.
+        AtomicWSTime gPlayTime; // in song time, not relative to playtimeoffset.
         WSTime mPlayTimeOffset; // specifies where to begin playing from.
 
         std::atomic_bool mShouldStop = false;
-        HANDLE hPlayThread = 0;
+        std::atomic_bool mIsBuffering = false; // paused waiting for rendering
+        WaveSabreCore::Thread mPlayThread;
 
         WaveOutPlayer(Renderer& r) : mRenderer(r)
         {
         }
 
         bool IsPlaying() const {
-            return !!hPlayThread;
+            return mPlayThread.IsStarted();
+        }
+
+        bool IsBuffering() const {
+            return mIsBuffering;
         }
 
         void PlayFrom(WSTime t)
@@ -31,21 +36,20 @@ namespace WSPlayerApp
             Reset();
             mShouldStop = false;
             mPlayTimeOffset = t;
-            hPlayThread = CreateThread(0, 0, PlayThread, this, 0, 0);
+            mPlayThread.Start(PlayThread, this);
         }
 
         void Reset()
         {
-            if (hPlayThread) {
+            if (mPlayThread.IsStarted()) {
                 mShouldStop = true;
-                WaitForSingleObject(hPlayThread, INFINITE);
-                CloseHandle(hPlayThread);
-                hPlayThread = 0;
+                mPlayThread.Join();
             }
         }
 
-        static DWORD WINAPI PlayThread(void* pthis) {
-            return ((WaveOutPlayer*)pthis)->PlayThread2();
+        static WaveSabreCore::ThreadResult WS_THREADAPI PlayThread(void* pthis) {
+            ((WaveOutPlayer*)pthis)->PlayThread2();
+            return 0;
         }
         DWORD PlayThread2()
         {
@@ -53,7 +57,7 @@ namespace WSPlayerApp
             auto waveHdr = mRenderer.WaveHDR;
             auto byteOffset = mPlayTimeOffset.GetBytes();
             waveHdr.lpData += byteOffset;
-            waveHdr.dwBufferLength -= byteOffset;
+            waveHdr.dwBufferLength -= (DWORD)byteOffset;
             MMRESULT result = waveOutOpen(&hWaveOut, WAVE_MAPPER, &mRenderer.WaveFMT, NULL, 0, CALLBACK_NULL);
 #ifndef MIN_SIZE_REL
             if (result != MMSYSERR_NOERROR)
@@ -83,12 +87,23 @@ namespace WSPlayerApp
                       0
                     };
                     waveOutGetPosition(hWaveOut, &MMTime, sizeof(MMTime));
-                    gPlayTime.SetFrames(MMTime.u.sample + mPlayTimeOffset.GetFrames());
-                    int percentComplete = gPlayTime.AsPercentOf(mRenderer.gSongLength);
+                    auto playTime = WSTime::FromFrames(MMTime.u.sample + mPlayTimeOffset.GetFrames());
+                    gPlayTime.Store(playTime);
+                    int percentComplete = playTime.AsPercentOf(mRenderer.gSongLength);
                     if (percentComplete >= 100) {
                         break;
                     }
-                    Sleep(gGeneralSleepPeriodMS);
+                    if (mRenderer.Schedule(true, playTime) == PlaybackScheduler::Action::Pause) {
+                        // about to play unrendered audio; hold here until the rest is predicted to render in time.
+                        waveOutPause(hWaveOut);
+                        mIsBuffering = true;
+                        while (!mShouldStop && mRenderer.Schedule(false, playTime) != PlaybackScheduler::Action::Play) {
+                            WaveSabreCore::SleepMilliseconds(gGeneralSleepPeriodMS);
+                        }
+                        mIsBuffering = false;
+                        waveOutRestart(hWaveOut);
+                    }
+                    WaveSabreCore::SleepMilliseconds(gGeneralSleepPeriodMS);
                 }
 
                 waveOutReset(hWaveOut);
@@ -97,7 +112,7 @@ namespace WSPlayerApp
             waveOutUnprepareHeader(hWaveOut, &waveHdr, sizeof(waveHdr));
             waveOutClose(hWaveOut);
             hWaveOut = 0;
-            gPlayTime.SetFrames(0);
+            gPlayTime.Store(WSTime{});
 #endif
             return 0;
         }
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cmath>
+
+namespace WSPlayerApp
+{
+    // min / max / RMS of a song's stereo output at every power-of-two resolution, built incrementally by one
+    // writer (the render thread) and readable from any thread without locking.
+    //
+    // level 0 summarizes kBaseFrames frames per bucket; each level above summarizes pairs of the level below.
+    // a bucket is only written once, when its last frame arrives, and a parent is written right after its
+    // second child. the count of completed level 0 buckets is then published (release), so a reader that
+    // loads it (acquire) can use any bucket covered by it, at any level, while the writer keeps going.
+    //
+    // a query decomposes its range into aligned buckets, largest first (like a segment tree), so it touches
+    // O(log range) buckets regardless of song length; drawing W columns at any zoom is O(W log).
+    struct WaveformPyramid
+    {
+        static constexpr int kBaseFramesLog2 = 8;
+        static constexpr int64_t kBaseFrames = int64_t(1) << kBaseFramesLog2;
+        static constexpr int kMaxLevels = 40;
+
+        struct Bucket
+        {
+            int16_t mMin;
+            int16_t mMax;
+            uint64_t mSumSquares; // over both channels
+        };
+
+        struct Summary
+        {
+            int16_t mMin = 0;
+            int16_t mMax = 0;
+            int32_t mRms = 0; // same scale as the samples
+            bool IsEmpty() const
+            {
+                return mMin > mMax;
+            }
+        };
+
+        explicit WaveformPyramid(int64_t songFrames) :
+            mSongFrames(songFrames),
+            mBaseBucketCount((songFrames + kBaseFrames - 1) >> kBaseFramesLog2)
+        {
+            int64_t total = 0;
+            for (int64_t n = mBaseBucketCount; n > 0 && mLevelCount < kMaxLevels; n >>= 1)
+            {
+                mLevelOffsets[mLevelCount++] = total;
+                total += n;
+            }
+            mBuckets = new Bucket[total > 0 ? total : 1]; // lives as long as the app; not freed.
+            ResetAccumulator();
+        }
+
+        // writer only.
+        void ProcessFrame(int16_t s0, int16_t s1)
+        {
+            if (mFramesProcessed >= mSongFrames) // the last render block can overshoot the song
+                return;
+            Accumulate(s0);
+            Accumulate(s1);
+            ++mFramesProcessed;
+            if ((mFramesProcessed & (kBaseFrames - 1)) == 0 || mFramesProcessed == mSongFrames)
+                CommitBucket();
+        }
+
+        int64_t GetSongFrames() const
+        {
+            return mSongFrames;
+        }
+
+        // frames that are summarized and safe to query (from any thread).
+        int64_t GetCompletedFrames() const
+        {
+            int64_t buckets = mCompletedBuckets.load(std::memory_order_acquire);
+            int64_t frames = buckets << kBaseFramesLog2;
+            return frames < mSongFrames ? frames : mSongFrames;
+        }
+
+        // summary of frames [frameBegin, frameEnd), at kBaseFrames granularity (the range is widened to whole
+        // buckets). only the completed part is considered; IsEmpty() if none of it is.
+        Summary Query(int64_t frameBegin, int64_t frameEnd) const
+        {
+            int64_t b = frameBegin >> kBaseFramesLog2;
+            int64_t end = (frameEnd + kBaseFrames - 1) >> kBaseFramesLog2;
+            const int64_t completed = mCompletedBuckets.load(std::memory_order_acquire);
+            if (end > completed)
+                end = completed;
+
+            Summary ret;
+            ret.mMin = INT16_MAX;
+            ret.mMax = INT16_MIN;
+            uint64_t sumSquares = 0;
+            int64_t baseBuckets = 0;
+            while (b < end)
+            {
+                // the biggest aligned bucket starting at b that doesn't run past end.
+                int level = 0;
+                while (level + 1 < mLevelCount && (b & ((int64_t(2) << level) - 1)) == 0 &&
+                       b + (int64_t(2) << level) <= end)
+                {
+                    ++level;
+                }
+                const Bucket& bucket = mBuckets[mLevelOffsets[level] + (b >> level)];
+                if (bucket.mMin < ret.mMin)
+                    ret.mMin = bucket.mMin;
+                if (bucket.mMax > ret.mMax)
+                    ret.mMax = bucket.mMax;
+                sumSquares += bucket.mSumSquares;
+                baseBuckets += int64_t(1) << level;
+                b += int64_t(1) << level;
+            }
+            if (baseBuckets)
+            {
+                // the song's last bucket can be partial; counting it as whole only understates the tail's RMS.
+                double samples = double(baseBuckets << kBaseFramesLog2) * 2;
+                ret.mRms = (int32_t)std::sqrt(sumSquares / samples);
+            }
+            return ret;
+        }
+
+    private:
+        void Accumulate(int16_t s)
+        {
+            if (s < mAccumulator.mMin)
+                mAccumulator.mMin = s;
+            if (s > mAccumulator.mMax)
+                mAccumulator.mMax = s;
+            mAccumulator.mSumSquares += uint64_t(int32_t(s) * int32_t(s));
+        }
+
+        void ResetAccumulator()
+        {
+            mAccumulator = { INT16_MAX, INT16_MIN, 0 };
+        }
+
+        void CommitBucket()
+        {
+            const int64_t completed = mCompletedBuckets.load(std::memory_order_relaxed); // only we write it
+            int64_t index = completed;
+            mBuckets[index] = mAccumulator;
+            ResetAccumulator();
+
+            // a bucket with an odd index completes its parent.
+            for (int level = 1; level < mLevelCount && (index & 1); ++level)
+            {
+                const Bucket* children = &mBuckets[mLevelOffsets[level - 1] + (index & ~int64_t(1))];
+                index >>= 1;
+                Bucket& parent = mBuckets[mLevelOffsets[level] + index];
+                parent.mMin = children[0].mMin < children[1].mMin ? children[0].mMin : children[1].mMin;
+                parent.mMax = children[0].mMax > children[1].mMax ? children[0].mMax : children[1].mMax;
+                parent.mSumSquares = children[0].mSumSquares + children[1].mSumSquares;
+            }
+
+            mCompletedBuckets.store(completed + 1, std::memory_order_release);
+        }
+
+        const int64_t mSongFrames;
+        const int64_t mBaseBucketCount;
+        int mLevelCount = 0;
+        int64_t mLevelOffsets[kMaxLevels];
+        Bucket* mBuckets;
+
+        // writer state
+        int64_t mFramesProcessed = 0;
+        Bucket mAccumulator;
+
+        std::atomic<int64_t> mCompletedBuckets{ 0 }; // level 0 buckets; the publication watermark
+    };
+
+} // namespace WSPlayerApp
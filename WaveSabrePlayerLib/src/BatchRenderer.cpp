@@ -0,0 +1,348 @@
+#include <WaveSabrePlayerLib/BatchRenderer.h>
+#include <WaveSabrePlayerLib/WavWriter.h>
+
+#ifndef MIN_SIZE_REL
+
+#include <stdio.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace WaveSabrePlayerLib
+{
+	namespace
+	{
+		using Clock = std::chrono::steady_clock;
+
+		// the automation step WavWriter and PreRenderPlayer render in, so exports land on the same grid.
+		// tracks apply automation per step whatever the block size, but a block that's a whole number of
+		// steps keeps them from splitting steps at block boundaries.
+		constexpr int kBlockFrames = SongRenderer::AutomationStepFrames;
+		constexpr int kTrackCount = (int)WaveSabreCore::kSongTrackCount;
+
+		struct JobState
+		{
+			BatchRenderer::Job* job;
+			SongRenderer* renderer = nullptr;
+			FILE* file = nullptr;
+			int trackIndex;
+			int totalFrames;
+			int framesDone = 0;
+			int blockFrames = 0;
+			int batchBegin = 0;
+			int batchEnd = 0; // exclusive
+			std::atomic<int> tracksOutstanding{ 0 };
+			Clock::time_point start;
+			std::vector<SongRenderer::Sample> output;
+		};
+
+		struct Task
+		{
+			static constexpr int kLoad = -1;
+
+			JobState* jobState;
+			int trackIndex; // or kLoad
+		};
+
+		// one deque per worker. workers pop their own oldest task and steal others' oldest when they
+		// run dry; oldest-first trades a little cache locality for fair progress between jobs.
+		class Scheduler
+		{
+		public:
+			Scheduler(int numWorkers, JobState* jobs, int numJobs, BatchRenderer::ProgressCallback callback, void* data) :
+				mNumWorkers(numWorkers),
+				mQueues(new Queue[numWorkers]),
+				mJobsRemaining(numJobs),
+				mCallback(callback),
+				mCallbackData(data)
+			{
+				for (int i = 0; i < numJobs; i++)
+				{
+					if (jobs[i].job->Failed)
+					{
+						mJobsRemaining--;
+						continue;
+					}
+					mTotalFrames += jobs[i].totalFrames;
+					Push(i % numWorkers, { jobs + i, Task::kLoad });
+				}
+			}
+
+			// the calling thread is worker 0.
+			void Run()
+			{
+				std::vector<std::thread> threads;
+				for (int i = 1; i < mNumWorkers; i++)
+				{
+					threads.emplace_back([this, i]() { WorkerLoop(i); });
+				}
+				WorkerLoop(0);
+				for (auto& t : threads)
+				{
+					t.join();
+				}
+			}
+
+		private:
+			struct Queue
+			{
+				std::mutex mutex;
+				std::deque<Task> tasks;
+			};
+
+			const int mNumWorkers;
+			std::unique_ptr<Queue[]> mQueues;
+
+			std::mutex mIdleMutex;
+			std::condition_variable mIdle;
+			std::atomic<int> mQueuedTasks{ 0 };
+			std::atomic<int> mJobsRemaining;
+
+			std::mutex mProgressMutex;
+			BatchRenderer::ProgressCallback mCallback;
+			void* mCallbackData;
+			long long mTotalFrames = 0;
+			long long mFramesDone = 0;
+			int mLastProgressPermille = -1;
+
+			void Push(int worker, const Task& task)
+			{
+				{
+					std::lock_guard<std::mutex> lock(mQueues[worker].mutex);
+					mQueues[worker].tasks.push_back(task);
+				}
+				mQueuedTasks++;
+				{
+					// pairs with the predicate check in WorkerLoop so a wakeup can't be lost.
+					std::lock_guard<std::mutex> lock(mIdleMutex);
+				}
+				mIdle.notify_one();
+			}
+
+			bool TryPop(int worker, Task& task)
+			{
+				for (int i = 0; i < mNumWorkers; i++)
+				{
+					auto& queue = mQueues[(worker + i) % mNumWorkers];
+					std::lock_guard<std::mutex> lock(queue.mutex);
+					if (!queue.tasks.empty())
+					{
+						task = queue.tasks.front();
+						queue.tasks.pop_front();
+						mQueuedTasks--;
+						return true;
+					}
+				}
+				return false;
+			}
+
+			void WorkerLoop(int worker)
+			{
+				WaveSabreCore::MxcsrFlagGuard mxcsrFlagGuard;
+				while (mJobsRemaining)
+				{
+					Task task;
+					if (TryPop(worker, task))
+					{
+						RunTask(worker, task);
+						continue;
+					}
+					std::unique_lock<std::mutex> lock(mIdleMutex);
+					mIdle.wait(lock, [this]() { return mQueuedTasks > 0 || !mJobsRemaining; });
+				}
+			}
+
+			void RunTask(int worker, const Task& task)
+			{
+				auto& js = *task.jobState;
+				if (task.trackIndex == Task::kLoad)
+				{
+					if (!Load(js))
+					{
+						// counted as done, so overall progress still reaches the end.
+						ReportProgress(js.totalFrames);
+						FinishJob(js);
+						return;
+					}
+					StartBlock(worker, js);
+					return;
+				}
+
+				js.renderer->tracks[task.trackIndex].INode_Run(js.blockFrames);
+				// the worker finishing a batch schedules the next one.
+				if (--js.tracksOutstanding)
+					return;
+				js.batchBegin = js.batchEnd;
+				if (js.batchBegin < kTrackCount)
+				{
+					PushBatch(worker, js);
+					return;
+				}
+				FinishBlock(worker, js);
+			}
+
+			// false if the file can't be opened or its header written; the job is then marked failed and not rendered.
+			bool Load(JobState& js)
+			{
+				js.start = Clock::now();
+				js.file = fopen(js.job->FileName, "wb");
+				if (!js.file)
+				{
+					js.job->Failed = true;
+					return false;
+				}
+				if (!WavWriter::WriteHeader(js.file, js.job->SampleRate, SongRenderer::NumChannels, js.totalFrames))
+				{
+					fclose(js.file);
+					js.file = nullptr;
+					remove(js.job->FileName);
+					js.job->Failed = true;
+					return false;
+				}
+				// the renderer picks up its rate from the bound context.
+				const WaveSabreCore::RenderContext rate{ js.job->SampleRate, WaveSabreCore::kSongTempoBPM };
+				WaveSabreCore::RenderContext::Scope scope{ rate };
+				// jobs already load in parallel with each other.
+				js.renderer = new SongRenderer(*js.job->Song, 1, false);
+				return true;
+			}
+
+			void StartBlock(int worker, JobState& js)
+			{
+				int remaining = js.totalFrames - js.framesDone;
+				js.blockFrames = remaining < kBlockFrames ? remaining : kBlockFrames;
+				js.batchBegin = 0;
+				PushBatch(worker, js);
+			}
+
+			// a batch is a run of tracks that don't depend on each other, ending at a track flagged
+			// last-in-batch (or the master).
+			void PushBatch(int worker, JobState& js)
+			{
+				const int begin = js.batchBegin;
+				int last = begin;
+				while (last < kTrackCount - 1 && !js.renderer->INodeList_IsNodeLastInBatch(last))
+				{
+					last++;
+				}
+				// once the first task is pushed, another worker may finish the batch and move js on; use locals.
+				const int end = last + 1;
+				js.batchEnd = end;
+				js.tracksOutstanding = end - begin;
+				// spread the batch so idle workers find it without stealing from one queue.
+				for (int i = begin; i < end; i++)
+				{
+					Push((worker + i - begin) % mNumWorkers, { &js, i });
+				}
+			}
+
+			void FinishBlock(int worker, JobState& js)
+			{
+				const int numSamples = js.blockFrames * SongRenderer::NumChannels;
+				js.renderer->CopyTrackOutput(js.trackIndex, js.output.data(), numSamples);
+				if (fwrite(js.output.data(), sizeof(SongRenderer::Sample), numSamples, js.file) != (size_t)numSamples)
+				{
+					js.job->Failed = true;
+				}
+				js.framesDone += js.blockFrames;
+				ReportProgress(js.blockFrames);
+
+				if (js.framesDone < js.totalFrames)
+				{
+					StartBlock(worker, js);
+					return;
+				}
+
+				if (fclose(js.file))
+				{
+					js.job->Failed = true;
+				}
+				js.file = nullptr;
+				delete js.renderer;
+				js.renderer = nullptr;
+				FinishJob(js);
+			}
+
+			void FinishJob(JobState& js)
+			{
+				js.job->WallSeconds = std::chrono::duration<double>(Clock::now() - js.start).count();
+				js.job->RealtimeFactor = js.job->WallSeconds > 0 ?
+					(double)js.totalFrames / js.job->SampleRate / js.job->WallSeconds :
+					0;
+
+				if (!--mJobsRemaining)
+				{
+					std::lock_guard<std::mutex> lock(mIdleMutex);
+					mIdle.notify_all();
+				}
+			}
+
+			void ReportProgress(int frames)
+			{
+				if (!mCallback)
+					return;
+				std::lock_guard<std::mutex> lock(mProgressMutex);
+				mFramesDone += frames;
+				int permille = (int)(mFramesDone * 1000 / mTotalFrames);
+				if (permille != mLastProgressPermille)
+				{
+					mLastProgressPermille = permille;
+					mCallback((double)mFramesDone / mTotalFrames, mCallbackData);
+				}
+			}
+		};
+	}
+
+	BatchRenderer::BatchRenderer(int numThreads)
+	{
+		if (numThreads <= 0)
+		{
+			numThreads = (int)std::thread::hardware_concurrency();
+		}
+		this->numThreads = numThreads < 1 ? 1 : numThreads;
+	}
+
+	BatchRenderer::Stats BatchRenderer::Render(Job* jobs, int numJobs, ProgressCallback callback, void *data)
+	{
+		Stats stats = {};
+		if (numJobs <= 0)
+			return stats;
+
+		const auto start = Clock::now();
+		std::unique_ptr<JobState[]> states(new JobState[numJobs]);
+		for (int i = 0; i < numJobs; i++)
+		{
+			auto& js = states[i];
+			js.job = jobs + i;
+			js.job->Failed = jobs[i].TrackIndex >= kTrackCount;
+			js.trackIndex = jobs[i].TrackIndex < 0 ? kTrackCount - 1 : jobs[i].TrackIndex;
+			js.totalFrames = jobs[i].SampleRate * WaveSabreCore::kSongLengthSeconds;
+			js.output.resize(kBlockFrames * SongRenderer::NumChannels);
+		}
+
+		Scheduler scheduler(numThreads, states.get(), numJobs, callback, data);
+		scheduler.Run();
+
+		for (int i = 0; i < numJobs; i++)
+		{
+			if (jobs[i].Failed)
+				stats.FailedJobs++;
+			else
+				stats.AudioSeconds += WaveSabreCore::kSongLengthSeconds;
+		}
+
+		stats.WallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+		stats.RealtimeFactor = stats.WallSeconds > 0 ? stats.AudioSeconds / stats.WallSeconds : 0;
+		if (callback)
+			callback(1.0, data);
+		return stats;
+	}
+}
+
+#endif // #ifndef MIN_SIZE_REL
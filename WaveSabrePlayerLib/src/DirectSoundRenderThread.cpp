@@ -2,9 +2,59 @@
 
 namespace WaveSabrePlayerLib
 {
-	DirectSoundRenderThread::DirectSoundRenderThread(RenderCallback callback, void *callbackData, int sampleRate, int bufferSizeMs)
-		: callback(callback)
-		, callbackData(callbackData)
+	namespace
+	{
+		class DirectSoundOutput : public IRealtimeOutput
+		{
+		public:
+			DirectSoundOutput(LPDIRECTSOUNDBUFFER buffer, int bufferSizeBytes)
+				: buffer(buffer)
+				, bufferSizeBytes(bufferSizeBytes)
+			{
+				LARGE_INTEGER frequency;
+				QueryPerformanceFrequency(&frequency);
+				ticksPerMs = frequency.QuadPart / 1000.0;
+			}
+
+			virtual int GetBufferSizeBytes()
+			{
+				return bufferSizeBytes;
+			}
+
+			virtual int GetPlayCursorBytes()
+			{
+				int playCursorPos;
+				buffer->GetCurrentPosition((LPDWORD)&playCursorPos, 0);
+				return playCursorPos;
+			}
+
+			virtual bool Lock(int offsetBytes, int bytes, int16_t **p1, int *b1, int16_t **p2, int *b2)
+			{
+				return SUCCEEDED(buffer->Lock(offsetBytes, bytes, (LPVOID *)p1, (LPDWORD)b1, (LPVOID *)p2, (LPDWORD)b2, 0));
+			}
+
+			virtual void Unlock(int16_t *p1, int b1, int16_t *p2, int b2)
+			{
+				buffer->Unlock(p1, b1, p2, b2);
+			}
+
+			virtual double GetTimeMs()
+			{
+				LARGE_INTEGER now;
+				QueryPerformanceCounter(&now);
+				return now.QuadPart / ticksPerMs;
+			}
+
+		private:
+			LPDIRECTSOUNDBUFFER buffer;
+			int bufferSizeBytes;
+			double ticksPerMs;
+		};
+	}
+
+	DirectSoundRenderThread::DirectSoundRenderThread(RenderCallback callback, void *callbackData, int sampleRate, int bufferSizeMs, int chunkBudgetMs,
+		RealtimeServicedCallback onServiced)
+		: feeder(callback, callbackData, sampleRate, chunkBudgetMs, sampleRate, onServiced)
 		, sampleRate(sampleRate)
 		, bufferSizeMs(bufferSizeMs)
 		, shutdown(false)
@@ -14,10 +64,10 @@ namespace WaveSabrePlayerLib
 	{
 		bufferSizeBytes = sampleRate * SongRenderer::BlockAlign * bufferSizeMs / 1000;
 
-		thread = CreateThread(0, 0, threadProc, (LPVOID)this, 0, 0);
+		thread.Start(threadProc, this);
 
 		// on one hand this pulls in a DLL import, on the other hand a few bytes of text is trivial and this helps us get down to the precalc requirement.
-		SetThreadPriority(thread, THREAD_PRIORITY_HIGHEST);
+		thread.SetPriority(WaveSabreCore::ThreadPriority::Highest);
 	}
 
 	DirectSoundRenderThread::~DirectSoundRenderThread()
@@ -25,7 +75,7 @@ namespace WaveSabrePlayerLib
 		// We don't need to enter/leave a critical section here since we're the only writer at this point.
 		shutdown = true;
 
-		WaitForSingleObject(thread, INFINITE);
+		thread.Join();
 	}
 
 	double DirectSoundRenderThread::GetPlayPositionMs()
@@ -54,7 +104,13 @@ namespace WaveSabrePlayerLib
 		return totalBytesRead / SongRenderer::BlockAlign * 1000 / sampleRate;
 	}
 
-	DWORD WINAPI DirectSoundRenderThread::threadProc(LPVOID lpParameter)
+	RenderChunkPlanner::Stats DirectSoundRenderThread::GetChunkStats()
+	{
+		auto criticalSectionGuard = criticalSection.Enter();
+		return feeder.GetStats();
+	}
+
+	WaveSabreCore::ThreadResult WS_THREADAPI DirectSoundRenderThread::threadProc(void *lpParameter)
 	{
 		auto renderThread = (DirectSoundRenderThread *)lpParameter;
 
@@ -88,36 +144,24 @@ namespace WaveSabrePlayerLib
 
 		renderThread->buffer->Play(0, 0, DSBPLAY_LOOPING);
 
+		DirectSoundOutput output(renderThread->buffer, renderThread->bufferSizeBytes);
+
 		// We don't need to enter/leave a critical section here since there's only one writer for this value.
 		while (!renderThread->shutdown)
 		{
 			{
 				auto criticalSectionGuard = renderThread->criticalSection.Enter();
 
-				int playCursorPos;
-				renderThread->buffer->GetCurrentPosition((LPDWORD)&playCursorPos, 0);
-				int bytesToRender = playCursorPos - renderThread->oldPlayCursorPos;
-				if (bytesToRender)
+				if (renderThread->feeder.Service(output))
 				{
-					if (bytesToRender < 0) bytesToRender += renderThread->bufferSizeBytes;
-					if (bytesToRender >= 1000)
-					{
-						SongRenderer::Sample *p1, *p2;
-						int b1, b2;
-						renderThread->buffer->Lock(renderThread->oldPlayCursorPos, bytesToRender, (LPVOID *)&p1, (LPDWORD)&b1, (LPVOID *)&p2, (LPDWORD)&b2, 0);
-						renderThread->callback(p1, b1 / sizeof(SongRenderer::Sample), renderThread->callbackData);
-						if (b2) renderThread->callback(p2, b2 / sizeof(SongRenderer::Sample), renderThread->callbackData);
-						renderThread->buffer->Unlock(p1, b1, p2, b2);
-
-						auto playPositionCriticalSectionGuard = renderThread->playPositionCriticalSection.Enter();
-
-						renderThread->oldPlayCursorPos = playCursorPos;
-						renderThread->bytesRendered += bytesToRender;
-					}
+					auto playPositionCriticalSectionGuard = renderThread->playPositionCriticalSection.Enter();
+
+					renderThread->oldPlayCursorPos = renderThread->feeder.GetWriteCursorBytes();
+					renderThread->bytesRendered = renderThread->feeder.GetBytesWritten();
 				}
 			}
 
-			Sleep(3);
+			WaveSabreCore::SleepMilliseconds(3);
 		}
 
 		renderThread->buffer->Stop();
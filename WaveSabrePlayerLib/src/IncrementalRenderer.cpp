@@ -0,0 +1,248 @@
+#include <WaveSabrePlayerLib/IncrementalRenderer.h>
+#include <WaveSabrePlayerLib/WavWriter.h>
+
+#ifndef MIN_SIZE_REL
+
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <memory>
+
+namespace WaveSabrePlayerLib
+{
+	namespace
+	{
+		// the automation step, the grid every export renders on; cached outputs are only valid for the grid
+		// they were rendered on.
+		constexpr int kBlockFrames = SongRenderer::AutomationStepFrames;
+		constexpr int kTrackCount = (int)WaveSabreCore::kSongTrackCount;
+		// how much of a cache file is buffered between disk accesses.
+		constexpr int kSegmentBytes = 1 << 20;
+
+		enum class Mode
+		{
+			Skip,   // nothing being rendered depends on it
+			Read,   // cached; streamed into its buffers for the tracks that receive from it
+			Render, // run, and its output written to the cache
+		};
+
+		// wraps a track so the graph runs, reads or skips it without the graph knowing.
+		struct Node : GraphProcessor::INode
+		{
+			SongRenderer::Track* track;
+			Mode mode = Mode::Skip;
+			FILE* file = nullptr;
+			bool readFailed = false;
+			bool writeFailed = false;
+
+			virtual void INode_Run(int numFrames) override
+			{
+				switch (mode)
+				{
+				case Mode::Skip:
+					break;
+				case Mode::Read:
+					// a truncated or unreadable entry plays silence from there on, and is dropped afterwards.
+					for (int c = 0; c < 2; c++)
+					{
+						size_t read = readFailed ? 0 : fread(track->Buffers[c], sizeof(float), numFrames, file);
+						if (read < (size_t)numFrames)
+						{
+							memset(track->Buffers[c] + read, 0, sizeof(float) * (numFrames - read));
+							readFailed = true;
+						}
+					}
+					break;
+				case Mode::Render:
+					track->INode_Run(numFrames);
+					if (file && !writeFailed) // otherwise it just doesn't get cached
+					{
+						writeFailed = fwrite(track->Buffers[0], sizeof(float), numFrames, file) != (size_t)numFrames ||
+							fwrite(track->Buffers[1], sizeof(float), numFrames, file) != (size_t)numFrames;
+					}
+					break;
+				}
+			}
+		};
+
+		struct NodeList : GraphProcessor::INodeList
+		{
+			SongRenderer* songRenderer;
+			Node nodes[kTrackCount];
+
+			virtual GraphProcessor::INode* INodeList_GetNode(int i) override
+			{
+				return &nodes[i];
+			}
+
+			virtual bool INodeList_IsNodeLastInBatch(int i) const override
+			{
+				return songRenderer->INodeList_IsNodeLastInBatch(i);
+			}
+		};
+	}
+
+	IncrementalRenderer::IncrementalRenderer(int numRenderThreads, const char *cacheDirectory, uint64_t salt) :
+		numRenderThreads(numRenderThreads),
+		cacheDirectory(cacheDirectory),
+		salt(salt)
+	{
+	}
+
+	IncrementalRenderer::Stats IncrementalRenderer::Write(const char *fileName, ProgressCallback callback, void *data)
+	{
+		using Clock = std::chrono::steady_clock;
+		const auto start = Clock::now();
+		Stats stats = {};
+
+		// the graph runs through NodeList instead of the renderer's own graph.
+		std::unique_ptr<SongRenderer> songRenderer(new SongRenderer(WaveSabreCore::gSong, numRenderThreads, false));
+		const int sampleRate = songRenderer->mRenderContext.mSampleRateI;
+		const int numFrames = sampleRate * WaveSabreCore::kSongLengthSeconds;
+		const int master = kTrackCount - 1;
+
+		// senders always come before their receivers in the track list, so one forward pass chains keys.
+		uint64_t keys[kTrackCount];
+		for (int i = 0; i < kTrackCount; i++)
+		{
+			auto& track = songRenderer->tracks[i];
+			uint64_t h = SongRenderer::HashBytes(SongRenderer::kHashSeed, &salt, sizeof(salt));
+			h = SongRenderer::HashBytes(h, &sampleRate, sizeof(sampleRate));
+			h = SongRenderer::HashBytes(h, &WaveSabreCore::kSongTempoBPM, sizeof(WaveSabreCore::kSongTempoBPM));
+			h = SongRenderer::HashBytes(h, &numFrames, sizeof(numFrames));
+			h = SongRenderer::HashBytes(h, &kBlockFrames, sizeof(kBlockFrames));
+			h = track.HashInputs(h);
+			for (int r = 0; r < track.NumReceives; r++)
+			{
+				h = SongRenderer::HashBytes(h, &keys[track.Receives[r].SendingTrackIndex], sizeof(uint64_t));
+			}
+			keys[i] = h;
+		}
+
+		auto cachePath = [&](int i, const char* extension) {
+			char name[32];
+			sprintf(name, "/%016llx.%s", (unsigned long long)keys[i], extension);
+			return cacheDirectory + name;
+		};
+
+		// a complete entry is both channels of every frame; anything else is from an interrupted or foreign write.
+		const long cacheFileBytes = 2 * (long)numFrames * (long)sizeof(float);
+		auto openCached = [&](int i) -> FILE* {
+			FILE* f = fopen(cachePath(i, "trk").c_str(), "rb");
+			if (!f)
+				return nullptr;
+			if (fseek(f, 0, SEEK_END) == 0 && ftell(f) == cacheFileBytes && fseek(f, 0, SEEK_SET) == 0)
+				return f;
+			fclose(f);
+			remove(cachePath(i, "trk").c_str());
+			stats.CacheReadErrors++;
+			return nullptr;
+		};
+
+		// walk back from the master: a track is needed if the master or a track being rendered receives from it.
+		std::unique_ptr<NodeList> nodeList(new NodeList);
+		nodeList->songRenderer = songRenderer.get();
+		bool needed[kTrackCount] = {};
+		needed[master] = true;
+		for (int i = master; i >= 0; i--)
+		{
+			auto& node = nodeList->nodes[i];
+			node.track = &songRenderer->tracks[i];
+			if (!needed[i])
+			{
+				stats.TracksSkipped++;
+				continue;
+			}
+			node.file = openCached(i);
+			if (node.file)
+			{
+				node.mode = Mode::Read;
+				stats.TracksFromCache++;
+			}
+			else
+			{
+				node.mode = Mode::Render;
+				node.file = fopen(cachePath(i, "tmp").c_str(), "wb");
+				stats.TracksRendered++;
+				for (int r = 0; r < node.track->NumReceives; r++)
+				{
+					needed[node.track->Receives[r].SendingTrackIndex] = true;
+				}
+			}
+			if (node.file)
+			{
+				setvbuf(node.file, nullptr, _IOFBF, kSegmentBytes);
+			}
+		}
+
+		// deleted before the node list it runs; its destructor joins the worker threads.
+		std::unique_ptr<GraphProcessor> graph(new GraphProcessor(nodeList.get()));
+
+		FILE* file = fopen(fileName, "wb");
+		if (!file || !WavWriter::WriteHeader(file, sampleRate, SongRenderer::NumChannels, numFrames))
+		{
+			stats.Failed = true;
+		}
+		SongRenderer::Sample buffer[kBlockFrames * SongRenderer::NumChannels];
+		int stepCounter = 0;
+		for (int frame = 0; frame < numFrames; frame += kBlockFrames)
+		{
+			const int frames = numFrames - frame < kBlockFrames ? numFrames - frame : kBlockFrames;
+			graph->ProcessGraph(frames * SongRenderer::NumChannels);
+			songRenderer->CopyTrackOutput(master, buffer, frames * SongRenderer::NumChannels);
+			if (file && !stats.Failed)
+			{
+				const size_t count = frames * SongRenderer::NumChannels;
+				stats.Failed = fwrite(buffer, sizeof(SongRenderer::Sample), count, file) != count;
+			}
+
+			stepCounter--;
+			if (stepCounter <= 0)
+			{
+				if (callback)
+				{
+					callback((double)frame / (double)numFrames, data);
+				}
+				stepCounter = 200;
+			}
+		}
+		if (file && fclose(file) != 0)
+		{
+			stats.Failed = true;
+		}
+
+		// rendered outputs only become cache entries once complete, so an aborted export can't leave a bad one.
+		for (int i = 0; i < kTrackCount; i++)
+		{
+			auto& node = nodeList->nodes[i];
+			if (!node.file)
+				continue;
+			const bool closed = fclose(node.file) == 0;
+			if (node.mode == Mode::Render)
+			{
+				if (closed && !node.writeFailed)
+				{
+					rename(cachePath(i, "tmp").c_str(), cachePath(i, "trk").c_str());
+				}
+				else
+				{
+					remove(cachePath(i, "tmp").c_str());
+					stats.CacheWriteErrors++;
+				}
+			}
+			else if (node.readFailed)
+			{
+				remove(cachePath(i, "trk").c_str());
+				stats.CacheReadErrors++;
+			}
+		}
+
+		stats.WallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+		if (callback)
+			callback(1.0, data);
+		return stats;
+	}
+}
+
+#endif // #ifndef MIN_SIZE_REL
@@ -0,0 +1,126 @@
+#include <WaveSabrePlayerLib/MemoryReport.h>
+
+#ifndef MIN_SIZE_REL
+
+namespace WaveSabrePlayerLib
+{
+	namespace
+	{
+		using WaveSabreCore::MemorySubsystem;
+
+		constexpr int kSubsystemCount = (int)MemorySubsystem::Count;
+		constexpr int kDeviceTypeCount = (int)WaveSabreCore::DeviceId::Maj7Modulate + 1;
+
+		const char* const kSubsystemNames[kSubsystemCount] = {
+			"other", "voices", "oscillators", "filters", "buffers", "tracks", "events", "automation",
+		};
+
+		// same order as DeviceId.
+		const char* const kDeviceTypeNames[kDeviceTypeCount] = {
+			"Maj7Analyze", "Maj7Comp", "Maj7CReverb", "Maj7Crush", "Maj7Delay", "Maj7EQ", "Maj7GigaSynth",
+			"Maj7MBC", "Maj7Saturation", "Maj7Space", "Maj7StereoImager", "Maj7Modulate",
+		};
+
+		double Megabytes(size_t bytes)
+		{
+			return (double)bytes / (1024.0 * 1024.0);
+		}
+
+		size_t OwnerBytes(const WaveSabreCore::Arena& arena, int owner)
+		{
+			size_t bytes = 0;
+			for (int s = 0; s < kSubsystemCount; s++)
+			{
+				bytes += arena.GetAccountedBytes(owner, (MemorySubsystem)s);
+			}
+			return bytes;
+		}
+	}
+
+	MemoryReport::MemoryReport(int numRenderThreads)
+	{
+		songRenderer = new SongRenderer(numRenderThreads);
+	}
+
+	MemoryReport::~MemoryReport()
+	{
+		delete songRenderer;
+	}
+
+	void MemoryReport::Render(double seconds)
+	{
+		const int numSamples = (int)(seconds * songRenderer->mRenderContext.mSampleRateI) * SongRenderer::NumChannels;
+		constexpr int kBlockSamples = 256;
+		SongRenderer::Sample buffer[kBlockSamples];
+		for (int i = 0; i < numSamples; i += kBlockSamples)
+		{
+			songRenderer->RenderSamples(buffer, kBlockSamples);
+		}
+	}
+
+	void MemoryReport::Write(FILE *out)
+	{
+		const auto& arena = *songRenderer->mpArena;
+		fprintf(out, "song arena: %.2f MB used of %.0f MB reserved, %.2f MB overflowed to the heap\n",
+			Megabytes(arena.GetUsedBytes()), Megabytes(arena.GetReservedBytes()), Megabytes(arena.GetOverflowBytes()));
+		if (!arena.IsAccounting())
+		{
+			fprintf(out, "no accounting (the arena couldn't be reserved).\n");
+			return;
+		}
+		// everything is attributed to a device, a track, or nobody (owner -1).
+		constexpr int kUnowned = -1;
+
+		fprintf(out, "\nby subsystem:\n");
+		for (int s = 0; s < kSubsystemCount; s++)
+		{
+			size_t bytes = arena.GetAccountedBytes(kUnowned, (MemorySubsystem)s);
+			for (int owner = 0; owner < SongRenderer::kArenaOwnerCount; owner++)
+			{
+				bytes += arena.GetAccountedBytes(owner, (MemorySubsystem)s);
+			}
+			fprintf(out, "  %-12s %10.2f MB\n", kSubsystemNames[s], Megabytes(bytes));
+		}
+
+		fprintf(out, "\nby device type:\n");
+		for (int type = 0; type < kDeviceTypeCount; type++)
+		{
+			int count = 0;
+			size_t bytes = 0;
+			for (int d = 0; d < WaveSabreCore::kSongDeviceCount; d++)
+			{
+				if ((int)songRenderer->deviceIds[d] != type)
+					continue;
+				count++;
+				bytes += OwnerBytes(arena, d);
+			}
+			if (count)
+			{
+				fprintf(out, "  %-16s x%-3d %10.2f MB\n", kDeviceTypeNames[type], count, Megabytes(bytes));
+			}
+		}
+
+		fprintf(out, "\nby track (the last is the master):\n");
+		for (int t = 0; t < WaveSabreCore::kSongTrackCount; t++)
+		{
+			const auto& track = songRenderer->tracks[t];
+			const size_t ownBytes = OwnerBytes(arena, SongRenderer::GetTrackArenaOwner(t));
+			size_t bytes = ownBytes;
+			for (int i = 0; i < track.GetDeviceCount(); i++)
+			{
+				bytes += OwnerBytes(arena, track.GetDeviceIndex(i));
+			}
+			fprintf(out, "  track %-3d %10.2f MB  (track %.2f MB", t, Megabytes(bytes), Megabytes(ownBytes));
+			for (int i = 0; i < track.GetDeviceCount(); i++)
+			{
+				const int d = track.GetDeviceIndex(i);
+				fprintf(out, "; #%d %s %.2f MB", d, kDeviceTypeNames[(int)songRenderer->deviceIds[d]], Megabytes(OwnerBytes(arena, d)));
+			}
+			fprintf(out, ")\n");
+		}
+
+		fprintf(out, "\nrenderer (midi lanes, track table, graph): %.2f MB\n", Megabytes(OwnerBytes(arena, kUnowned)));
+	}
+}
+
+#endif // #ifndef MIN_SIZE_REL
@@ -12,9 +12,9 @@ namespace WaveSabrePlayerLib
 
 		constexpr int stepSize = 100 * SongRenderer::NumChannels;
 #ifdef MIN_SIZE_REL
-		constexpr int z = WaveSabreCore::Helpers::CurrentSampleRateI * SongRenderer::NumChannels;
+		constexpr int z = WaveSabreCore::Helpers::CurrentSampleRateI() * SongRenderer::NumChannels;
 #else 
-		const int z = WaveSabreCore::Helpers::CurrentSampleRateI * SongRenderer::NumChannels;
+		const int z = WaveSabreCore::Helpers::CurrentSampleRateI() * SongRenderer::NumChannels;
 #endif  // MIN_SIZE_REL
 		renderBufferSize = (int)(z * WaveSabreCore::kSongLengthSeconds) / stepSize * stepSize;
 		renderBuffer = new SongRenderer::Sample[renderBufferSize];
@@ -60,7 +60,7 @@ namespace WaveSabrePlayerLib
 
 		playbackBufferIndex = 0;
 
-		renderThread = new DirectSoundRenderThread(renderCallback, this, WaveSabreCore::Helpers::CurrentSampleRateI, playbackBufferSizeMs);
+		renderThread = new DirectSoundRenderThread(renderCallback, this, WaveSabreCore::Helpers::CurrentSampleRateI(), playbackBufferSizeMs);
 	}
 
 	//int PreRenderPlayer::GetTempo() const
@@ -0,0 +1,127 @@
+#include <WaveSabrePlayerLib/RangeRenderer.h>
+
+#ifndef MIN_SIZE_REL
+
+namespace WaveSabrePlayerLib
+{
+	namespace
+	{
+		// the automation step, as in BatchRenderer. automation is applied per step, so snapshots (which are
+		// whole blocks apart) land on step boundaries, and restoring one gives the same output as a render
+		// from the start.
+		constexpr int kBlockFrames = SongRenderer::AutomationStepFrames;
+	}
+
+	RangeRenderer::RangeRenderer(int numRenderThreads, double snapshotIntervalSeconds)
+	{
+		{
+			WaveSabreCore::Arena::Scope arenaScope{ &arena };
+			songRenderer = new SongRenderer(numRenderThreads);
+		}
+
+		const int sampleRate = songRenderer->mRenderContext.mSampleRateI;
+		lengthFrames = sampleRate * WaveSabreCore::kSongLengthSeconds;
+		intervalFrames = (int)(snapshotIntervalSeconds * sampleRate) / kBlockFrames * kBlockFrames;
+		if (intervalFrames < kBlockFrames)
+			intervalFrames = kBlockFrames;
+		snapshots.resize(lengthFrames / intervalFrames + 1);
+
+		arena.Save(snapshots[0]);
+		lastSnapshotPosition = 0;
+	}
+
+	// the song renderer joins its graph threads and frees its graph before the arena goes away.
+	RangeRenderer::~RangeRenderer()
+	{
+		delete songRenderer;
+	}
+
+	RangeRenderer::EditScope::EditScope(RangeRenderer &renderer) :
+		renderer(renderer),
+		arenaScope(&renderer.arena),
+		renderContextScope(renderer.songRenderer->mRenderContext)
+	{
+	}
+
+	RangeRenderer::EditScope::~EditScope()
+	{
+		renderer.endEdit();
+	}
+
+	void RangeRenderer::endEdit()
+	{
+		const int firstStale = (position + intervalFrames - 1) / intervalFrames;
+		for (int slot = firstStale; slot < (int)snapshots.size(); slot++)
+		{
+			WaveSabreCore::Arena::Snapshot().swap(snapshots[slot]);
+		}
+		// at a boundary the snapshot there is from before the edit; [0] must always exist for Seek().
+		lastSnapshotPosition = -1;
+		if (position % intervalFrames == 0 && position / intervalFrames < (int)snapshots.size())
+		{
+			arena.Save(snapshots[position / intervalFrames]);
+			lastSnapshotPosition = position;
+		}
+	}
+
+	void RangeRenderer::Seek(int frame)
+	{
+		if (frame < 0)
+			frame = 0;
+		int slot = frame / intervalFrames;
+		if (slot >= (int)snapshots.size())
+			slot = (int)snapshots.size() - 1;
+		while (snapshots[slot].empty())
+			slot--; // [0] is taken on construction
+
+		arena.Restore(snapshots[slot]);
+		position = slot * intervalFrames;
+		lastSnapshotPosition = position;
+		renderBlocks(nullptr, frame - position);
+	}
+
+	void RangeRenderer::Render(Sample *buffer, int numFrames)
+	{
+		renderBlocks(buffer, numFrames);
+	}
+
+	void RangeRenderer::renderBlocks(Sample *buffer, int numFrames)
+	{
+		WaveSabreCore::Arena::Scope arenaScope{ &arena };
+		Sample discard[kBlockFrames * SongRenderer::NumChannels];
+		while (numFrames > 0)
+		{
+			if (position % intervalFrames == 0 && position != lastSnapshotPosition)
+			{
+				const int slot = position / intervalFrames;
+				if (slot < (int)snapshots.size())
+				{
+					arena.Save(snapshots[slot]);
+					lastSnapshotPosition = position;
+				}
+			}
+
+			// stay on the block grid even when a range starts mid-block.
+			int frames = kBlockFrames - position % kBlockFrames;
+			if (frames > numFrames)
+				frames = numFrames;
+			songRenderer->RenderSamples(buffer ? buffer : discard, frames * SongRenderer::NumChannels);
+			if (buffer)
+				buffer += frames * SongRenderer::NumChannels;
+			position += frames;
+			numFrames -= frames;
+		}
+	}
+
+	size_t RangeRenderer::GetSnapshotBytes() const
+	{
+		size_t bytes = 0;
+		for (auto& s : snapshots)
+		{
+			bytes += s.size();
+		}
+		return bytes;
+	}
+}
+
+#endif // #ifndef MIN_SIZE_REL
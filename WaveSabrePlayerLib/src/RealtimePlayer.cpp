@@ -2,11 +2,15 @@
 
 namespace WaveSabrePlayerLib
 {
-	RealtimePlayer::RealtimePlayer(int numRenderThreads, int bufferSizeMs)
+	RealtimePlayer::RealtimePlayer(int numRenderThreads, int bufferSizeMs, int chunkBudgetMs)
 		: numRenderThreads(numRenderThreads)
 		, bufferSizeMs(bufferSizeMs)
+		, chunkBudgetMs(chunkBudgetMs)
 		, songRenderer(new SongRenderer(numRenderThreads))
 		, renderThread(nullptr)
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+		, governor(qualityLadder.GetLevelCount(), QualityLadder::LogTransition, &qualityLadder)
+#endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 	{
 	}
 
@@ -16,6 +20,9 @@ namespace WaveSabrePlayerLib
 			delete renderThread;
 		if (songRenderer)
 			delete songRenderer;
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+		qualityLadder.Apply(0); // don't leave the global quality degraded
+#endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 	}
 
 	void RealtimePlayer::Play()
@@ -25,9 +32,18 @@ namespace WaveSabrePlayerLib
 		if (songRenderer)
 			delete songRenderer;
 
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+		qualityLadder.Apply(0);
+		governor = QualityGovernor(qualityLadder.GetLevelCount(), QualityLadder::LogTransition, &qualityLadder);
+#endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 		songRenderer = new SongRenderer(numRenderThreads);
-    renderThread =
-        new DirectSoundRenderThread(renderCallback, this, WaveSabreCore::Helpers::CurrentSampleRateI, bufferSizeMs);
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+		RealtimeServicedCallback onServiced = servicedCallback;
+#else
+		RealtimeServicedCallback onServiced = nullptr;
+#endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
+		renderThread =
+			new DirectSoundRenderThread(renderCallback, this, WaveSabreCore::Helpers::CurrentSampleRateI(), bufferSizeMs, chunkBudgetMs, onServiced);
 	}
 
 	//int RealtimePlayer::GetTempo() const
@@ -37,7 +53,7 @@ namespace WaveSabrePlayerLib
 
 	//int RealtimePlayer::GetSampleRate() const
 	//{
-	//	return WaveSabreCore::Helpers::CurrentSampleRateI;  // songRenderer->GetSampleRate();
+	//	return WaveSabreCore::Helpers::CurrentSampleRateI();  // songRenderer->GetSampleRate();
 	//}
 
 	//double RealtimePlayer::GetLength() const
@@ -53,11 +69,38 @@ namespace WaveSabrePlayerLib
 		return std::max((renderThread->GetPlayPositionMs() - (double)bufferSizeMs) / 1000.0, 0.0);
 	}
 
+	RenderChunkPlanner::Stats RealtimePlayer::GetChunkStats() const
+	{
+		if (!renderThread)
+			return RenderChunkPlanner::Stats();
+
+		return renderThread->GetChunkStats();
+	}
+
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+	int RealtimePlayer::GetQualityLevel() const
+	{
+		return governor.GetLevel();
+	}
+#endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
+
 	void RealtimePlayer::renderCallback(SongRenderer::Sample *buffer, int numSamples, void *data)
 	{
+		// the render thread already sized this chunk (and capped it to what the renderer can take).
+		auto player = (RealtimePlayer *)data;
+		player->songRenderer->RenderSamples(buffer, numSamples);
+	}
+
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+	void RealtimePlayer::servicedCallback(double nowMs, double renderMs, double audioMs, double headroomMs, void *data)
+	{
+		// measured per service rather than per render callback: a chunk that wraps the ring buffer is rendered in
+		// two parts, and a few frames' tail timed against its own few-frame duration reads as a huge load. the
+		// deadline is the audio rendered, or the audio that was queued if that runs out first.
 		auto player = (RealtimePlayer *)data;
-		const int stepSize = 100 * SongRenderer::NumChannels;
-		for (int i = 0; i < numSamples; i += stepSize)
-			player->songRenderer->RenderSamples(buffer + i, std::min(numSamples - i, stepSize));
+		double deadlineMs = headroomMs < audioMs ? headroomMs : audioMs;
+		if (player->governor.OnBlock(nowMs, renderMs, deadlineMs))
+			player->qualityLadder.Apply(player->governor.GetLevel());
 	}
+#endif // SELECTABLE_OUTPUT_STREAM_SUPPORT
 }
@@ -0,0 +1,299 @@
+#include <WaveSabrePlayerLib/StemWriter.h>
+#include <WaveSabrePlayerLib/WavWriter.h>
+
+#ifndef MIN_SIZE_REL
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace WaveSabrePlayerLib
+{
+	namespace
+	{
+		constexpr int kStepFrames = 100; // same stepping as WavWriter
+		constexpr int kChunkFrames = kStepFrames * 256;
+
+		struct Chunk
+		{
+			FILE* file;
+			int numSamples;
+			std::vector<SongRenderer::Sample> samples;
+		};
+
+		// the render thread fills chunks and queues them; a writer thread does the fwrites. the pool is
+		// fixed, so if the disk falls behind the render waits for a free chunk instead of growing memory.
+		class AsyncFileWriter
+		{
+		public:
+			AsyncFileWriter(int numChunks, int chunkSamples)
+			{
+				for (int i = 0; i < numChunks; i++)
+				{
+					mChunks.emplace_back(new Chunk{ nullptr, 0, std::vector<SongRenderer::Sample>(chunkSamples) });
+					mFree.push_back(mChunks.back().get());
+				}
+				mThread = std::thread([this]() { writerLoop(); });
+			}
+
+			~AsyncFileWriter()
+			{
+				Finish();
+			}
+
+			// returns once everything queued has been written; false if any write came up short.
+			bool Finish()
+			{
+				if (mThread.joinable())
+				{
+					{
+						std::lock_guard<std::mutex> lock(mMutex);
+						mDone = true;
+					}
+					mChanged.notify_all();
+					mThread.join();
+				}
+				return !mFailed;
+			}
+
+			Chunk* Acquire(FILE* file)
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mChanged.wait(lock, [this]() { return !mFree.empty(); });
+				auto* chunk = mFree.back();
+				mFree.pop_back();
+				chunk->file = file;
+				chunk->numSamples = 0;
+				return chunk;
+			}
+
+			void Submit(Chunk* chunk)
+			{
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+					mQueued.push_back(chunk);
+				}
+				mChanged.notify_all();
+			}
+
+		private:
+			void writerLoop()
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				while (true)
+				{
+					mChanged.wait(lock, [this]() { return !mQueued.empty() || mDone; });
+					if (mQueued.empty())
+						return;
+					auto* chunk = mQueued.front();
+					mQueued.pop_front();
+					lock.unlock();
+					const bool written = fwrite(chunk->samples.data(), sizeof(SongRenderer::Sample), chunk->numSamples, chunk->file) == (size_t)chunk->numSamples;
+					lock.lock();
+					if (!written)
+					{
+						mFailed = true;
+					}
+					mFree.push_back(chunk);
+					mChanged.notify_all();
+				}
+			}
+
+			std::vector<std::unique_ptr<Chunk>> mChunks;
+			std::vector<Chunk*> mFree;
+			std::deque<Chunk*> mQueued;
+			bool mDone = false;
+			bool mFailed = false; // only touched by the writer thread until it's joined
+			std::mutex mMutex;
+			std::condition_variable mChanged;
+			std::thread mThread;
+		};
+
+		struct OutputFile
+		{
+			FILE* file;
+			int numChannels;
+			Chunk* chunk;
+		};
+	}
+
+	StemWriter::StemWriter(int numRenderThreads)
+	{
+		songRenderer = new SongRenderer(numRenderThreads);
+	}
+
+	StemWriter::~StemWriter()
+	{
+		delete songRenderer;
+	}
+
+	bool StemWriter::WriteStems(const int *trackIndices, const char *const *fileNames, int numTracks, ProgressCallback callback, void *data)
+	{
+		if (!validTracks(trackIndices, numTracks))
+			return false;
+		std::vector<FILE*> files(numTracks);
+		for (int i = 0; i < numTracks; i++)
+		{
+			files[i] = fopen(fileNames[i], "wb");
+			if (!files[i])
+			{
+				for (int j = 0; j < i; j++)
+				{
+					fclose(files[j]);
+					remove(fileNames[j]);
+				}
+				return false;
+			}
+		}
+		if (write(trackIndices, numTracks, files.data(), numTracks, callback, data))
+			return true;
+		for (int i = 0; i < numTracks; i++)
+		{
+			remove(fileNames[i]);
+		}
+		return false;
+	}
+
+	bool StemWriter::WriteMultichannel(const int *trackIndices, int numTracks, const char *fileName, ProgressCallback callback, void *data)
+	{
+		if (!validTracks(trackIndices, numTracks))
+			return false;
+		FILE* file = fopen(fileName, "wb");
+		if (!file)
+			return false;
+		if (write(trackIndices, numTracks, &file, 1, callback, data))
+			return true;
+		remove(fileName);
+		return false;
+	}
+
+	bool StemWriter::validTracks(const int *trackIndices, int numTracks)
+	{
+		if (numTracks <= 0)
+			return false;
+		for (int i = 0; i < numTracks; i++)
+		{
+			if (trackIndices[i] >= (int)WaveSabreCore::kSongTrackCount)
+				return false;
+		}
+		return true;
+	}
+
+	// numFiles is either numTracks (a stereo file each) or 1 (all tracks interleaved into one file).
+	// closes the files; false if any of them couldn't be fully written or closed.
+	bool StemWriter::write(const int *trackIndices, int numTracks, FILE **files, int numFiles, ProgressCallback callback, void *data)
+	{
+		const int sampleRate = songRenderer->mRenderContext.mSampleRateI;
+		const int numFrames = sampleRate * WaveSabreCore::kSongLengthSeconds / kStepFrames * kStepFrames;
+
+		bool ok = true;
+		std::vector<OutputFile> outputs(numFiles);
+		for (int i = 0; i < numFiles; i++)
+		{
+			auto& o = outputs[i];
+			o.file = files[i];
+			o.numChannels = (numFiles == 1) ? numTracks * SongRenderer::NumChannels : SongRenderer::NumChannels;
+			o.chunk = nullptr;
+			if (!WavWriter::WriteHeader(o.file, sampleRate, o.numChannels, numFrames))
+			{
+				ok = false;
+			}
+		}
+		if (!ok)
+		{
+			for (auto& o : outputs)
+			{
+				fclose(o.file);
+			}
+			return false;
+		}
+
+		{
+			// two chunks per file: one filling, one being written.
+			AsyncFileWriter writer(numFiles * 2, kChunkFrames * outputs[0].numChannels);
+			auto flush = [&](OutputFile& o) {
+				if (o.chunk)
+				{
+					writer.Submit(o.chunk);
+					o.chunk = nullptr;
+				}
+			};
+
+			SongRenderer::Sample master[kStepFrames * SongRenderer::NumChannels];
+			int stepCounter = 0;
+			for (int frame = 0; frame < numFrames; frame += kStepFrames)
+			{
+				// the master output isn't needed, but this is what runs the graph.
+				songRenderer->RenderSamples(master, kStepFrames * SongRenderer::NumChannels);
+
+				for (auto& o : outputs)
+				{
+					if (!o.chunk)
+					{
+						o.chunk = writer.Acquire(o.file);
+					}
+				}
+
+				for (int t = 0; t < numTracks; t++)
+				{
+					auto& o = outputs[numFiles == 1 ? 0 : t];
+					if (!o.chunk)
+						continue;
+					const int trackIndex = trackIndices[t] < 0 ? WaveSabreCore::kSongTrackCount - 1 : trackIndices[t];
+					float** buffers = songRenderer->tracks[trackIndex].Buffers;
+					const int channelOffset = (numFiles == 1) ? t * SongRenderer::NumChannels : 0;
+					SongRenderer::Sample* dest = o.chunk->samples.data() + o.chunk->numSamples + channelOffset;
+					for (int i = 0; i < kStepFrames; i++)
+					{
+						dest[i * o.numChannels] = WaveSabreCore::M7::math::Sample32To16(buffers[0][i]);
+						dest[i * o.numChannels + 1] = WaveSabreCore::M7::math::Sample32To16(buffers[1][i]);
+					}
+				}
+
+				for (auto& o : outputs)
+				{
+					if (!o.chunk)
+						continue;
+					o.chunk->numSamples += kStepFrames * o.numChannels;
+					if (o.chunk->numSamples == kChunkFrames * o.numChannels)
+					{
+						flush(o);
+					}
+				}
+
+				stepCounter--;
+				if (stepCounter <= 0)
+				{
+					if (callback)
+					{
+						callback((double)frame / (double)numFrames, data);
+					}
+					stepCounter = 200;
+				}
+			}
+
+			for (auto& o : outputs)
+			{
+				flush(o);
+			}
+			ok = writer.Finish();
+		}
+
+		for (auto& o : outputs)
+		{
+			if (fclose(o.file))
+			{
+				ok = false;
+			}
+		}
+
+		if (callback)
+			callback(1.0, data);
+		return ok;
+	}
+}
+
+#endif // #ifndef MIN_SIZE_REL
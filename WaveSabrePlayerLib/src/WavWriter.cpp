@@ -20,11 +20,11 @@ namespace WaveSabrePlayerLib
 		constexpr int bitsPerSample = sizeof(SongRenderer::Sample) * 8;
 
 		constexpr int stepSize = 100 * SongRenderer::NumChannels;
-    //constexpr int z = WaveSabreCore::Helpers::CurrentSampleRateI * SongRenderer::NumChannels;
+    //constexpr int z = WaveSabreCore::Helpers::CurrentSampleRateI() * SongRenderer::NumChannels;
 #ifdef MIN_SIZE_REL
-    constexpr int z = WaveSabreCore::Helpers::CurrentSampleRateI * SongRenderer::NumChannels;
+    constexpr int z = WaveSabreCore::Helpers::CurrentSampleRateI() * SongRenderer::NumChannels;
 #else
-    const int z = WaveSabreCore::Helpers::CurrentSampleRateI * SongRenderer::NumChannels;
+    const int z = WaveSabreCore::Helpers::CurrentSampleRateI() * SongRenderer::NumChannels;
 #endif  // MIN_SIZE_REL
 	
 	int numSamples = (int)(z * WaveSabreCore::kSongLengthSeconds) / stepSize * stepSize;
@@ -43,8 +43,8 @@ namespace WaveSabrePlayerLib
 		writeInt(16, file);
 		writeShort(WAVE_FORMAT_PCM, file);
 		writeShort(SongRenderer::NumChannels, file);
-    writeInt(WaveSabreCore::Helpers::CurrentSampleRateI, file);
-    writeInt(WaveSabreCore::Helpers::CurrentSampleRateI * SongRenderer::NumChannels * bitsPerSample / 8, file);
+    writeInt(WaveSabreCore::Helpers::CurrentSampleRateI(), file);
+    writeInt(WaveSabreCore::Helpers::CurrentSampleRateI() * SongRenderer::NumChannels * bitsPerSample / 8, file);
 		writeShort(SongRenderer::NumChannels * bitsPerSample / 8, file);
 		writeShort(bitsPerSample, file);
 
@@ -78,6 +78,50 @@ namespace WaveSabrePlayerLib
 			callback(1.0, data);
 	}
 
+#ifndef MIN_SIZE_REL
+	bool WavWriter::WriteHeader(FILE *file, int sampleRate, int numChannels, int numFrames)
+	{
+		constexpr int bitsPerSample = sizeof(SongRenderer::Sample) * 8;
+		const int blockAlign = numChannels * bitsPerSample / 8;
+		const bool extensible = numChannels > 2;
+		const int fmtSize = extensible ? 40 : 16;
+		// many-track multichannel files get big; sizes are unsigned 32-bit, so reject what doesn't fit.
+		const unsigned long long dataBytes = (unsigned long long)numFrames * (unsigned long long)blockAlign;
+		const unsigned long long riffBytes = 4 + (8 + fmtSize) + (8 + dataBytes);
+		if (riffBytes > 0xffffffffull)
+			return false;
+		const int dataSubChunkSize = (int)(unsigned int)dataBytes;
+
+		// RIFF header
+		fputs("RIFF", file);
+		writeInt((int)(unsigned int)riffBytes, file);
+		fputs("WAVE", file);
+
+		// format subchunk
+		fputs("fmt ", file);
+		writeInt(fmtSize, file);
+		writeShort(extensible ? (short)0xfffe : WAVE_FORMAT_PCM, file); // WAVE_FORMAT_EXTENSIBLE
+		writeShort(numChannels, file);
+		writeInt(sampleRate, file);
+		writeInt(sampleRate * blockAlign, file);
+		writeShort(blockAlign, file);
+		writeShort(bitsPerSample, file);
+		if (extensible)
+		{
+			static const unsigned char pcmSubFormat[16] = { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 };
+			writeShort(22, file); // cbSize
+			writeShort(bitsPerSample, file); // valid bits
+			writeInt(0, file); // no speaker positions; stems are just channel pairs
+			fwrite(pcmSubFormat, sizeof(pcmSubFormat), 1, file);
+		}
+
+		// data subchunk
+		fputs("data", file);
+		writeInt(dataSubChunkSize, file);
+		return !ferror(file);
+	}
+#endif // #ifndef MIN_SIZE_REL
+
 	void WavWriter::writeInt(int i, FILE *file)
 	{
 		fwrite(&i, sizeof(int), 1, file);
@@ -70,12 +70,13 @@ WaveformGen* gpWaveformGen = nullptr;
 // position between min(precalctime_max, render_progress)
 int32_t gPrecalcProgressPercent = 0;
 
+// play from the start as soon as the scheduler predicts it's safe (or the max precalc time is up).
+bool gAutoPlayPending = true;
+
 void UpdateStatusText()
 {
   if (gpRenderer)
   {
-    auto lock = gpRenderer->gCritsec.Enter();
-
     static constexpr char format[] =
         "%s"
         "F5: Play (while playing, click to seek)\r\n"
@@ -90,26 +91,46 @@ void UpdateStatusText()
         "Render time elapsed: %d:%02d.%d (est remaining: %d:%02d.%d) (est total:  %d:%02d.%d)\r\n"
         "\r\n"
         "Time remaining before you can safely play the whole track: %d:%02d.%d (total precalc time: %d:%02d.%d)\r\n"
+        "Playback: %s (predicted margin %s%d:%02d.%d at %d.%02dx)\r\n"
         // TODO: wav writing status & destination
         ;
 
-    int32_t renderPercent = gpRenderer->gSongRendered.AsPercentOf(gpRenderer->gSongLength);
+    // lock-free snapshots of the render thread's progress.
+    auto songRendered = gpRenderer->gSongRendered.Load();
+    auto renderTime = gpRenderer->gRenderTime.Load();
+    int32_t renderPercent = songRendered.AsPercentOf(gpRenderer->gSongLength);
 
-    auto renderRate = gpRenderer->gSongRendered.AsRateOf_x100(gpRenderer->gRenderTime);
-    auto songYetToRender = gpRenderer->gSongLength - gpRenderer->gSongRendered;
+    auto renderRate = songRendered.AsRateOf_x100(renderTime);
+    auto songYetToRender = gpRenderer->gSongLength - songRendered;
     auto remainingRenderTime = songYetToRender.DividedByRate_x100(renderRate);
-    auto estTotalRenderTime = remainingRenderTime + gpRenderer->gRenderTime;
+    auto estTotalRenderTime = remainingRenderTime + renderTime;
 
     // now let's calculate some buffering stuff. well this is going to be unreliable because the song doesn't render at the same rate throughout.
     // we want to show "how long until the song should be playable without buffering?"
     // basically it's similar to saying "at what point does the render-time-remaining fall below play-time-remaining?
     auto totalPrecalcTime = estTotalRenderTime - gpRenderer->gSongLength;
-    auto remainingPrecalcTime = totalPrecalcTime - gpRenderer->gRenderTime;  // subtract how much you've already waited.
+    auto remainingPrecalcTime = totalPrecalcTime - renderTime;  // subtract how much you've already waited.
     remainingPrecalcTime.Max0();
     totalPrecalcTime.Max0();
 
     gPrecalcProgressPercent =
-        std::max(renderPercent, gpRenderer->gRenderTime.AsPercentOf(WSTime::FromMilliseconds(gMaxPrecalcMilliseconds)));
+        std::max(renderPercent, renderTime.AsPercentOf(WSTime::FromMilliseconds(gMaxPrecalcMilliseconds)));
+
+    // the scheduler's view, for the play cursor (or the start, before playing).
+    auto playPos = gpPlayer->IsPlaying() ? gpPlayer->gPlayTime.Load() : WSTime::FromFrames(0);
+    auto lock = gpRenderer->gCritsec.Enter();  // the scheduler isn't lock-free
+    const auto& scheduler = gpRenderer->mScheduler;
+    auto margin = WSTime::FromFrames(scheduler.IsModelReady() ? scheduler.PredictMarginFrames(playPos.GetFrames()) : 0);
+    const char* marginSign = margin.GetFrames() < 0 ? "-" : "";
+    if (margin.GetFrames() < 0)
+    {
+      margin = WSTime::FromFrames(-margin.GetFrames());
+    }
+    const char* playbackStatus = gpPlayer->IsBuffering() ? "buffering"
+                                 : gpPlayer->IsPlaying() ? "playing"
+                                 : gAutoPlayPending      ? "will start when safe"
+                                                         : "stopped";
+    auto schedulerRate = scheduler.GetRenderRate_x100();
 
     char saveIndicatorText[1000] = {0};
     if (gSavedToFilename[0])
@@ -128,9 +149,9 @@ void UpdateStatusText()
             renderPercent,
             renderRate / 100,
             renderRate % 100,
-            gpRenderer->gRenderTime.GetMinutes(),
-            gpRenderer->gRenderTime.GetSecondsOfMinute(),
-            gpRenderer->gRenderTime.GetTenthsOfSecondsOfSeconds(),
+            renderTime.GetMinutes(),
+            renderTime.GetSecondsOfMinute(),
+            renderTime.GetTenthsOfSecondsOfSeconds(),
             remainingRenderTime.GetMinutes(),
             remainingRenderTime.GetSecondsOfMinute(),
             remainingRenderTime.GetTenthsOfSecondsOfSeconds(),
@@ -142,7 +163,14 @@ void UpdateStatusText()
             remainingPrecalcTime.GetTenthsOfSecondsOfSeconds(),
             totalPrecalcTime.GetMinutes(),
             totalPrecalcTime.GetSecondsOfMinute(),
-            totalPrecalcTime.GetTenthsOfSecondsOfSeconds());
+            totalPrecalcTime.GetTenthsOfSecondsOfSeconds(),
+            playbackStatus,
+            marginSign,
+            margin.GetMinutes(),
+            margin.GetSecondsOfMinute(),
+            margin.GetTenthsOfSecondsOfSeconds(),
+            schedulerRate / 100,
+            schedulerRate % 100);
   }
   else
   {
@@ -193,14 +221,13 @@ void RenderWaveform_Fancy(GdiDeviceContextFancy& dc)
   dc.SolidFill(waveformRect, gTheme.WaveformUnrenderedHatch1);
   static constexpr auto midY = waveformRect.GetMidY();
   static constexpr auto left = waveformRect.GetLeft();
-  auto lock =
-      gpRenderer->gCritsec
-          .Enter();  // don't give waveformgen its own critsec for 1) complexity (lock hierarchies!) and 2) code size.
-  for (int i = 0; i < gpWaveformGen->mProcessedWidth; ++i)
+  // no lock; the waveform is published by the render thread as it goes.
+  const int processedWidth = gpWaveformGen->GetProcessedWidth();
+  for (int i = 0; i < processedWidth; ++i)
   {
-    auto h = gpWaveformGen->mHeights[i];
+    auto c = gpWaveformGen->GetColumn(i);
 
-    dc.SolidFill({left + i, midY - h, 1, h * 2}, gTheme.WaveformForeground);
+    dc.SolidFill({left + i, midY - c.mAbove, 1, c.mAbove + c.mBelow}, gTheme.WaveformForeground);
   }
 }
 void handlePaint_Fancy()
@@ -252,6 +279,12 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
     }
     case WM_TIMER:
     {
+      if (gAutoPlayPending && gpRenderer &&
+          gpRenderer->Schedule(false, WSTime::FromFrames(0)) == PlaybackScheduler::Action::Play)
+      {
+        gAutoPlayPending = false;
+        gpPlayer->PlayFrom(WSTime::FromFrames(0));
+      }
       UpdateStatusText();
       ::InvalidateRect(hwnd, NULL, FALSE);
       return 0;
@@ -268,7 +301,7 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
         return 0;
       }
       int xPos = LOWORD(lParam) - gTheme.grcWaveform.GetLeft();
-      uint32_t ms = MulDiv(xPos, gpRenderer->gSongLength.GetMilliseconds(), gTheme.grcWaveform.GetWidth());
+      auto ms = WSTime::Scale(gpRenderer->gSongLength.GetMilliseconds(), xPos, gTheme.grcWaveform.GetWidth());
       if (gpPlayer->IsPlaying())
       {
         gpPlayer->PlayFrom(WSTime::FromMilliseconds(ms));
@@ -283,9 +316,11 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
           handleSave();
           return 0;
         case VK_F5:
+          gAutoPlayPending = false;
           gpPlayer->PlayFrom(WSTime::FromFrames(0));
           return 0;
         case VK_F6:
+          gAutoPlayPending = false;
           gpPlayer->Reset();
           return 0;
         case VK_F8:
@@ -371,6 +406,7 @@ int main(int argc, char** argv)
   if (argc > 3 && !strcmp(argv[2], "-w"))
   {
     strcpy(gFilename, argv[3]);
+    gAutoPlayPending = false;  // invoked to export
   }
 
   auto blob = ReadBinaryFile(binPath);
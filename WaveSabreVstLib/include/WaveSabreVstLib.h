@@ -235,9 +235,9 @@ inline int SetSimpleJSONVstChunk(TDevice* pDevice,
       return 0;
     }
 
-    // call SetParam so the device has the opportunity to react and recalc if needed.
-    // but do it AFTER params have been set so there's not a bunch of undefined values.
-    pDevice->SetParam(0, paramCache[0]);
+    // let the device react and recalc once, as a bulk load (no parameter glides from whatever was loaded
+    // before). but do it AFTER params have been set so there's not a bunch of undefined values.
+    pDevice->OnBulkParamsChanged();
 
     return byteSize;
   };
@@ -35,7 +35,7 @@ inline void DelayVisualization(float leftPeriodMS, float rightPeriodMS, float fe
   };
   auto msToBeats = [&](float ms)
   {
-    float msPerBeat = 60000.0f / Helpers::CurrentTempo;
+    float msPerBeat = 60000.0f / Helpers::CurrentTempo();
     return ms / msPerBeat;
   };
 
@@ -262,7 +262,7 @@ template <size_t TSeriesCount, int Twidth, int Theight> struct HistoryView {
       elapsedSeconds = 0.0;
     }
     const double elapsedMilliseconds = elapsedSeconds * 1000.0;
-    const double elapsedSamples = elapsedSeconds * Helpers::CurrentSampleRateF;
+    const double elapsedSamples = elapsedSeconds * Helpers::CurrentSampleRateF();
 
     char headerBuffer[128];
     std::snprintf(headerBuffer,
@@ -71,81 +71,14 @@ static inline std::vector<std::pair<std::string, int>> LoadGmDlsOptions() {
   std::vector<std::pair<std::string, int>> mOptions;
   mOptions.push_back({"(no sample)", -1});
 
-  // Read gm.dls file
-  GmDls::EnsureInitialized();
-
-  // Seek to wave pool chunk's data
-  auto ptr = GmDls::gpData + GmDls::kWaveListOffset;
-
-  // Walk wave pool entries
   for (int i = 0; i < M7::gGmDlsSampleCount; i++) {
-    // Walk wave list
-    auto waveListTag = *((unsigned int *)ptr); // Should be 'LIST'
-    ptr += 4;
-    auto waveListSize = *((unsigned int *)ptr);
-    ptr += 4;
-
-    // Walk wave entry
-    auto wave = ptr;
-    auto waveTag = *((unsigned int *)wave); // Should be 'wave'
-    wave += 4;
-
-    // Skip fmt chunk
-    auto fmtChunkTag = *((unsigned int *)wave); // Should be 'fmt '
-    wave += 4;
-    auto fmtChunkSize = *((unsigned int *)wave);
-    wave += 4;
-    wave += fmtChunkSize;
-
-    // Skip wsmp chunk
-    auto wsmpChunkTag = *((unsigned int *)wave); // Should be 'wsmp'
-    wave += 4;
-    auto wsmpChunkSize = *((unsigned int *)wave);
-    wave += 4;
-    wave += wsmpChunkSize;
-
-    // Skip data chunk
-    auto dataChunkTag = *((unsigned int *)wave); // Should be 'data'
-    wave += 4;
-    auto dataChunkSize = *((unsigned int *)wave);
-    wave += 4;
-    wave += dataChunkSize;
-
-    // Walk info list
-    auto infoList = wave;
-    auto infoListTag = *((unsigned int *)infoList); // Should be 'LIST'
-    infoList += 4;
-    auto infoListSize = *((unsigned int *)infoList);
-    infoList += 4;
-
-    // Walk info entry
-    auto info = infoList;
-    auto infoTag = *((unsigned int *)info); // Should be 'INFO'
-    info += 4;
-
-    // Skip copyright chunk
-    auto icopChunkTag = *((unsigned int *)info); // Should be 'ICOP'
-    info += 4;
-    auto icopChunkSize = *((unsigned int *)info);
-    info += 4;
-    // This size appears to be the size minus null terminator, yet each entry
-    // has a null terminator anyways, so they all seem to end in 00 00. Not sure why.
-    info += icopChunkSize + 1;
-
-    // Read name (finally :D)
-    auto nameChunkTag = *((unsigned int *)info); // Should be 'INAM'
-    info += 4;
-    auto nameChunkSize = *((unsigned int *)info);
-    info += 4;
-
-    // Insert name into appropriate group
-    auto name = std::string((char *)info);
-    mOptions.push_back({name, i});
-
-    ptr += waveListSize;
+    auto *info = GmDls::GetSampleInfo(i);
+    if (!info) {
+      break;
+    }
+    mOptions.push_back({info->mpName, i});
   }
 
-  //delete[] gmDls;
   return mOptions;
 }
 
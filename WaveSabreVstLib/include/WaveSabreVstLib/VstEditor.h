@@ -171,7 +171,7 @@ public:
     Window_Open((HWND)ptr);
 
 #ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
-    GetEffectX()->getDevice()->mGuiVisible.store(true, std::memory_order_relaxed);
+    GetEffectX()->getDevice()->SetGuiVisible(true);
 #endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
     return true;
   }
@@ -179,7 +179,7 @@ public:
   void close() override
   {
 #ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
-    GetEffectX()->getDevice()->mGuiVisible.store(false, std::memory_order_relaxed);
+    GetEffectX()->getDevice()->SetGuiVisible(false);
 #endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
     Window_Close();
     AEffEditor::close();
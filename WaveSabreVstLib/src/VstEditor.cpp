@@ -551,6 +551,9 @@ void VstEditor::ImguiPresent()
       ImGui::TextColored(ImGui::ColorConvertU32ToFloat4(colTrim), "trim10=%.0f", (float)(cpsStats.trimmedMean10));
       ImGui::TextColored(ImGui::ColorConvertU32ToFloat4(colMAD), "madMean=%.0f", (float)(cpsStats.madClippedMean));
       ImGui::TextColored(ImGui::ColorConvertU32ToFloat4(colMed), "median=%.0f", (float)(cpsStats.p50));
+
+      ImGui::Separator();
+      ImGui::Text("Startup: LUT build %.1f ms", WaveSabreCore::M7::math::GetLUTInitMilliseconds());
     }
     ImGui::End();
   }
@@ -380,7 +380,14 @@ VstPlug::VstPlug(audioMasterCallback audioMaster,
 VstPlug::~VstPlug()
 {
   if (device)
+  {
+#ifdef SELECTABLE_OUTPUT_STREAM_SUPPORT
+    // hosts may destroy the plugin without closing the editor; stop the analysis worker draining the device
+    // before its destructors run.
+    device->SetGuiVisible(false);
+#endif  // SELECTABLE_OUTPUT_STREAM_SUPPORT
     delete device;
+  }
   delete mPerf;
   mPerf = nullptr;
 }